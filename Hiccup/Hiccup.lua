@@ -62,6 +62,12 @@ project "Hiccup-Core"
             "HC_PLATFORM_WINDOWS=1"
         }
 
+        links
+        {
+            "Synchronization.lib",
+            "Winmm.lib"
+        }
+
     filter ""
 
     filter "configurations:Debug"
@@ -91,4 +97,14 @@ project "Hiccup-Core"
             "HC_CONFIGURATION_SHIPPING=1"
         }
 
+    filter "configurations:Checked"
+        optimize "Speed"
+        symbols "On"
+
+        defines
+        {
+            "HC_CONFIGURATION_SHIPPING=1",
+            "HC_CONFIGURATION_CHECKED=1"
+        }
+
     filter ""
\ No newline at end of file
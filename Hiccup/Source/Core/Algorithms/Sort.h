@@ -0,0 +1,676 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Containers/Span.h"
+#include "Core/Containers/Comparator.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Threading/JobSystem.h"
+
+namespace HC
+{
+
+/**
+ * Maps a radix sort key to an unsigned integer with the same ordering, so the key can be
+ *   sorted byte by byte. Specialized for all the integer and floating point types.
+ */
+template<typename Key>
+struct RadixKey;
+
+template<>
+struct RadixKey<uint32_t>
+{
+    using Bits = uint32_t;
+    ALWAYS_INLINE static Bits to_bits(uint32_t key) { return key; }
+};
+
+template<>
+struct RadixKey<uint64_t>
+{
+    using Bits = uint64_t;
+    ALWAYS_INLINE static Bits to_bits(uint64_t key) { return key; }
+};
+
+template<>
+struct RadixKey<int32_t>
+{
+    using Bits = uint32_t;
+    // Flipping the sign bit moves the negative values before the positive ones.
+    ALWAYS_INLINE static Bits to_bits(int32_t key) { return (uint32_t)key ^ 0x80000000u; }
+};
+
+template<>
+struct RadixKey<int64_t>
+{
+    using Bits = uint64_t;
+    ALWAYS_INLINE static Bits to_bits(int64_t key) { return (uint64_t)key ^ 0x8000000000000000ull; }
+};
+
+template<>
+struct RadixKey<float32_t>
+{
+    using Bits = uint32_t;
+    // Negative values have all their bits flipped (their magnitude order is reversed), while
+    //   positive values only get their sign bit set.
+    ALWAYS_INLINE static Bits to_bits(float32_t key)
+    {
+        uint32_t bits;
+        Memory::copy(&bits, &key, sizeof(bits));
+        return bits ^ ((bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u);
+    }
+};
+
+template<>
+struct RadixKey<float64_t>
+{
+    using Bits = uint64_t;
+    ALWAYS_INLINE static Bits to_bits(float64_t key)
+    {
+        uint64_t bits;
+        Memory::copy(&bits, &key, sizeof(bits));
+        return bits ^ ((bits & 0x8000000000000000ull) ? 0xFFFFFFFFFFFFFFFFull : 0x8000000000000000ull);
+    }
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Sorting Algorithms.
+ *----------------------------------------------------------------
+ * - 'sort' is a pattern-defeating introsort: quicksort with adaptive pivot selection, that
+ *     detects already sorted (or reversed) ranges and falls back to heapsort when the
+ *     partitions become unbalanced, so it's always O(n log n). It is not stable.
+ * - 'radix_sort' is a stable LSD radix sort, for integer and floating point keys. It is O(n)
+ *     and skips the passes where all keys share the same byte, so small keys are cheap.
+ * - 'parallel_sort' sorts blocks on the job system and merges them in parallel. Only worth
+ *     it for very large arrays (hundreds of thousands of elements and more).
+ *
+ * The algorithms that use scratch memory (radix and parallel) copy the elements by assignment
+ *   into uninitialized memory, so they require trivially copyable elements (keys, handles and
+ *   key-index pairs). The introsort works with any movable type.
+ */
+struct Sort
+{
+public:
+    // Below this number of elements, the ranges are sorted by insertion sort.
+    static constexpr size_t InsertionSortThreshold = 24;
+
+    // Above this number of elements, the pivot is chosen as the median of three medians.
+    static constexpr size_t NintherThreshold = 128;
+
+    // Below this number of elements, 'parallel_sort' sorts on the calling thread.
+    static constexpr size_t ParallelSortThreshold = 64 * 1024;
+
+public:
+    /** Sorts the elements, using the comparator policy (a class with a static 'is_less' function). */
+    template<typename Comparator = LessComparator, typename T>
+    static void sort(Span<T> elements)
+    {
+        sort(elements, [](const T& a, const T& b) -> bool { return Comparator::is_less(a, b); });
+    }
+
+    /** Sorts the elements, using a predicate of type bool(const T& a, const T& b), that returns true if a goes before b. */
+    template<typename T, typename Predicate>
+    static void sort(Span<T> elements, const Predicate& is_less)
+    {
+        T* begin = elements.elements();
+        T* end = begin + elements.count();
+        introsort_loop(begin, end, is_less, floor_log2(elements.count()), true);
+    }
+
+    /** Sorts integer or floating point keys, in ascending order. */
+    template<typename Key>
+    static void radix_sort(Span<Key> keys)
+    {
+        radix_sort_by_key(keys, [](const Key& key) -> Key { return key; });
+    }
+
+    /**
+     * Sorts the elements by a key, in ascending order. Elements with equal keys keep their order.
+     *
+     * @param elements The elements to sort. Must be trivially copyable.
+     * @param get_key Function of type Key(const T&). The key must be an integer or floating point type.
+     */
+    template<typename T, typename KeyFunction>
+    static void radix_sort_by_key(Span<T> elements, const KeyFunction& get_key)
+    {
+        using Key = Types::RemoveConstType<Types::RemoveReferenceType<decltype(get_key(*elements.elements()))>>;
+        using Bits = typename RadixKey<Key>::Bits;
+        constexpr uint32_t PassesCount = (uint32_t)sizeof(Bits);
+
+        const size_t count = elements.count();
+        if (count <= InsertionSortThreshold)
+        {
+            // Insertion sort is stable, so the result matches the radix sort.
+            insertion_sort(elements.elements(), elements.elements() + count,
+                [&get_key](const T& a, const T& b) -> bool { return RadixKey<Key>::to_bits(get_key(a)) < RadixKey<Key>::to_bits(get_key(b)); });
+            return;
+        }
+
+        // The histograms of all passes are built with a single read of the elements.
+        size_t histograms[PassesCount][256] = {};
+        for (size_t index = 0; index < count; ++index)
+        {
+            const Bits bits = RadixKey<Key>::to_bits(get_key(elements.elements()[index]));
+            for (uint32_t pass = 0; pass < PassesCount; ++pass)
+            {
+                ++histograms[pass][(bits >> (pass * 8)) & 0xFF];
+            }
+        }
+
+        T* scratch = (T*)Memory::allocate_tagged_i(count * sizeof(T));
+        T* source = elements.elements();
+        T* destination = scratch;
+
+        for (uint32_t pass = 0; pass < PassesCount; ++pass)
+        {
+            const Bits first_bits = RadixKey<Key>::to_bits(get_key(source[0]));
+            if (histograms[pass][(first_bits >> (pass * 8)) & 0xFF] == count)
+            {
+                // All the keys have the same byte, so the pass wouldn't change anything.
+                continue;
+            }
+
+            size_t offsets[256];
+            size_t offset = 0;
+            for (uint32_t digit = 0; digit < 256; ++digit)
+            {
+                offsets[digit] = offset;
+                offset += histograms[pass][digit];
+            }
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                const Bits bits = RadixKey<Key>::to_bits(get_key(source[index]));
+                destination[offsets[(bits >> (pass * 8)) & 0xFF]++] = source[index];
+            }
+
+            T* temporary = source;
+            source = destination;
+            destination = temporary;
+        }
+
+        if (source != elements.elements())
+        {
+            Memory::copy(elements.elements(), source, count * sizeof(T));
+        }
+        Memory::free(scratch);
+    }
+
+    /** Parallel version of 'sort', using the comparator policy. */
+    template<typename Comparator = LessComparator, typename T>
+    static void parallel_sort(Span<T> elements)
+    {
+        parallel_sort(elements, [](const T& a, const T& b) -> bool { return Comparator::is_less(a, b); });
+    }
+
+    /**
+     * Parallel version of 'sort'. The elements are split into one block per thread, the blocks are
+     *   sorted by the job system and then merged pairwise. Each merge pass is split into equally sized
+     *   output segments, so all threads stay busy even when the last two blocks are merged.
+     * Falls back to 'sort' for small arrays, or if the job system is not initialized.
+     *
+     * @param elements The elements to sort. Must be trivially copyable.
+     * @param is_less Predicate of type bool(const T& a, const T& b). Must be thread-safe.
+     */
+    template<typename T, typename Predicate>
+    static void parallel_sort(Span<T> elements, const Predicate& is_less)
+    {
+        const size_t count = elements.count();
+        const size_t threads_count = JobSystem::is_initialized() ? (size_t)JobSystem::get_workers_count() + 1 : 1;
+        if (count < ParallelSortThreshold || threads_count == 1)
+        {
+            sort(elements, is_less);
+            return;
+        }
+
+        // A power of two number of blocks, so each merge pass halves them.
+        size_t blocks_count = 1;
+        while (blocks_count < threads_count)
+        {
+            blocks_count <<= 1;
+        }
+        const size_t block_size = (count + blocks_count - 1) / blocks_count;
+
+        T* data = elements.elements();
+        JobSystem::parallel_for(blocks_count, 1, [&](size_t begin_block, size_t end_block)
+            {
+                for (size_t block = begin_block; block < end_block; ++block)
+                {
+                    const size_t begin = Math::min(block * block_size, count);
+                    const size_t end = Math::min(begin + block_size, count);
+                    sort(Span<T>(data + begin, end - begin), is_less);
+                }
+            });
+
+        T* scratch = (T*)Memory::allocate_tagged_i(count * sizeof(T));
+        T* source = data;
+        T* destination = scratch;
+
+        const size_t segment_size = (count + threads_count * 4 - 1) / (threads_count * 4);
+        const size_t segments_count = (count + segment_size - 1) / segment_size;
+
+        for (size_t run_size = block_size; run_size < count; run_size *= 2)
+        {
+            JobSystem::parallel_for(segments_count, 1, [&](size_t begin_segment, size_t end_segment)
+                {
+                    for (size_t segment = begin_segment; segment < end_segment; ++segment)
+                    {
+                        const size_t output_end = Math::min((segment + 1) * segment_size, count);
+
+                        // A segment can span the boundary between two merged pairs of runs.
+                        for (size_t output_begin = segment * segment_size; output_begin < output_end;)
+                        {
+                            const size_t pair_begin = (output_begin / (2 * run_size)) * (2 * run_size);
+                            const size_t middle = Math::min(pair_begin + run_size, count);
+                            const size_t pair_end = Math::min(pair_begin + 2 * run_size, count);
+                            const size_t range_end = Math::min(output_end, pair_end);
+
+                            merge_range(
+                                source + pair_begin, middle - pair_begin,
+                                source + middle, pair_end - middle,
+                                destination + pair_begin, output_begin - pair_begin, range_end - pair_begin,
+                                is_less
+                            );
+                            output_begin = range_end;
+                        }
+                    }
+                });
+
+            T* temporary = source;
+            source = destination;
+            destination = temporary;
+        }
+
+        if (source != data)
+        {
+            JobSystem::parallel_for(count, segment_size, [&](size_t begin, size_t end)
+                {
+                    Memory::copy(data + begin, source + begin, (end - begin) * sizeof(T));
+                });
+        }
+        Memory::free(scratch);
+    }
+
+private:
+    static size_t floor_log2(size_t value)
+    {
+        size_t log = 0;
+        while (value >>= 1)
+        {
+            ++log;
+        }
+        return log;
+    }
+
+    template<typename T>
+    ALWAYS_INLINE static void swap(T& a, T& b)
+    {
+        T temporary = Types::move(a);
+        a = Types::move(b);
+        b = Types::move(temporary);
+    }
+
+    template<typename T, typename Predicate>
+    ALWAYS_INLINE static void sort2(T* a, T* b, const Predicate& is_less)
+    {
+        if (is_less(*b, *a))
+        {
+            swap(*a, *b);
+        }
+    }
+
+    template<typename T, typename Predicate>
+    ALWAYS_INLINE static void sort3(T* a, T* b, T* c, const Predicate& is_less)
+    {
+        sort2(a, b, is_less);
+        sort2(b, c, is_less);
+        sort2(a, b, is_less);
+    }
+
+    template<typename T, typename Predicate>
+    static void insertion_sort(T* begin, T* end, const Predicate& is_less)
+    {
+        if (begin == end)
+        {
+            return;
+        }
+
+        for (T* current = begin + 1; current != end; ++current)
+        {
+            T* sift = current;
+            T* sift_previous = current - 1;
+
+            if (is_less(*sift, *sift_previous))
+            {
+                T temporary = Types::move(*sift);
+                do
+                {
+                    *sift-- = Types::move(*sift_previous);
+                } while (sift != begin && is_less(temporary, *--sift_previous));
+                *sift = Types::move(temporary);
+            }
+        }
+    }
+
+    // Same as 'insertion_sort', but assumes that the element before 'begin' is not greater than
+    //   any element of the range, so it acts as a sentinel.
+    template<typename T, typename Predicate>
+    static void unguarded_insertion_sort(T* begin, T* end, const Predicate& is_less)
+    {
+        if (begin == end)
+        {
+            return;
+        }
+
+        for (T* current = begin + 1; current != end; ++current)
+        {
+            T* sift = current;
+            T* sift_previous = current - 1;
+
+            if (is_less(*sift, *sift_previous))
+            {
+                T temporary = Types::move(*sift);
+                do
+                {
+                    *sift-- = Types::move(*sift_previous);
+                } while (is_less(temporary, *--sift_previous));
+                *sift = Types::move(temporary);
+            }
+        }
+    }
+
+    // Insertion sort that gives up after moving a few elements. Used on ranges that are likely
+    //   already sorted.
+    // Returns true if the range was sorted.
+    template<typename T, typename Predicate>
+    static bool partial_insertion_sort(T* begin, T* end, const Predicate& is_less)
+    {
+        constexpr size_t MaxMovesCount = 8;
+
+        if (begin == end)
+        {
+            return true;
+        }
+
+        size_t moves_count = 0;
+        for (T* current = begin + 1; current != end; ++current)
+        {
+            T* sift = current;
+            T* sift_previous = current - 1;
+
+            if (is_less(*sift, *sift_previous))
+            {
+                T temporary = Types::move(*sift);
+                do
+                {
+                    *sift-- = Types::move(*sift_previous);
+                } while (sift != begin && is_less(temporary, *--sift_previous));
+                *sift = Types::move(temporary);
+
+                moves_count += (size_t)(current - sift);
+                if (moves_count > MaxMovesCount)
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template<typename T, typename Predicate>
+    static void sift_down(T* begin, size_t root, size_t count, const Predicate& is_less)
+    {
+        while (2 * root + 1 < count)
+        {
+            size_t child = 2 * root + 1;
+            if (child + 1 < count && is_less(begin[child], begin[child + 1]))
+            {
+                ++child;
+            }
+
+            if (!is_less(begin[root], begin[child]))
+            {
+                return;
+            }
+
+            swap(begin[root], begin[child]);
+            root = child;
+        }
+    }
+
+    template<typename T, typename Predicate>
+    static void heap_sort(T* begin, T* end, const Predicate& is_less)
+    {
+        const size_t count = (size_t)(end - begin);
+        for (size_t index = count / 2; index > 0; --index)
+        {
+            sift_down(begin, index - 1, count, is_less);
+        }
+
+        for (size_t heap_size = count; heap_size > 1; --heap_size)
+        {
+            swap(begin[0], begin[heap_size - 1]);
+            sift_down(begin, 0, heap_size - 1, is_less);
+        }
+    }
+
+    // Partitions the range around the pivot (the first element). The elements equal to the pivot
+    //   go to the right partition.
+    // Returns the final position of the pivot. 'out_was_partitioned' is set if no element had to be moved.
+    template<typename T, typename Predicate>
+    static T* partition_right(T* begin, T* end, const Predicate& is_less, bool& out_was_partitioned)
+    {
+        T pivot = Types::move(*begin);
+        T* first = begin;
+        T* last = end;
+
+        // The median-of-three pivot selection guarantees that these loops stop within the range.
+        while (is_less(*++first, pivot));
+
+        if (first - 1 == begin)
+        {
+            while (first < last && !is_less(*--last, pivot));
+        }
+        else
+        {
+            while (!is_less(*--last, pivot));
+        }
+
+        out_was_partitioned = (first >= last);
+
+        while (first < last)
+        {
+            swap(*first, *last);
+            while (is_less(*++first, pivot));
+            while (!is_less(*--last, pivot));
+        }
+
+        T* pivot_position = first - 1;
+        *begin = Types::move(*pivot_position);
+        *pivot_position = Types::move(pivot);
+        return pivot_position;
+    }
+
+    // Partitions the range around the pivot (the first element). The elements equal to the pivot
+    //   go to the left partition. Used when there are many elements equal to the pivot, as they
+    //   are all placed in their final position at once.
+    template<typename T, typename Predicate>
+    static T* partition_left(T* begin, T* end, const Predicate& is_less)
+    {
+        T pivot = Types::move(*begin);
+        T* first = begin;
+        T* last = end;
+
+        while (is_less(pivot, *--last));
+
+        if (last + 1 == end)
+        {
+            while (first < last && !is_less(pivot, *++first));
+        }
+        else
+        {
+            while (!is_less(pivot, *++first));
+        }
+
+        while (first < last)
+        {
+            swap(*first, *last);
+            while (is_less(pivot, *--last));
+            while (!is_less(pivot, *++first));
+        }
+
+        T* pivot_position = last;
+        *begin = Types::move(*pivot_position);
+        *pivot_position = Types::move(pivot);
+        return pivot_position;
+    }
+
+    template<typename T, typename Predicate>
+    static void introsort_loop(T* begin, T* end, const Predicate& is_less, size_t bad_partitions_allowed, bool is_leftmost)
+    {
+        while (true)
+        {
+            const size_t count = (size_t)(end - begin);
+            if (count < InsertionSortThreshold)
+            {
+                if (is_leftmost)
+                {
+                    insertion_sort(begin, end, is_less);
+                }
+                else
+                {
+                    unguarded_insertion_sort(begin, end, is_less);
+                }
+                return;
+            }
+
+            // Moving the pivot to the first position of the range.
+            const size_t half = count / 2;
+            if (count > NintherThreshold)
+            {
+                sort3(begin, begin + half, end - 1, is_less);
+                sort3(begin + 1, begin + (half - 1), end - 2, is_less);
+                sort3(begin + 2, begin + (half + 1), end - 3, is_less);
+                sort3(begin + (half - 1), begin + half, begin + (half + 1), is_less);
+                swap(*begin, *(begin + half));
+            }
+            else
+            {
+                sort3(begin + half, begin, end - 1, is_less);
+            }
+
+            // If the pivot is equal to the element before the range (which is the pivot of a previous
+            //   partition), all the elements equal to it are placed in the left partition and skipped.
+            if (!is_leftmost && !is_less(*(begin - 1), *begin))
+            {
+                begin = partition_left(begin, end, is_less) + 1;
+                continue;
+            }
+
+            bool was_partitioned;
+            T* pivot_position = partition_right(begin, end, is_less, was_partitioned);
+
+            const size_t left_count = (size_t)(pivot_position - begin);
+            const size_t right_count = (size_t)(end - (pivot_position + 1));
+
+            if (left_count < count / 8 || right_count < count / 8)
+            {
+                // Too many unbalanced partitions, so the input is adversarial. Heapsort guarantees O(n log n).
+                if (--bad_partitions_allowed == 0)
+                {
+                    heap_sort(begin, end, is_less);
+                    return;
+                }
+
+                // Breaking the patterns that caused the unbalanced partition, by swapping a few elements.
+                if (left_count >= InsertionSortThreshold)
+                {
+                    swap(begin[0], begin[left_count / 4]);
+                    swap(pivot_position[-1], pivot_position[-(ptrdiff_t)(left_count / 4)]);
+                    if (left_count > NintherThreshold)
+                    {
+                        swap(begin[1], begin[left_count / 4 + 1]);
+                        swap(begin[2], begin[left_count / 4 + 2]);
+                        swap(pivot_position[-2], pivot_position[-(ptrdiff_t)(left_count / 4 + 1)]);
+                        swap(pivot_position[-3], pivot_position[-(ptrdiff_t)(left_count / 4 + 2)]);
+                    }
+                }
+
+                if (right_count >= InsertionSortThreshold)
+                {
+                    swap(pivot_position[1], pivot_position[1 + right_count / 4]);
+                    swap(end[-1], end[-(ptrdiff_t)(right_count / 4)]);
+                    if (right_count > NintherThreshold)
+                    {
+                        swap(pivot_position[2], pivot_position[2 + right_count / 4]);
+                        swap(pivot_position[3], pivot_position[3 + right_count / 4]);
+                        swap(end[-2], end[-(ptrdiff_t)(1 + right_count / 4)]);
+                        swap(end[-3], end[-(ptrdiff_t)(2 + right_count / 4)]);
+                    }
+                }
+            }
+            else if (was_partitioned &&
+                partial_insertion_sort(begin, pivot_position, is_less) &&
+                partial_insertion_sort(pivot_position + 1, end, is_less))
+            {
+                // The range was most likely already sorted.
+                return;
+            }
+
+            // Recursing into the left partition and looping over the right one, so the recursion depth stays logarithmic.
+            introsort_loop(begin, pivot_position, is_less, bad_partitions_allowed, is_leftmost);
+            begin = pivot_position + 1;
+            is_leftmost = false;
+        }
+    }
+
+    // Finds how many of the first 'output_index' merged elements come from the first run.
+    // On equal elements, the ones from the first run go first, so the merge is stable.
+    template<typename T, typename Predicate>
+    static size_t merge_split(const T* a, size_t a_count, const T* b, size_t b_count, size_t output_index, const Predicate& is_less)
+    {
+        size_t low = (output_index > b_count) ? output_index - b_count : 0;
+        size_t high = Math::min(output_index, a_count);
+
+        while (low < high)
+        {
+            const size_t a_index = low + (high - low) / 2;
+            const size_t b_index = output_index - a_index;
+
+            if (b_index > 0 && a_index < a_count && !is_less(b[b_index - 1], a[a_index]))
+            {
+                low = a_index + 1;
+            }
+            else
+            {
+                high = a_index;
+            }
+        }
+
+        return low;
+    }
+
+    // Writes the merged elements in the range [output_begin, output_end) of the merge of two sorted runs.
+    template<typename T, typename Predicate>
+    static void merge_range(const T* a, size_t a_count, const T* b, size_t b_count, T* output, size_t output_begin, size_t output_end, const Predicate& is_less)
+    {
+        size_t a_index = merge_split(a, a_count, b, b_count, output_begin, is_less);
+        size_t b_index = output_begin - a_index;
+
+        for (size_t output_index = output_begin; output_index < output_end; ++output_index)
+        {
+            if (b_index < b_count && (a_index >= a_count || is_less(b[b_index], a[a_index])))
+            {
+                output[output_index] = b[b_index++];
+            }
+            else
+            {
+                output[output_index] = a[a_index++];
+            }
+        }
+    }
+};
+
+} // namespace HC
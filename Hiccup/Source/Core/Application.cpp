@@ -6,6 +6,8 @@
 #include "Engine/MouseEvents.h"
 #include "Engine/WindowEvents.h"
 
+#include "Core/Platform/Platform.h"
+
 namespace HC
 {
 
@@ -21,10 +23,17 @@ Application::Application(const ApplicationDescription& description)
         m_description.window_description.event_callback = [](Event& e) { Application::get()->on_event(e); };
     }
     m_primary_window = Window::create(m_description.window_description);
+
+    if (!AssetManager::initialize(m_description.asset_manager_description))
+    {
+        HC_LOG_ERROR("Application::Application - Failed to initialize the asset manager!");
+    }
 }
 
 Application::~Application()
 {
+    AssetManager::shutdown();
+
     m_primary_window.release();
     s_instance = nullptr;
 }
@@ -33,10 +42,23 @@ void Application::run()
 {
     m_is_running = true;
 
+    HC_ASSERT(m_description.fixed_update_rate > 0); // Invalid fixed update rate!
+    const uint64_t fixed_timestep = 1000000000 / m_description.fixed_update_rate;
+    const float64_t fixed_delta_time = (float64_t)fixed_timestep * 1e-9;
+    const uint64_t max_accumulated_time = fixed_timestep * m_description.max_fixed_updates_per_frame;
+    const uint64_t min_frame_time = (m_description.max_frame_rate > 0) ? 1000000000 / m_description.max_frame_rate : 0;
+
+    uint64_t previous_frame_begin = Platform::get_nanoseconds();
+    uint64_t accumulated_time = 0;
+
     while (m_is_running)
     {
         HC_PROFILE_BEGIN_FRAME;
 
+        const uint64_t frame_begin = Platform::get_nanoseconds();
+        const uint64_t delta_time = frame_begin - previous_frame_begin;
+        previous_frame_begin = frame_begin;
+
         m_primary_window->update_window();
 
         if (m_primary_window->is_pending_kill())
@@ -44,6 +66,45 @@ void Application::run()
             close();
         }
 
+        // Dispatches the queued asset loads. Never blocks the frame.
+        AssetManager::update();
+
+        accumulated_time = Math::min(accumulated_time + delta_time, max_accumulated_time);
+
+        uint32_t fixed_updates_count = 0;
+        while (accumulated_time >= fixed_timestep)
+        {
+            if (m_description.on_fixed_update)
+            {
+                m_description.on_fixed_update(fixed_delta_time);
+            }
+
+            accumulated_time -= fixed_timestep;
+            ++fixed_updates_count;
+        }
+        HC_PROFILE_FRAME_FIXED_UPDATES(fixed_updates_count);
+
+        if (m_description.on_update)
+        {
+            const float64_t alpha = (float64_t)accumulated_time / (float64_t)fixed_timestep;
+            m_description.on_update((float64_t)delta_time * 1e-9, alpha);
+        }
+
+        // Frame pacing. The thread sleeps instead of spinning through the remaining frame time.
+        if (min_frame_time > 0)
+        {
+            const uint64_t idle_begin = Platform::get_nanoseconds();
+            Platform::sleep_until_nanoseconds(frame_begin + min_frame_time);
+            HC_PROFILE_FRAME_IDLE_TIME(Platform::get_nanoseconds() - idle_begin);
+        }
+
+#if HC_ENABLE_MEMORY_TRACKING
+        if (Memory::Tracker::is_active())
+        {
+            Memory::Tracker::capture_frame_snapshot();
+        }
+#endif // HC_ENABLE_MEMORY_TRACKING
+
         HC_PROFILE_END_FRAME;
     }
 
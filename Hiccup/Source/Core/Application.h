@@ -5,6 +5,7 @@
 #include "Core.h"
 #include "Engine/Event.h"
 #include "Engine/Window.h"
+#include "Engine/Asset/AssetManager.h"
 
 namespace HC
 {
@@ -13,7 +14,30 @@ struct ApplicationDescription
 {
     void (*on_event)(Event&);
 
+    // Invoked at a fixed rate, with the fixed timestep, in seconds. Deterministic simulation code goes here.
+    void (*on_fixed_update)(float64_t fixed_delta_time);
+
+    // Invoked once per frame, with the frame delta time, in seconds. The alpha is the fraction of a
+    //   fixed timestep accumulated since the last fixed update, used to interpolate between simulation states.
+    void (*on_update)(float64_t delta_time, float64_t alpha);
+
+    // The number of fixed updates per second.
+    uint32_t fixed_update_rate = 60;
+
+    // Caps the fixed updates executed during a single frame. If the simulation falls further behind,
+    //   the remaining time is dropped, so a slow frame doesn't cause even slower frames.
+    uint32_t max_fixed_updates_per_frame = 8;
+
+    // The frame rate limit. Zero means unlimited.
+    uint32_t max_frame_rate = 240;
+
     WindowDescription window_description;
+
+    AssetManagerDescription asset_manager_description;
+
+    // If set, it is invoked instead of creating the application and running the main loop. Used by
+    //   the tools that run without a window (cooking the content, for example). Returns the process exit code.
+    int32_t (*run_command)() = nullptr;
 };
 
 class Application
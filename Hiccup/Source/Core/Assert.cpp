@@ -8,12 +8,19 @@
 
 #include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
 
 namespace HC
 {
 
-void on_assert_failed(const char* expression, const char* category, const char* filename, const char* function_sig, uint32_t line_number, const char* message, ...)
+void on_assert_failed(const AssertSite& site, const char* message, ...)
 {
+    const char* expression = site.expression;
+    const char* category = site.category;
+    const char* filename = site.filename;
+    const char* function_sig = site.function_sig;
+    const uint32_t line_number = site.line_number;
+
     char title_buffer[32];
     uint32_t title_width = (uint32_t)sprintf_s(title_buffer, " %s FAILED ", category);
 
@@ -126,6 +133,10 @@ void on_assert_failed(const char* expression, const char* category, const char*
         filename, function_sig, line_number);
 
     Platform::open_popup("C++ Hiccup Assertion Failed", buffer, Platform::POPUP_FLAG_BUTTON_OK | Platform::POPUP_FLAG_ICON_ERROR);
+
+    // The debugger stops here, with the failing code one frame up. Execution never resumes after a failed assert.
+    HC_DEBUGBREAK;
+    std::abort();
 }
 
 } // namespace HC
\ No newline at end of file
@@ -16,8 +16,8 @@
     #define HC_ENABLE_DEBUG_ASSERTS     0
     #define HC_ENABLE_DEBUG_VERIFIES    0
 #elif HC_CONFIGURATION_SHIPPING
-    #define HC_ENABLE_ASSERTS           0
-    #define HC_ENABLE_VERIFIES          0
+    #define HC_ENABLE_ASSERTS           HC_CONFIGURATION_CHECKED
+    #define HC_ENABLE_VERIFIES          HC_CONFIGURATION_CHECKED
     #define HC_ENABLE_DEBUG_ASSERTS     0
     #define HC_ENABLE_DEBUG_VERIFIES    0
 #endif // Build configuration switch.
@@ -25,114 +25,66 @@
 namespace HC
 {
 
-HC_API void on_assert_failed(const char* expression, const char* category, const char* filename, const char* function_sig, uint32_t line_number, const char* message, ...);
+/**
+ * Describes an assert. Each assert has its own constant instance, so the failing branch
+ *   only has to pass its address, instead of setting up all the strings inline.
+ */
+struct AssertSite
+{
+    const char* expression;
+    const char* category;
+    const char* filename;
+    const char* function_sig;
+    uint32_t line_number;
+};
+
+/**
+ * Reports the failed assert and terminates the process. Kept out of line and marked as cold,
+ *   so an assert costs a single, predicted branch in the calling code.
+ */
+HC_API HC_NOINLINE HC_COLD HC_NORETURN void on_assert_failed(const AssertSite& site, const char* message, ...);
 
 } // namespace HC
 
-#if HC_ENABLE_ASSERTS
-    #define HC_ASSERT(EXPRESSION)                   \
-        if (!(EXPRESSION))                          \
-        {                                           \
-            ::HC::on_assert_failed(                 \
-                #EXPRESSION, "ASSERT",              \
-                HC_FILE, HC_FUNCTION_SIG, HC_LINE,  \
-                nullptr                             \
-            );                                      \
-            HC_DEBUGBREAK;                          \
-        }
+#define HC_ASSERT_IMPL(EXPRESSION, CATEGORY, ...)                                   \
+    do                                                                              \
+    {                                                                               \
+        if (HC_UNLIKELY(!(EXPRESSION)))                                             \
+        {                                                                           \
+            static constexpr ::HC::AssertSite s_assert_site =                       \
+                { #EXPRESSION, CATEGORY, HC_FILE, HC_FUNCTION_SIG, HC_LINE };       \
+            ::HC::on_assert_failed(s_assert_site, __VA_ARGS__);                     \
+        }                                                                           \
+    } while (0)
 
-    #define HC_ASSERTF(EXPRESSION, ...)             \
-        if (!(EXPRESSION))                          \
-        {                                           \
-            ::HC::on_assert_failed(                 \
-                #EXPRESSION, "ASSERT",              \
-                HC_FILE, HC_FUNCTION_SIG, HC_LINE,  \
-                __VA_ARGS__                         \
-            );                                      \
-            HC_DEBUGBREAK;                          \
-        }
+#if HC_ENABLE_ASSERTS
+    #define HC_ASSERT(EXPRESSION)           HC_ASSERT_IMPL(EXPRESSION, "ASSERT", nullptr)
+    #define HC_ASSERTF(EXPRESSION, ...)     HC_ASSERT_IMPL(EXPRESSION, "ASSERT", __VA_ARGS__)
 #else
     #define HC_ASSERT(EXPRESSION)
     #define HC_ASSERTF(EXPRESSION, ...)
 #endif // HC_ENABLE_ASSERTS
 
 #if HC_ENABLE_DEBUG_ASSERTS
-    #define HC_DASSERT(EXPRESSION)                  \
-        if (!(EXPRESSION))                          \
-        {                                           \
-            ::HC::on_assert_failed(                 \
-                #EXPRESSION, "ASSERT",              \
-                HC_FILE, HC_FUNCTION_SIG, HC_LINE,  \
-                nullptr                             \
-            );                                      \
-            HC_DEBUGBREAK;                          \
-        }
-
-    #define HC_DASSERTF(EXPRESSION, ...)            \
-        if (!(EXPRESSION))                          \
-        {                                           \
-            ::HC::on_assert_failed(                 \
-                #EXPRESSION, "ASSERT",              \
-                HC_FILE, HC_FUNCTION_SIG, HC_LINE,  \
-                __VA_ARGS__                         \
-            );                                      \
-            HC_DEBUGBREAK;                          \
-        }
+    #define HC_DASSERT(EXPRESSION)          HC_ASSERT_IMPL(EXPRESSION, "ASSERT", nullptr)
+    #define HC_DASSERTF(EXPRESSION, ...)    HC_ASSERT_IMPL(EXPRESSION, "ASSERT", __VA_ARGS__)
 #else
     #define HC_DASSERT(EXPRESSION)
     #define HC_DASSERTF(EXPRESSION, ...)
 #endif // HC_ENABLE_DEBUG_ASSERTS
 
 #if HC_ENABLE_VERIFIES
-    #define HC_VERIFY(EXPRESSION)                   \
-        if (!(EXPRESSION))                          \
-        {                                           \
-            ::HC::on_assert_failed(                 \
-                #EXPRESSION, "VERIFY",              \
-                HC_FILE, HC_FUNCTION_SIG, HC_LINE,  \
-                nullptr                             \
-            );                                      \
-            HC_DEBUGBREAK;                          \
-        }
-
-    #define HC_VERIFYF(EXPRESSION, ...)             \
-        if (!(EXPRESSION))                          \
-        {                                           \
-            ::HC::on_assert_failed(                 \
-                #EXPRESSION, "VERIFY",              \
-                HC_FILE, HC_FUNCTION_SIG, HC_LINE,  \
-                __VA_ARGS__                         \
-            );                                      \
-            HC_DEBUGBREAK;                          \
-        }
+    #define HC_VERIFY(EXPRESSION)           HC_ASSERT_IMPL(EXPRESSION, "VERIFY", nullptr)
+    #define HC_VERIFYF(EXPRESSION, ...)     HC_ASSERT_IMPL(EXPRESSION, "VERIFY", __VA_ARGS__)
 #else
     #define HC_VERIFY(EXPRESSION) EXPRESSION
     #define HC_VERIFYF(EXPRESSION, ...) EXPRESSION
 #endif // HC_ENABLE_VERIFIES
 
 #if HC_ENABLE_DEBUG_VERIFIES
-    #define HC_DVERIFY(EXPRESSION)                  \
-        if (!(EXPRESSION))                          \
-        {                                           \
-            ::HC::on_assert_failed(                 \
-                #EXPRESSION, "VERIFY",              \
-                HC_FILE, HC_FUNCTION_SIG, HC_LINE,  \
-                nullptr                             \
-            );                                      \
-            HC_DEBUGBREAK;                          \
-        }
-
-    #define HC_DVERIFYF(EXPRESSION, ...)            \
-        if (!(EXPRESSION))                          \
-        {                                           \
-            ::HC::on_assert_failed(                 \
-                #EXPRESSION, "VERIFY",              \
-                HC_FILE, HC_FUNCTION_SIG, HC_LINE,  \
-                __VA_ARGS__                         \
-            );                                      \
-            HC_DEBUGBREAK;                          \
-        }
+    #define HC_DVERIFY(EXPRESSION)          HC_ASSERT_IMPL(EXPRESSION, "VERIFY", nullptr)
+    #define HC_DVERIFYF(EXPRESSION, ...)    HC_ASSERT_IMPL(EXPRESSION, "VERIFY", __VA_ARGS__)
 #else
     #define HC_DVERIFY(EXPRESSION) EXPRESSION
     #define HC_DVERIFYF(EXPRESSION, ...) EXPRESSION
-#endif // HC_ENABLE_DEBUG_VERIFIES
\ No newline at end of file
+#endif // HC_ENABLE_DEBUG_VERIFIES
@@ -0,0 +1,93 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "CommandLine.h"
+
+#include <cstring>
+
+namespace HC
+{
+
+// The arguments as given by the OS. The first one (the executable path) is skipped.
+static_internal char** s_arguments = nullptr;
+static_internal uint32_t s_arguments_count = 0;
+
+static_internal bool are_views_equal(StringView a, StringView b)
+{
+    if (a.bytes_count() != b.bytes_count())
+    {
+        return false;
+    }
+    return (a.bytes_count() == 0) || (std::memcmp(a.c_str(), b.c_str(), a.bytes_count()) == 0);
+}
+
+void CommandLine::initialize(char** arguments, uint32_t arguments_count)
+{
+    s_arguments = (arguments_count > 1) ? arguments + 1 : nullptr;
+    s_arguments_count = (arguments_count > 1) ? arguments_count - 1 : 0;
+}
+
+uint32_t CommandLine::get_arguments_count()
+{
+    return s_arguments_count;
+}
+
+StringView CommandLine::get_argument(uint32_t index)
+{
+    HC_ASSERT(index < s_arguments_count); // Index out of range!
+    return StringView(s_arguments[index], std::strlen(s_arguments[index]));
+}
+
+bool CommandLine::has_option(StringView name)
+{
+    bool is_present = false;
+    for_each_option([name, &is_present](StringView option_name, StringView) -> bool
+    {
+        is_present = are_views_equal(option_name, name);
+        return !is_present;
+    });
+    return is_present;
+}
+
+bool CommandLine::get_option(StringView name, StringView& out_value)
+{
+    bool is_present = false;
+    for_each_option([name, &out_value, &is_present](StringView option_name, StringView option_value) -> bool
+    {
+        if (are_views_equal(option_name, name) && option_value.bytes_count() > 0)
+        {
+            out_value = option_value;
+            is_present = true;
+        }
+        return !is_present;
+    });
+    return is_present;
+}
+
+bool CommandLine::parse_option(uint32_t index, StringView& out_name, StringView& out_value)
+{
+    const char* argument = s_arguments[index];
+    if (argument[0] != '-')
+    {
+        return false;
+    }
+
+    const char* name = argument + ((argument[1] == '-') ? 2 : 1);
+    const char* separator = std::strchr(name, '=');
+    if (separator)
+    {
+        out_name = StringView(name, (size_t)(separator - name));
+        out_value = StringView(separator + 1, std::strlen(separator + 1));
+    }
+    else
+    {
+        out_name = StringView(name, std::strlen(name));
+
+        // The value is the next argument, unless that is an option as well.
+        const bool has_value = (index + 1 < s_arguments_count) && (s_arguments[index + 1][0] != '-');
+        out_value = has_value ? StringView(s_arguments[index + 1], std::strlen(s_arguments[index + 1])) : StringView();
+    }
+
+    return (out_name.bytes_count() > 0);
+}
+
+} // namespace HC
@@ -0,0 +1,66 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Containers/StringView.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Command Line.
+ *----------------------------------------------------------------
+ * Read-only access to the arguments the process was launched with. The arguments are never
+ *   copied - all the returned views point into the strings provided by the OS - so the command
+ *   line can be queried before the memory system is initialized.
+ *
+ * Options start with '-' or '--', and their value is either given after '=' ('-config=Game.ini')
+ *   or as the next argument, if that doesn't start with '-' ('-config Game.ini').
+ */
+class CommandLine
+{
+public:
+    // Invoked by 'guarded_main', before any subsystem is initialized.
+    static void initialize(char** arguments, uint32_t arguments_count);
+
+public:
+    /** @return The number of arguments, excluding the executable path. */
+    HC_API static uint32_t get_arguments_count();
+
+    HC_API static StringView get_argument(uint32_t index);
+
+    /** @return Whether the option is present, with or without a value. The name excludes the leading dashes. */
+    HC_API static bool has_option(StringView name);
+
+    /** @return False if the option isn't present, or if it has no value. */
+    HC_API static bool get_option(StringView name, StringView& out_value);
+
+    /**
+     * Iterates over all the options, in the order they were given.
+     *
+     * @param func A function of type bool(StringView name, StringView value). The value is empty for
+     *   options without one. If the function returns false, the iterating process will stop.
+     */
+    template<typename Func>
+    static void for_each_option(Func func)
+    {
+        const uint32_t arguments_count = get_arguments_count();
+        for (uint32_t index = 0; index < arguments_count; ++index)
+        {
+            StringView name;
+            StringView value;
+            if (parse_option(index, name, value) && !func(name, value))
+            {
+                return;
+            }
+        }
+    }
+
+private:
+    // Splits the argument at the given index into the option name and value. Returns false if it isn't an option.
+    HC_API static bool parse_option(uint32_t index, StringView& out_name, StringView& out_value);
+};
+
+} // namespace HC
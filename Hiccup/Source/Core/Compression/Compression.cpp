@@ -0,0 +1,703 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "Compression.h"
+
+#include "Core/Threading/Atomic.h"
+#include "Core/Threading/JobSystem.h"
+
+#include <cstring>
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * LZ4 block format.
+ *----------------------------------------------------------------
+ * A block is a sequence of (literals, match) pairs. Each sequence starts with a token, whose
+ *   high nibble is the literals length and low nibble is the match length (minus 'MinMatch').
+ * A nibble value of 15 means the length continues in the following bytes, each adding up to 255.
+ * The last sequence only contains literals, and the last 'LastLiterals' bytes are always literals.
+ */
+static constexpr size_t MinMatch = 4;
+static constexpr size_t LastLiterals = 5;
+static constexpr size_t MatchFindLimit = 12;
+static constexpr size_t MaxOffset = 65535;
+
+static constexpr uint32_t FastHashBits = 12;
+
+static constexpr uint32_t DenseHashBits = 16;
+static constexpr uint32_t DenseWindowMask = 65535;
+static constexpr uint32_t DenseMaxAttempts = 64;
+static constexpr uint32_t InvalidPosition = 0xFFFFFFFF;
+
+// Constant-size copies compile to a single unaligned load, without going through 'Memory::copy'.
+static_internal ALWAYS_INLINE uint32_t read_u32(const uint8_t* source)
+{
+    uint32_t value;
+    std::memcpy(&value, source, sizeof(uint32_t));
+    return value;
+}
+
+static_internal ALWAYS_INLINE uint32_t hash_sequence(uint32_t sequence, uint32_t hash_bits)
+{
+    return (sequence * 2654435761U) >> (32 - hash_bits);
+}
+
+static_internal ALWAYS_INLINE size_t count_matching_bytes(const uint8_t* a, const uint8_t* b, const uint8_t* a_limit)
+{
+    const uint8_t* a_begin = a;
+    while (a < a_limit && *a == *b)
+    {
+        ++a;
+        ++b;
+    }
+    return a - a_begin;
+}
+
+static_internal uint8_t* write_length(uint8_t* output, size_t length)
+{
+    while (length >= 255)
+    {
+        *output++ = 255;
+        length -= 255;
+    }
+    *output++ = (uint8_t)length;
+    return output;
+}
+
+/**
+ * Writes a sequence. If 'match_length' is zero, only the literals are written (the last sequence).
+ *
+ * @return The new output cursor, or nullptr if the sequence doesn't fit.
+ */
+static_internal uint8_t* write_sequence(uint8_t* output, const uint8_t* output_end, const uint8_t* literals, size_t literals_length, size_t offset, size_t match_length)
+{
+    const size_t required_bytes_count = 1 + (literals_length / 255 + 1) + literals_length + 2 + (match_length / 255 + 1);
+    if ((size_t)(output_end - output) < required_bytes_count)
+    {
+        return nullptr;
+    }
+
+    uint8_t* token = output++;
+    if (literals_length >= 15)
+    {
+        *token = 15 << 4;
+        output = write_length(output, literals_length - 15);
+    }
+    else
+    {
+        *token = (uint8_t)(literals_length << 4);
+    }
+
+    std::memcpy(output, literals, literals_length);
+    output += literals_length;
+
+    if (match_length == 0)
+    {
+        return output;
+    }
+
+    *output++ = (uint8_t)(offset & 0xFF);
+    *output++ = (uint8_t)(offset >> 8);
+
+    const size_t encoded_match_length = match_length - MinMatch;
+    if (encoded_match_length >= 15)
+    {
+        *token |= 15;
+        output = write_length(output, encoded_match_length - 15);
+    }
+    else
+    {
+        *token |= (uint8_t)encoded_match_length;
+    }
+
+    return output;
+}
+
+static_internal size_t compress_block_fast(const uint8_t* source, size_t source_size, uint8_t* destination, size_t destination_size)
+{
+    const uint8_t* input = source;
+    const uint8_t* anchor = source;
+    const uint8_t* input_end = source + source_size;
+
+    uint8_t* output = destination;
+    const uint8_t* output_end = destination + destination_size;
+
+    if (source_size > MatchFindLimit)
+    {
+        // Positions relative to the source. Stale or uninitialized entries are harmless, as every
+        //   candidate is verified before being used.
+        uint32_t hash_table[1 << FastHashBits];
+        std::memset(hash_table, 0, sizeof(hash_table));
+
+        const uint8_t* match_find_limit = input_end - MatchFindLimit;
+        const uint8_t* match_limit = input_end - LastLiterals;
+
+        ++input;
+        while (input < match_find_limit)
+        {
+            const uint32_t sequence = read_u32(input);
+            const uint32_t hash = hash_sequence(sequence, FastHashBits);
+            const uint8_t* reference = source + hash_table[hash];
+            hash_table[hash] = (uint32_t)(input - source);
+
+            if (reference >= input || (size_t)(input - reference) > MaxOffset || read_u32(reference) != sequence)
+            {
+                // Skipping faster through data that doesn't compress.
+                input += 1 + ((input - anchor) >> 6);
+                continue;
+            }
+
+            while (input > anchor && reference > source && input[-1] == reference[-1])
+            {
+                --input;
+                --reference;
+            }
+
+            const size_t match_length = MinMatch + count_matching_bytes(input + MinMatch, reference + MinMatch, match_limit);
+
+            output = write_sequence(output, output_end, anchor, input - anchor, input - reference, match_length);
+            if (!output)
+            {
+                return 0;
+            }
+
+            input += match_length;
+            anchor = input;
+
+            if (input < match_find_limit)
+            {
+                hash_table[hash_sequence(read_u32(input - 2), FastHashBits)] = (uint32_t)(input - 2 - source);
+            }
+        }
+    }
+
+    output = write_sequence(output, output_end, anchor, input_end - anchor, 0, 0);
+    return output ? (size_t)(output - destination) : 0;
+}
+
+/**
+ * Hash chain match finder. Every position is linked to the previous position with the same hash,
+ *   so all candidates inside the window can be visited, newest first.
+ */
+struct DenseMatchFinder
+{
+    const uint8_t* source;
+
+    // The most recent position for each hash.
+    uint32_t* head;
+
+    // The distance to the previous position with the same hash, indexed by position (modulo the window).
+    uint16_t* chain;
+
+    // All positions below this one are already inserted.
+    uint32_t next_position;
+};
+
+static_internal void insert_positions(DenseMatchFinder& finder, uint32_t end_position)
+{
+    while (finder.next_position < end_position)
+    {
+        const uint32_t position = finder.next_position++;
+        const uint32_t hash = hash_sequence(read_u32(finder.source + position), DenseHashBits);
+
+        const uint32_t previous = finder.head[hash];
+        const bool has_previous = previous != InvalidPosition && position - previous <= MaxOffset;
+        finder.chain[position & DenseWindowMask] = has_previous ? (uint16_t)(position - previous) : 0;
+        finder.head[hash] = position;
+    }
+}
+
+static_internal size_t find_longest_match(DenseMatchFinder& finder, const uint8_t* input, const uint8_t* match_limit, const uint8_t** out_reference)
+{
+    const uint32_t position = (uint32_t)(input - finder.source);
+    insert_positions(finder, position);
+
+    const uint32_t sequence = read_u32(input);
+    uint32_t candidate = finder.head[hash_sequence(sequence, DenseHashBits)];
+
+    size_t best_length = 0;
+    for (uint32_t attempt = 0; attempt < DenseMaxAttempts; ++attempt)
+    {
+        if (candidate == InvalidPosition || position - candidate > MaxOffset)
+        {
+            break;
+        }
+
+        const uint8_t* reference = finder.source + candidate;
+
+        // Checking the byte that would extend the best match first rejects most candidates cheaply.
+        if (reference[best_length] == input[best_length] && read_u32(reference) == sequence)
+        {
+            const size_t length = MinMatch + count_matching_bytes(input + MinMatch, reference + MinMatch, match_limit);
+            if (length > best_length)
+            {
+                best_length = length;
+                *out_reference = reference;
+            }
+        }
+
+        const uint16_t delta = finder.chain[candidate & DenseWindowMask];
+        if (delta == 0)
+        {
+            break;
+        }
+        candidate -= delta;
+    }
+
+    return best_length;
+}
+
+static_internal size_t compress_block_dense(const uint8_t* source, size_t source_size, uint8_t* destination, size_t destination_size)
+{
+    const uint8_t* input = source;
+    const uint8_t* anchor = source;
+    const uint8_t* input_end = source + source_size;
+
+    uint8_t* output = destination;
+    const uint8_t* output_end = destination + destination_size;
+
+    if (source_size > MatchFindLimit)
+    {
+        DenseMatchFinder finder;
+        finder.source = source;
+        finder.head = (uint32_t*)Memory::allocate_tagged_i((1 << DenseHashBits) * sizeof(uint32_t));
+        finder.chain = (uint16_t*)Memory::allocate_tagged_i((DenseWindowMask + 1) * sizeof(uint16_t));
+        if (!finder.head || !finder.chain)
+        {
+            HC_LOG_ERROR("Compression::compress_block - Failed to allocate the match finder tables!");
+            Memory::free(finder.head);
+            Memory::free(finder.chain);
+            return 0;
+        }
+
+        finder.next_position = 0;
+        Memory::set(finder.head, 0xFF, (1 << DenseHashBits) * sizeof(uint32_t));
+
+        const uint8_t* match_find_limit = input_end - MatchFindLimit;
+        const uint8_t* match_limit = input_end - LastLiterals;
+
+        while (input < match_find_limit)
+        {
+            const uint8_t* reference = nullptr;
+            size_t match_length = find_longest_match(finder, input, match_limit, &reference);
+            if (match_length < MinMatch)
+            {
+                ++input;
+                continue;
+            }
+
+            // Lazy matching: if the match starting at the next byte is longer, it is preferred.
+            if (input + 1 < match_find_limit)
+            {
+                const uint8_t* next_reference = nullptr;
+                const size_t next_match_length = find_longest_match(finder, input + 1, match_limit, &next_reference);
+                if (next_match_length > match_length)
+                {
+                    ++input;
+                    match_length = next_match_length;
+                    reference = next_reference;
+                }
+            }
+
+            output = write_sequence(output, output_end, anchor, input - anchor, input - reference, match_length);
+            if (!output)
+            {
+                break;
+            }
+
+            input += match_length;
+            anchor = input;
+        }
+
+        Memory::free(finder.head);
+        Memory::free(finder.chain);
+
+        if (!output)
+        {
+            return 0;
+        }
+    }
+
+    output = write_sequence(output, output_end, anchor, input_end - anchor, 0, 0);
+    return output ? (size_t)(output - destination) : 0;
+}
+
+size_t Compression::compress_block(CompressionCodec codec, Span<const uint8_t> source, Span<uint8_t> destination)
+{
+    switch (codec)
+    {
+        case CompressionCodec::None:
+        {
+            if (source.count() > destination.count())
+            {
+                return 0;
+            }
+            Memory::copy(destination.elements(), source.elements(), source.count());
+            return source.count();
+        }
+
+        case CompressionCodec::Fast:
+        {
+            return compress_block_fast(source.elements(), source.count(), destination.elements(), destination.count());
+        }
+
+        case CompressionCodec::Dense:
+        {
+            return compress_block_dense(source.elements(), source.count(), destination.elements(), destination.count());
+        }
+    }
+
+    HC_ASSERT(false); // Invalid compression codec!
+    return 0;
+}
+
+static_internal ALWAYS_INLINE bool read_length(const uint8_t*& input, const uint8_t* input_end, size_t& length)
+{
+    uint8_t value;
+    do
+    {
+        if (input >= input_end)
+        {
+            return false;
+        }
+        value = *input++;
+        length += value;
+    } while (value == 255);
+
+    return true;
+}
+
+ErrorCode Compression::decompress_block(Span<const uint8_t> source, Span<uint8_t> destination, size_t* out_size)
+{
+    const uint8_t* input = source.elements();
+    const uint8_t* input_end = input + source.count();
+
+    uint8_t* output = destination.elements();
+    uint8_t* output_begin = output;
+    const uint8_t* output_end = output + destination.count();
+
+    while (true)
+    {
+        if (input >= input_end)
+        {
+            return ErrorCode::CorruptedData;
+        }
+
+        const uint8_t token = *input++;
+
+        size_t literals_length = token >> 4;
+        if (literals_length == 15 && !read_length(input, input_end, literals_length))
+        {
+            return ErrorCode::CorruptedData;
+        }
+
+        if (literals_length > (size_t)(input_end - input) || literals_length > (size_t)(output_end - output))
+        {
+            return ErrorCode::CorruptedData;
+        }
+
+        std::memcpy(output, input, literals_length);
+        input += literals_length;
+        output += literals_length;
+
+        // The last sequence has no match.
+        if (input == input_end)
+        {
+            break;
+        }
+
+        if (input_end - input < 2)
+        {
+            return ErrorCode::CorruptedData;
+        }
+
+        const size_t offset = (size_t)input[0] | ((size_t)input[1] << 8);
+        input += 2;
+
+        if (offset == 0 || offset > (size_t)(output - output_begin))
+        {
+            return ErrorCode::CorruptedData;
+        }
+
+        size_t match_length = token & 15;
+        if (match_length == 15 && !read_length(input, input_end, match_length))
+        {
+            return ErrorCode::CorruptedData;
+        }
+        match_length += MinMatch;
+
+        if (match_length > (size_t)(output_end - output))
+        {
+            return ErrorCode::CorruptedData;
+        }
+
+        const uint8_t* match = output - offset;
+        if (offset >= match_length)
+        {
+            std::memcpy(output, match, match_length);
+            output += match_length;
+        }
+        else
+        {
+            // The match overlaps the bytes it produces (a repeating pattern), so it must be copied byte by byte.
+            for (size_t index = 0; index < match_length; ++index)
+            {
+                *output++ = *match++;
+            }
+        }
+    }
+
+    *out_size = output - output_begin;
+    return ErrorCode::Success;
+}
+
+/**
+ * Validates the frame header and its chunk table.
+ * After this, all chunk ranges are known to lie inside the frame.
+ */
+static_internal ErrorCode parse_frame(Span<const uint8_t> frame, const CompressedFrameHeader** out_header, const CompressedChunk** out_chunks)
+{
+    if (frame.count() < sizeof(CompressedFrameHeader))
+    {
+        return ErrorCode::CorruptedData;
+    }
+
+    const CompressedFrameHeader* header = (const CompressedFrameHeader*)frame.elements();
+    if (header->magic != Compression::FrameMagic || header->codec > CompressionCodec::Dense)
+    {
+        return ErrorCode::CorruptedData;
+    }
+
+    if (header->chunk_size == 0 || header->uncompressed_size / header->chunk_size + (header->uncompressed_size % header->chunk_size != 0) != header->chunks_count)
+    {
+        return ErrorCode::CorruptedData;
+    }
+
+    if (sizeof(CompressedFrameHeader) + (uint64_t)header->chunks_count * sizeof(CompressedChunk) > frame.count())
+    {
+        return ErrorCode::CorruptedData;
+    }
+
+    const CompressedChunk* chunks = (const CompressedChunk*)(frame.elements() + sizeof(CompressedFrameHeader));
+    for (uint32_t chunk_index = 0; chunk_index < header->chunks_count; ++chunk_index)
+    {
+        const CompressedChunk& chunk = chunks[chunk_index];
+
+        const uint64_t chunk_begin = (uint64_t)chunk_index * header->chunk_size;
+        const uint64_t expected_size = Math::min<uint64_t>(header->chunk_size, header->uncompressed_size - chunk_begin);
+
+        if (chunk.uncompressed_size != expected_size || chunk.compressed_size > chunk.uncompressed_size)
+        {
+            return ErrorCode::CorruptedData;
+        }
+
+        if (chunk.offset > frame.count() || chunk.compressed_size > frame.count() - chunk.offset)
+        {
+            return ErrorCode::CorruptedData;
+        }
+    }
+
+    *out_header = header;
+    *out_chunks = chunks;
+    return ErrorCode::Success;
+}
+
+static_internal ErrorCode decompress_chunk(Span<const uint8_t> frame, const CompressedChunk& chunk, uint8_t* destination)
+{
+    const Span<const uint8_t> compressed = Span<const uint8_t>(frame.elements() + chunk.offset, chunk.compressed_size);
+
+    if (chunk.compressed_size == chunk.uncompressed_size)
+    {
+        Memory::copy(destination, compressed.elements(), chunk.uncompressed_size);
+        return ErrorCode::Success;
+    }
+
+    size_t decompressed_size = 0;
+    HC_CHECK_ERROR(Compression::decompress_block(compressed, Span<uint8_t>(destination, chunk.uncompressed_size), &decompressed_size));
+
+    if (decompressed_size != chunk.uncompressed_size)
+    {
+        return ErrorCode::CorruptedData;
+    }
+
+    return ErrorCode::Success;
+}
+
+ErrorCode Compression::compress(Span<const uint8_t> source, Buffer& out_frame, CompressionCodec codec, uint32_t chunk_size)
+{
+    if (chunk_size == 0)
+    {
+        HC_LOG_ERROR("Compression::compress - The chunk size can't be zero!");
+        return ErrorCode::InvalidParameter;
+    }
+
+    const uint64_t chunks_count_64 = (uint64_t)source.count() / chunk_size + ((uint64_t)source.count() % chunk_size != 0);
+    if (chunks_count_64 > 0xFFFFFFFF)
+    {
+        HC_LOG_ERROR("Compression::compress - Too many chunks! Increase the chunk size.");
+        return ErrorCode::InvalidParameter;
+    }
+    const uint32_t chunks_count = (uint32_t)chunks_count_64;
+
+    const size_t table_size = sizeof(CompressedFrameHeader) + chunks_count * sizeof(CompressedChunk);
+    const size_t chunk_bound = get_block_bound(chunk_size);
+
+    // Each chunk is compressed into its own slot of the scratch buffer, so the chunks are
+    //   independent of each other. The compressed chunks are packed together afterwards.
+    Buffer scratch = Buffer(table_size + chunks_count * chunk_bound);
+
+    CompressedFrameHeader& header = *scratch.as<CompressedFrameHeader>();
+    Memory::zero(&header, sizeof(CompressedFrameHeader));
+    header.magic = FrameMagic;
+    header.codec = codec;
+    header.chunk_size = chunk_size;
+    header.chunks_count = chunks_count;
+    header.uncompressed_size = source.count();
+
+    CompressedChunk* chunks = (CompressedChunk*)(scratch.data + sizeof(CompressedFrameHeader));
+
+    JobSystem::parallel_for(chunks_count, 1, [&](size_t begin_index, size_t end_index)
+    {
+        for (size_t chunk_index = begin_index; chunk_index < end_index; ++chunk_index)
+        {
+            const size_t chunk_begin = chunk_index * chunk_size;
+            const Span<const uint8_t> chunk_source = Span<const uint8_t>(source.elements() + chunk_begin, Math::min<size_t>(chunk_size, source.count() - chunk_begin));
+            uint8_t* slot = scratch.data + table_size + chunk_index * chunk_bound;
+
+            size_t compressed_size = compress_block(codec, chunk_source, Span<uint8_t>(slot, chunk_bound));
+
+            // Chunks that don't compress are stored as they are, so they are never bigger than the source.
+            if (compressed_size == 0 || compressed_size >= chunk_source.count())
+            {
+                Memory::copy(slot, chunk_source.elements(), chunk_source.count());
+                compressed_size = chunk_source.count();
+            }
+
+            chunks[chunk_index].compressed_size = (uint32_t)compressed_size;
+            chunks[chunk_index].uncompressed_size = (uint32_t)chunk_source.count();
+        }
+    });
+
+    size_t frame_size = table_size;
+    for (uint32_t chunk_index = 0; chunk_index < chunks_count; ++chunk_index)
+    {
+        chunks[chunk_index].offset = frame_size;
+        frame_size += chunks[chunk_index].compressed_size;
+    }
+
+    out_frame.allocate(frame_size);
+    Memory::copy(out_frame.data, scratch.data, table_size);
+    for (uint32_t chunk_index = 0; chunk_index < chunks_count; ++chunk_index)
+    {
+        const uint8_t* slot = scratch.data + table_size + chunk_index * chunk_bound;
+        Memory::copy(out_frame.data + chunks[chunk_index].offset, slot, chunks[chunk_index].compressed_size);
+    }
+
+    scratch.release();
+    return ErrorCode::Success;
+}
+
+ErrorCode Compression::get_decompressed_size(Span<const uint8_t> frame, uint64_t* out_size)
+{
+    const CompressedFrameHeader* header = nullptr;
+    const CompressedChunk* chunks = nullptr;
+    HC_CHECK_ERROR(parse_frame(frame, &header, &chunks));
+
+    *out_size = header->uncompressed_size;
+    return ErrorCode::Success;
+}
+
+ErrorCode Compression::decompress(Span<const uint8_t> frame, Buffer& out_buffer)
+{
+    uint64_t decompressed_size = 0;
+    HC_CHECK_ERROR(get_decompressed_size(frame, &decompressed_size));
+
+    out_buffer.allocate((size_t)decompressed_size);
+    const ErrorCode error = decompress_into(frame, Span<uint8_t>(out_buffer.data, out_buffer.size));
+    if (error != ErrorCode::Success)
+    {
+        out_buffer.release();
+    }
+
+    return error;
+}
+
+ErrorCode Compression::decompress_into(Span<const uint8_t> frame, Span<uint8_t> destination)
+{
+    const CompressedFrameHeader* header = nullptr;
+    const CompressedChunk* chunks = nullptr;
+    const ErrorCode parse_error = parse_frame(frame, &header, &chunks);
+    if (parse_error != ErrorCode::Success)
+    {
+        HC_LOG_ERROR("Compression::decompress_into - Invalid frame! The data is either corrupted or not compressed.");
+        return parse_error;
+    }
+
+    if (header->uncompressed_size != destination.count())
+    {
+        HC_LOG_ERROR("Compression::decompress_into - The destination size doesn't match the decompressed size!");
+        return ErrorCode::InvalidParameter;
+    }
+
+    Atomic<uint32_t> failed_count(0);
+    JobSystem::parallel_for(header->chunks_count, 1, [&](size_t begin_index, size_t end_index)
+    {
+        for (size_t chunk_index = begin_index; chunk_index < end_index; ++chunk_index)
+        {
+            uint8_t* chunk_destination = destination.elements() + chunk_index * header->chunk_size;
+            if (decompress_chunk(frame, chunks[chunk_index], chunk_destination) != ErrorCode::Success)
+            {
+                failed_count.fetch_add(1, MemoryOrder::Relaxed);
+            }
+        }
+    });
+
+    if (failed_count.load() > 0)
+    {
+        HC_LOG_ERROR("Compression::decompress_into - Failed to decompress %u chunk(s)! The data is corrupted.", failed_count.load());
+        return ErrorCode::CorruptedData;
+    }
+
+    return ErrorCode::Success;
+}
+
+ErrorCode DecompressionStream::open(Span<const uint8_t> frame)
+{
+    const CompressedFrameHeader* header = nullptr;
+    const CompressedChunk* chunks = nullptr;
+    const ErrorCode parse_error = parse_frame(frame, &header, &chunks);
+    if (parse_error != ErrorCode::Success)
+    {
+        HC_LOG_ERROR("DecompressionStream::open - Invalid frame! The data is either corrupted or not compressed.");
+        return parse_error;
+    }
+
+    m_frame = frame;
+    m_chunks = chunks;
+    m_chunks_count = header->chunks_count;
+    m_next_chunk_index = 0;
+    m_decompressed_size = header->uncompressed_size;
+    return ErrorCode::Success;
+}
+
+ErrorCode DecompressionStream::decode_next_chunk(Span<uint8_t> destination, size_t* out_size)
+{
+    HC_ASSERT(has_next_chunk()); // The stream is already done!
+
+    const CompressedChunk& chunk = m_chunks[m_next_chunk_index];
+    if (destination.count() < chunk.uncompressed_size)
+    {
+        HC_LOG_ERROR("DecompressionStream::decode_next_chunk - The destination is too small!");
+        return ErrorCode::InvalidParameter;
+    }
+
+    HC_CHECK_ERROR(decompress_chunk(m_frame, chunk, destination.elements()));
+
+    ++m_next_chunk_index;
+    *out_size = chunk.uncompressed_size;
+    return ErrorCode::Success;
+}
+
+} // namespace HC
@@ -0,0 +1,166 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Memory/Buffer.h"
+#include "Core/Containers/Span.h"
+
+namespace HC
+{
+
+enum class CompressionCodec : uint8_t
+{
+    // The data is stored uncompressed.
+    None = 0,
+
+    // LZ4 block format, with a single-probe match finder. Very fast, both ways.
+    Fast = 1,
+
+    // LZ4 block format, with a hash chain match finder. Compresses slower, but produces
+    //   smaller blocks. Decompression is as fast as for 'Fast'.
+    Dense = 2,
+};
+
+/**
+ * The layout of a compressed frame:
+ *   1. The header.
+ *   2. The chunk table - an array of 'CompressedChunk', one for each chunk.
+ *   3. The compressed chunks.
+ * The chunks are independent of each other, so they can be decompressed in any order.
+ */
+struct CompressedFrameHeader
+{
+    uint32_t magic;
+
+    CompressionCodec codec;
+    uint8_t reserved[3];
+
+    // The number of uncompressed bytes of each chunk. The last chunk might be smaller.
+    uint32_t chunk_size;
+    uint32_t chunks_count;
+
+    uint64_t uncompressed_size;
+};
+
+struct CompressedChunk
+{
+    // The offset of the compressed chunk, relative to the beginning of the frame.
+    uint64_t offset;
+
+    // If equal to the uncompressed size, the chunk is stored uncompressed.
+    uint32_t compressed_size;
+    uint32_t uncompressed_size;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Compression.
+ *----------------------------------------------------------------
+ * Block codecs, and chunked frames built on top of them.
+ * Blocks are the raw codec output, with no header. Frames split the data into independent
+ *   chunks, which are compressed and decompressed in parallel using the job system.
+ */
+class Compression
+{
+public:
+    static constexpr uint32_t FrameMagic = 0x5A434348; // 'HCCZ'
+
+    static constexpr uint32_t DefaultChunkSize = 256 * 1024;
+
+public:
+    /** @return The maximum size of a compressed block, for the given uncompressed size. */
+    ALWAYS_INLINE static size_t get_block_bound(size_t uncompressed_size)
+    {
+        return uncompressed_size + (uncompressed_size / 255) + 16;
+    }
+
+    /**
+     * Compresses a block.
+     *
+     * @param destination Where the block is written. Blocks always fit if it has at least 'get_block_bound' bytes.
+     *
+     * @return The size of the compressed block, or 0 if it doesn't fit in the destination or the
+     *   codec's working memory can't be allocated.
+     */
+    HC_API static size_t compress_block(CompressionCodec codec, Span<const uint8_t> source, Span<uint8_t> destination);
+
+    /**
+     * Decompresses a block produced by either the 'Fast' or 'Dense' codec.
+     * The input is validated, so it is safe to call this function with untrusted data.
+     *
+     * @param out_size The number of bytes written to the destination.
+     */
+    HC_API static ErrorCode decompress_block(Span<const uint8_t> source, Span<uint8_t> destination, size_t* out_size);
+
+public:
+    /**
+     * Compresses the data into a newly allocated frame.
+     * The buffer is owned by the caller, and must be released by calling 'Buffer::release'.
+     */
+    HC_API static ErrorCode compress(Span<const uint8_t> source, Buffer& out_frame, CompressionCodec codec = CompressionCodec::Fast, uint32_t chunk_size = DefaultChunkSize);
+
+    HC_API static ErrorCode get_decompressed_size(Span<const uint8_t> frame, uint64_t* out_size);
+
+    /**
+     * Decompresses the frame into a newly allocated buffer.
+     * The buffer is owned by the caller, and must be released by calling 'Buffer::release'.
+     */
+    HC_API static ErrorCode decompress(Span<const uint8_t> frame, Buffer& out_buffer);
+
+    /** Decompresses the frame into the destination, which must be exactly as big as the decompressed data. */
+    HC_API static ErrorCode decompress_into(Span<const uint8_t> frame, Span<uint8_t> destination);
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Decompression Stream.
+ *----------------------------------------------------------------
+ * Decompresses a frame one chunk at a time, directly into the memory provided by the caller.
+ * Useful when the decompressed data is consumed progressively (such as when uploading it to
+ *   the GPU), as only a single chunk has to be resident at a time.
+ * The frame memory must stay valid until the stream is done.
+ */
+class DecompressionStream
+{
+public:
+    DecompressionStream()
+        : m_chunks(nullptr)
+        , m_chunks_count(0)
+        , m_next_chunk_index(0)
+        , m_decompressed_size(0)
+    {}
+
+public:
+    HC_API ErrorCode open(Span<const uint8_t> frame);
+
+    ALWAYS_INLINE bool has_next_chunk() const { return m_next_chunk_index < m_chunks_count; }
+
+    ALWAYS_INLINE uint64_t get_decompressed_size() const { return m_decompressed_size; }
+
+    /** @return The number of bytes the next chunk decompresses to. */
+    ALWAYS_INLINE size_t get_next_chunk_size() const
+    {
+        HC_ASSERT(has_next_chunk()); // The stream is already done!
+        return m_chunks[m_next_chunk_index].uncompressed_size;
+    }
+
+    /**
+     * Decompresses the next chunk and advances the stream.
+     *
+     * @param destination Where the chunk is decompressed. Must be at least 'get_next_chunk_size' bytes.
+     * @param out_size The number of bytes written to the destination.
+     */
+    HC_API ErrorCode decode_next_chunk(Span<uint8_t> destination, size_t* out_size);
+
+private:
+    Span<const uint8_t> m_frame;
+
+    const CompressedChunk* m_chunks;
+    uint32_t m_chunks_count;
+    uint32_t m_next_chunk_index;
+
+    uint64_t m_decompressed_size;
+};
+
+} // namespace HC
@@ -0,0 +1,513 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "Config.h"
+#include "CommandLine.h"
+
+#include "Core/Platform/Platform.h"
+#include "Core/FileSystem/FileSystem.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace HC
+{
+
+// Stores the string values. Never released, as the bound fields keep pointing into it.
+static_internal char s_string_pool[Config::StringPoolBytesCount];
+static_internal size_t s_string_pool_used = 0;
+
+// Stores the problems found before the platform is initialized, until 'flush_problems' writes them.
+static_internal char s_queued_problems[Config::QueuedProblemsBytesCount];
+static_internal size_t s_queued_problems_used = 0;
+static_internal bool s_is_console_available = false;
+
+// The logger isn't initialized when the config is applied, so the problems are written directly to the console.
+// Before the platform is initialized, they are queued instead.
+static_internal void report_problem(const char* format, ...)
+{
+    char buffer[512];
+
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer) - 1, format, args);
+    va_end(args);
+
+    if (length < 0)
+    {
+        return;
+    }
+    length = Math::min<int>(length, (int)sizeof(buffer) - 2);
+
+    buffer[length++] = '\n';
+
+    if (s_is_console_available)
+    {
+        Platform::write_to_console(buffer, (size_t)length);
+        return;
+    }
+
+    // The problems that don't fit in the queue are dropped.
+    if ((size_t)length <= Config::QueuedProblemsBytesCount - s_queued_problems_used)
+    {
+        std::memcpy(s_queued_problems + s_queued_problems_used, buffer, (size_t)length);
+        s_queued_problems_used += (size_t)length;
+    }
+}
+
+static_internal bool is_whitespace(char character)
+{
+    return (character == ' ') || (character == '\t') || (character == '\r');
+}
+
+static_internal StringView make_view(const char* begin, const char* end)
+{
+    return StringView(begin, (size_t)(end - begin));
+}
+
+static_internal StringView trim(StringView view)
+{
+    const char* begin = view.c_str();
+    const char* end = begin + view.bytes_count();
+    while (begin < end && is_whitespace(*begin))
+    {
+        ++begin;
+    }
+    while (end > begin && is_whitespace(*(end - 1)))
+    {
+        --end;
+    }
+    return make_view(begin, end);
+}
+
+static_internal bool is_equal(StringView view, const char* string)
+{
+    const size_t length = std::strlen(string);
+    return (view.bytes_count() == length) && (length == 0 || std::memcmp(view.c_str(), string, length) == 0);
+}
+
+static_internal const ConfigBinding* find_binding(Span<const ConfigBinding> bindings, StringView section, StringView key)
+{
+    for (size_t index = 0; index < bindings.count(); ++index)
+    {
+        const ConfigBinding& binding = bindings.elements()[index];
+        if (is_equal(section, binding.section) && is_equal(key, binding.key))
+        {
+            return &binding;
+        }
+    }
+    return nullptr;
+}
+
+static_internal bool parse_bool(StringView value, bool& out_value)
+{
+    if (is_equal(value, "true") || is_equal(value, "1"))
+    {
+        out_value = true;
+        return true;
+    }
+    if (is_equal(value, "false") || is_equal(value, "0"))
+    {
+        out_value = false;
+        return true;
+    }
+    return false;
+}
+
+// Decimal or hexadecimal (0x), with optional '_' digit separators and an optional KB/MB/GB suffix.
+static_internal bool parse_unsigned(StringView value, uint64_t& out_value)
+{
+    const char* current = value.c_str();
+    const char* end = current + value.bytes_count();
+
+    uint64_t base = 10;
+    if (end - current > 2 && current[0] == '0' && (current[1] == 'x' || current[1] == 'X'))
+    {
+        base = 16;
+        current += 2;
+    }
+
+    uint64_t result = 0;
+    uint32_t digits_count = 0;
+    for (; current < end; ++current)
+    {
+        const char character = *current;
+        uint64_t digit;
+        if (character == '_')
+        {
+            continue;
+        }
+        else if (character >= '0' && character <= '9')
+        {
+            digit = (uint64_t)(character - '0');
+        }
+        else if (base == 16 && character >= 'a' && character <= 'f')
+        {
+            digit = (uint64_t)(character - 'a' + 10);
+        }
+        else if (base == 16 && character >= 'A' && character <= 'F')
+        {
+            digit = (uint64_t)(character - 'A' + 10);
+        }
+        else
+        {
+            break;
+        }
+
+        if (result > ((uint64_t)-1 - digit) / base)
+        {
+            return false;
+        }
+        result = result * base + digit;
+        ++digits_count;
+    }
+
+    if (digits_count == 0)
+    {
+        return false;
+    }
+
+    const StringView suffix = trim(make_view(current, end));
+    uint64_t multiplier = 1;
+    if (is_equal(suffix, "KB"))
+    {
+        multiplier = 1024ull;
+    }
+    else if (is_equal(suffix, "MB"))
+    {
+        multiplier = 1024ull * 1024;
+    }
+    else if (is_equal(suffix, "GB"))
+    {
+        multiplier = 1024ull * 1024 * 1024;
+    }
+    else if (suffix.bytes_count() > 0)
+    {
+        return false;
+    }
+
+    if (result > (uint64_t)-1 / multiplier)
+    {
+        return false;
+    }
+
+    out_value = result * multiplier;
+    return true;
+}
+
+static_internal bool parse_float(StringView value, float32_t& out_value)
+{
+    // The value isn't NUL terminated, so it is copied into a local buffer first.
+    char buffer[64];
+    if (value.bytes_count() == 0 || value.bytes_count() >= sizeof(buffer))
+    {
+        return false;
+    }
+    std::memcpy(buffer, value.c_str(), value.bytes_count());
+    buffer[value.bytes_count()] = 0;
+
+    char* parse_end = nullptr;
+    const double result = std::strtod(buffer, &parse_end);
+    if (parse_end != buffer + value.bytes_count())
+    {
+        return false;
+    }
+
+    out_value = (float32_t)result;
+    return true;
+}
+
+// Unquotes (and unescapes) the string, and copies it into the string pool, NUL terminated.
+static_internal bool parse_string(StringView value, StringView& out_value)
+{
+    const char* current = value.c_str();
+    const char* end = current + value.bytes_count();
+    const bool is_quoted = (current < end && *current == '"');
+
+    char* destination = s_string_pool + s_string_pool_used;
+    const char* destination_end = s_string_pool + Config::StringPoolBytesCount - 1;
+    char* destination_begin = destination;
+
+    if (is_quoted)
+    {
+        ++current;
+    }
+
+    bool is_closed = !is_quoted;
+    for (; current < end; ++current)
+    {
+        char character = *current;
+        if (is_quoted && character == '"')
+        {
+            is_closed = true;
+            ++current;
+            break;
+        }
+
+        if (is_quoted && character == '\\' && current + 1 < end)
+        {
+            ++current;
+            switch (*current)
+            {
+                case 'n':  character = '\n'; break;
+                case 't':  character = '\t'; break;
+                case '"':  character = '"';  break;
+                case '\\': character = '\\'; break;
+                default:   return false;
+            }
+        }
+
+        if (destination == destination_end)
+        {
+            report_problem("Config - The string pool is exhausted! Increase 'Config::StringPoolBytesCount'.");
+            return false;
+        }
+        *destination++ = character;
+    }
+
+    // Only whitespace can follow the closing quote.
+    if (!is_closed || trim(make_view(current, end)).bytes_count() > 0)
+    {
+        return false;
+    }
+
+    *destination++ = 0;
+    out_value = StringView(destination_begin, (size_t)(destination - destination_begin - 1));
+    s_string_pool_used = (size_t)(destination - s_string_pool);
+    return true;
+}
+
+// Finds where the trailing comment of a value starts, ignoring the comment characters inside quotes.
+static_internal const char* find_comment(const char* begin, const char* end)
+{
+    bool is_in_quotes = false;
+    for (const char* current = begin; current < end; ++current)
+    {
+        if (is_in_quotes && *current == '\\')
+        {
+            ++current;
+        }
+        else if (*current == '"')
+        {
+            is_in_quotes = !is_in_quotes;
+        }
+        else if (!is_in_quotes && (*current == '#' || *current == ';'))
+        {
+            return current;
+        }
+    }
+    return end;
+}
+
+void Config::flush_problems()
+{
+    s_is_console_available = true;
+    if (s_queued_problems_used > 0)
+    {
+        Platform::write_to_console(s_queued_problems, s_queued_problems_used);
+        s_queued_problems_used = 0;
+    }
+}
+
+// The file system reports the details of its failures through the logger, which isn't initialized
+//   while the config is applied. The reason is included in the reported problem instead.
+static_internal const char* get_file_error_reason(ErrorCode error)
+{
+    switch (error)
+    {
+        case ErrorCode::FileNotFound:       return "The file doesn't exist";
+        case ErrorCode::FileOpenFailed:     return "The file can't be opened";
+        case ErrorCode::FileReadFailed:     return "The file can't be read";
+        case ErrorCode::FileMappingFailed:  return "The file can't be mapped";
+        default:                            return "Unknown error";
+    }
+}
+
+ErrorCode Config::apply_file(StringView filepath, Span<const ConfigBinding> bindings)
+{
+    uint64_t file_size = 0;
+    const ErrorCode size_error = FileSystem::get_file_size(filepath, &file_size);
+    if (size_error != ErrorCode::Success)
+    {
+        report_problem("Config - Failed to open the config file '%.*s'! %s.", (int)filepath.bytes_count(), filepath.c_str(), get_file_error_reason(size_error));
+        return size_error;
+    }
+
+    // Empty files can't be mapped, and have nothing to apply anyway.
+    if (file_size == 0)
+    {
+        return ErrorCode::Success;
+    }
+
+    MappedFile file;
+    const ErrorCode error = file.open(filepath, FileMapMode::Readonly, 0, 0, Platform::AccessHint::Sequential);
+    if (error != ErrorCode::Success)
+    {
+        report_problem("Config - Failed to map the config file '%.*s'! %s.", (int)filepath.bytes_count(), filepath.c_str(), get_file_error_reason(error));
+        return error;
+    }
+
+    // The name is only used for reporting, so a truncated path is fine.
+    char source_name[256];
+    snprintf(source_name, sizeof(source_name), "%.*s", (int)filepath.bytes_count(), filepath.c_str());
+
+    apply_text(Span<const char>((const char*)file.data(), file.size()), bindings, source_name);
+    return ErrorCode::Success;
+}
+
+void Config::apply_text(Span<const char> text, Span<const ConfigBinding> bindings, const char* source_name)
+{
+    const char* current = text.elements();
+    const char* text_end = current + text.count();
+
+    StringView section;
+    uint32_t line_number = 0;
+
+    while (current < text_end)
+    {
+        const char* line_end = (const char*)std::memchr(current, '\n', (size_t)(text_end - current));
+        if (!line_end)
+        {
+            line_end = text_end;
+        }
+
+        const StringView line = trim(make_view(current, line_end));
+        current = line_end + 1;
+        ++line_number;
+
+        const char* line_begin = line.c_str();
+        if (line.bytes_count() == 0 || *line_begin == '#' || *line_begin == ';')
+        {
+            continue;
+        }
+
+        const char* end = line_begin + line.bytes_count();
+        if (*line_begin == '[')
+        {
+            const char* section_end = (const char*)std::memchr(line_begin, ']', line.bytes_count());
+            if (!section_end || trim(make_view(section_end + 1, find_comment(section_end + 1, end))).bytes_count() > 0)
+            {
+                report_problem("Config - %s(%u): Malformed section header.", source_name, line_number);
+                section = StringView();
+                continue;
+            }
+
+            section = trim(make_view(line_begin + 1, section_end));
+            continue;
+        }
+
+        const char* separator = (const char*)std::memchr(line_begin, '=', line.bytes_count());
+        if (!separator)
+        {
+            report_problem("Config - %s(%u): Expected 'key = value'.", source_name, line_number);
+            continue;
+        }
+
+        const StringView key = trim(make_view(line_begin, separator));
+        const StringView value = trim(make_view(separator + 1, find_comment(separator + 1, end)));
+
+        const ConfigBinding* binding = find_binding(bindings, section, key);
+        if (!binding)
+        {
+            report_problem("Config - %s(%u): Unknown key '%.*s.%.*s'.", source_name, line_number,
+                (int)section.bytes_count(), section.c_str(), (int)key.bytes_count(), key.c_str());
+            continue;
+        }
+
+        if (!apply_value(*binding, value))
+        {
+            report_problem("Config - %s(%u): Invalid value '%.*s' for '%s.%s'.", source_name, line_number,
+                (int)value.bytes_count(), value.c_str(), binding->section, binding->key);
+        }
+    }
+}
+
+void Config::apply_command_line(Span<const ConfigBinding> bindings)
+{
+    CommandLine::for_each_option([bindings](StringView name, StringView value) -> bool
+    {
+        // Only the options named 'Section.key' are config overrides.
+        const char* separator = (const char*)std::memchr(name.c_str(), '.', name.bytes_count());
+        if (!separator)
+        {
+            return true;
+        }
+
+        const StringView section = make_view(name.c_str(), separator);
+        const StringView key = make_view(separator + 1, name.c_str() + name.bytes_count());
+
+        const ConfigBinding* binding = find_binding(bindings, section, key);
+        if (!binding)
+        {
+            // The option might target bindings that are applied separately (for example, the platform ones).
+            return true;
+        }
+
+        // A boolean flag without a value enables the option.
+        if (binding->type == ConfigValueType::Bool && value.bytes_count() == 0)
+        {
+            *(bool*)binding->target = true;
+            return true;
+        }
+
+        if (!apply_value(*binding, value))
+        {
+            report_problem("Config - Invalid command line value '%.*s' for '%s.%s'.",
+                (int)value.bytes_count(), value.c_str(), binding->section, binding->key);
+        }
+        return true;
+    });
+}
+
+bool Config::apply_value(const ConfigBinding& binding, StringView value)
+{
+    switch (binding.type)
+    {
+        case ConfigValueType::Bool:
+        {
+            return parse_bool(value, *(bool*)binding.target);
+        }
+
+        case ConfigValueType::UInt32:
+        {
+            uint64_t result = 0;
+            if (!parse_unsigned(value, result) || result > 0xFFFFFFFF)
+            {
+                return false;
+            }
+            *(uint32_t*)binding.target = (uint32_t)result;
+            return true;
+        }
+
+        case ConfigValueType::UInt64:
+        {
+            return parse_unsigned(value, *(uint64_t*)binding.target);
+        }
+
+        case ConfigValueType::Float32:
+        {
+            return parse_float(value, *(float32_t*)binding.target);
+        }
+
+        case ConfigValueType::String:
+        {
+            StringView result;
+            if (!parse_string(value, result))
+            {
+                return false;
+            }
+            *(const char**)binding.target = result.c_str();
+            return true;
+        }
+
+        case ConfigValueType::StringView:
+        {
+            return parse_string(value, *(StringView*)binding.target);
+        }
+    }
+
+    return false;
+}
+
+} // namespace HC
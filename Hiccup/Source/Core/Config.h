@@ -0,0 +1,103 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Containers/Span.h"
+#include "Core/Containers/StringView.h"
+
+namespace HC
+{
+
+enum class ConfigValueType : uint8_t
+{
+    Bool,
+    UInt32,
+    UInt64,
+    Float32,
+
+    // Bound to a 'const char*' field. The string is NUL terminated.
+    String,
+
+    // Bound to a 'StringView' field.
+    StringView,
+};
+
+/**
+ * Binds a config key to a field of a description structure. When the key is found, its value
+ *   is parsed according to the field type and written directly into the field.
+ * Created with 'HC_CONFIG_BIND', which deduces the type from the field.
+ */
+struct ConfigBinding
+{
+    const char* section;
+    const char* key;
+    ConfigValueType type;
+    void* target;
+
+    ALWAYS_INLINE static ConfigBinding bind(const char* section, const char* key, bool* target) { return { section, key, ConfigValueType::Bool, target }; }
+    ALWAYS_INLINE static ConfigBinding bind(const char* section, const char* key, uint32_t* target) { return { section, key, ConfigValueType::UInt32, target }; }
+    ALWAYS_INLINE static ConfigBinding bind(const char* section, const char* key, uint64_t* target) { return { section, key, ConfigValueType::UInt64, target }; }
+    ALWAYS_INLINE static ConfigBinding bind(const char* section, const char* key, float32_t* target) { return { section, key, ConfigValueType::Float32, target }; }
+    ALWAYS_INLINE static ConfigBinding bind(const char* section, const char* key, const char** target) { return { section, key, ConfigValueType::String, target }; }
+    ALWAYS_INLINE static ConfigBinding bind(const char* section, const char* key, StringView* target) { return { section, key, ConfigValueType::StringView, target }; }
+};
+
+// Binds the field of a description structure to the config key with the same name.
+#define HC_CONFIG_BIND(SECTION, DESCRIPTION, FIELD) ::HC::ConfigBinding::bind(SECTION, #FIELD, &(DESCRIPTION).FIELD)
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Config.
+ *----------------------------------------------------------------
+ * Loads the tuning knobs of the engine from a config file and from the command line, so they
+ *   can be changed per deployment without recompiling.
+ * Nothing is allocated on the heap, so the config is applied before the memory system is initialized:
+ *   the file is memory mapped and parsed in place, the values are written directly into the bound
+ *   fields, and string values are copied into a fixed-size pool that lives for the whole process.
+ * Problems are reported directly to the console, as the logger isn't initialized yet. This includes
+ *   the failures to open the config file, whose details the file system would otherwise only log.
+ *   The problems found before the platform is initialized are queued, and written by 'flush_problems'.
+ *
+ * The file format is a subset of INI/TOML:
+ *   # Comments start with '#' or ';'.
+ *   [Memory]
+ *   use_guarded_allocator = true
+ *   guarded_allocator_reserve_size = 16GB     # Integers accept '_' separators, hex (0x) and KB/MB/GB suffixes.
+ *   leak_report_json_filepath = "Leaks.json"  # Strings can be quoted, with \" \\ \n \t escapes.
+ *
+ * Command line options named 'Section.key' override the file: '-Memory.use_guarded_allocator=true'.
+ * A boolean option without a value ('-Memory.use_guarded_allocator') sets the field to true.
+ */
+class Config
+{
+public:
+    // The capacity of the pool where the string values are stored.
+    static constexpr size_t StringPoolBytesCount = 4096;
+
+    // The capacity of the queue where the problems found before the platform is initialized are stored.
+    static constexpr size_t QueuedProblemsBytesCount = 2048;
+
+public:
+    /**
+     * Maps the config file and applies its values to the bound fields.
+     *
+     * @return An error code if the file can't be opened. Malformed lines and unknown keys are
+     *   reported and skipped, so they don't fail the load.
+     */
+    HC_API static ErrorCode apply_file(StringView filepath, Span<const ConfigBinding> bindings);
+
+    /** Applies config text, already in memory. The name is only used when reporting problems. */
+    HC_API static void apply_text(Span<const char> text, Span<const ConfigBinding> bindings, const char* source_name);
+
+    /** Applies the command line options named 'Section.key'. Should be called after 'apply_file', so it takes precedence. */
+    HC_API static void apply_command_line(Span<const ConfigBinding> bindings);
+
+    /** Parses a value according to the binding type and writes it into the bound field. @return False if the value is malformed. */
+    HC_API static bool apply_value(const ConfigBinding& binding, StringView value);
+
+    /** Writes the queued problems to the console. Invoked once the platform is initialized; later problems are written directly. */
+    HC_API static void flush_problems();
+};
+
+} // namespace HC
@@ -91,7 +91,7 @@ public:
     }
 
 public:
-    ALWAYS_INLINE T* data() const { return m_data }
+    ALWAYS_INLINE T* data() const { return m_data; }
 
     ALWAYS_INLINE size_t size() const { return m_size; }
 
@@ -327,7 +327,7 @@ private:
     // Checks whether or not the container can store an additional number of elements, without reallocating.
     ALWAYS_INLINE bool should_grow(size_t required_additional_size) const
     {
-        return (m_size + required_additional_size) > m_capacity;
+        return HC_UNLIKELY((m_size + required_additional_size) > m_capacity);
     }
 
     // Calculates the array's natural growth.
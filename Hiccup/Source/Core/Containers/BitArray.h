@@ -0,0 +1,512 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Math/MathUtilities.h"
+#include "Array.h"
+
+#if HC_SIMD_SSE
+    #include <emmintrin.h>
+#endif // HC_SIMD_SSE
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Bit Operations.
+ *----------------------------------------------------------------
+ * Word-wise operations over densely packed bits, shared by the bit array containers.
+ * The bits past the end of the last word must always be zero, so the scans and counts
+ *   never have to mask the last word.
+ */
+struct BitOperations
+{
+public:
+    static constexpr size_t BitsPerWord = 64;
+
+    // Returned by the find functions when no bit matches.
+    static constexpr size_t InvalidIndex = (size_t)(-1);
+
+public:
+    ALWAYS_INLINE static constexpr size_t get_words_count(size_t bits_count)
+    {
+        return (bits_count + BitsPerWord - 1) / BitsPerWord;
+    }
+
+    ALWAYS_INLINE static constexpr uint64_t get_bit_mask(size_t index)
+    {
+        return 1ULL << (index % BitsPerWord);
+    }
+
+    // The mask of the bits that are in use in the last word.
+    ALWAYS_INLINE static constexpr uint64_t get_last_word_mask(size_t bits_count)
+    {
+        return (bits_count % BitsPerWord) ? (get_bit_mask(bits_count) - 1) : ~0ULL;
+    }
+
+public:
+    /** @return The index of the first set bit, starting from (and including) 'from', or 'InvalidIndex'. */
+    static size_t find_next_set(const uint64_t* words, size_t bits_count, size_t from)
+    {
+        if (from >= bits_count)
+        {
+            return InvalidIndex;
+        }
+
+        const size_t words_count = get_words_count(bits_count);
+        size_t word_index = from / BitsPerWord;
+        uint64_t word = words[word_index] & ~(get_bit_mask(from) - 1);
+
+        while (word == 0)
+        {
+            if (++word_index == words_count)
+            {
+                return InvalidIndex;
+            }
+            word = words[word_index];
+        }
+
+        return word_index * BitsPerWord + Math::count_trailing_zeros(word);
+    }
+
+    /** @return The index of the first clear bit, starting from (and including) 'from', or 'InvalidIndex'. */
+    static size_t find_next_clear(const uint64_t* words, size_t bits_count, size_t from)
+    {
+        if (from >= bits_count)
+        {
+            return InvalidIndex;
+        }
+
+        const size_t words_count = get_words_count(bits_count);
+        size_t word_index = from / BitsPerWord;
+        uint64_t word = ~words[word_index] & ~(get_bit_mask(from) - 1);
+
+        while (word == 0)
+        {
+            if (++word_index == words_count)
+            {
+                return InvalidIndex;
+            }
+            word = ~words[word_index];
+        }
+
+        // The unused bits of the last word are zero, so they are found as clear.
+        const size_t index = word_index * BitsPerWord + Math::count_trailing_zeros(word);
+        return (index < bits_count) ? index : InvalidIndex;
+    }
+
+    /** @return The number of set bits in the range [begin, end). */
+    static size_t count_set(const uint64_t* words, size_t begin, size_t end)
+    {
+        if (begin >= end)
+        {
+            return 0;
+        }
+
+        const size_t first_word = begin / BitsPerWord;
+        const size_t last_word = (end - 1) / BitsPerWord;
+        const uint64_t first_mask = ~(get_bit_mask(begin) - 1);
+        const uint64_t last_mask = get_last_word_mask(end);
+
+        if (first_word == last_word)
+        {
+            return Math::popcount(words[first_word] & first_mask & last_mask);
+        }
+
+        size_t count = Math::popcount(words[first_word] & first_mask);
+        for (size_t word_index = first_word + 1; word_index < last_word; ++word_index)
+        {
+            count += Math::popcount(words[word_index]);
+        }
+        count += Math::popcount(words[last_word] & last_mask);
+        return count;
+    }
+
+    static bool is_any_set(const uint64_t* words, size_t words_count)
+    {
+        uint64_t accumulator = 0;
+        for (size_t word_index = 0; word_index < words_count; ++word_index)
+        {
+            accumulator |= words[word_index];
+        }
+        return (accumulator != 0);
+    }
+
+public:
+    // The bulk operations process two words per instruction. They keep the unused bits
+    //   zero, as long as both operands do.
+
+    static void bitwise_and(uint64_t* destination, const uint64_t* source, size_t words_count)
+    {
+        size_t word_index = 0;
+#if HC_SIMD_SSE
+        for (; word_index + 2 <= words_count; word_index += 2)
+        {
+            const __m128i a = _mm_loadu_si128((const __m128i*)(destination + word_index));
+            const __m128i b = _mm_loadu_si128((const __m128i*)(source + word_index));
+            _mm_storeu_si128((__m128i*)(destination + word_index), _mm_and_si128(a, b));
+        }
+#endif // HC_SIMD_SSE
+        for (; word_index < words_count; ++word_index)
+        {
+            destination[word_index] &= source[word_index];
+        }
+    }
+
+    static void bitwise_or(uint64_t* destination, const uint64_t* source, size_t words_count)
+    {
+        size_t word_index = 0;
+#if HC_SIMD_SSE
+        for (; word_index + 2 <= words_count; word_index += 2)
+        {
+            const __m128i a = _mm_loadu_si128((const __m128i*)(destination + word_index));
+            const __m128i b = _mm_loadu_si128((const __m128i*)(source + word_index));
+            _mm_storeu_si128((__m128i*)(destination + word_index), _mm_or_si128(a, b));
+        }
+#endif // HC_SIMD_SSE
+        for (; word_index < words_count; ++word_index)
+        {
+            destination[word_index] |= source[word_index];
+        }
+    }
+
+    // destination = destination & ~source.
+    static void bitwise_and_not(uint64_t* destination, const uint64_t* source, size_t words_count)
+    {
+        size_t word_index = 0;
+#if HC_SIMD_SSE
+        for (; word_index + 2 <= words_count; word_index += 2)
+        {
+            const __m128i a = _mm_loadu_si128((const __m128i*)(destination + word_index));
+            const __m128i b = _mm_loadu_si128((const __m128i*)(source + word_index));
+            // '_mm_andnot_si128' negates its first operand.
+            _mm_storeu_si128((__m128i*)(destination + word_index), _mm_andnot_si128(b, a));
+        }
+#endif // HC_SIMD_SSE
+        for (; word_index < words_count; ++word_index)
+        {
+            destination[word_index] &= ~source[word_index];
+        }
+    }
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Bit Array.
+ *----------------------------------------------------------------
+ * A dynamic array of bits, packed in 64-bit words. Used for occupancy masks, free lists
+ *   and any set of small integers.
+ * Iterating over the set bits skips whole empty words, so sparse arrays are cheap to scan:
+ *
+ *     for (size_t index = bits.find_first_set(); index != BitArray<>::InvalidIndex; index = bits.find_next_set(index + 1))
+ */
+template<typename AllocatorType = HeapAllocator>
+class BitArray
+{
+public:
+    static constexpr size_t InvalidIndex = BitOperations::InvalidIndex;
+
+public:
+    BitArray()
+        : m_bits_count(0)
+    {}
+
+    explicit BitArray(size_t bits_count, bool value = false)
+        : m_bits_count(0)
+    {
+        set_count(bits_count, value);
+    }
+
+public:
+    ALWAYS_INLINE size_t count() const { return m_bits_count; }
+    ALWAYS_INLINE bool is_empty() const { return (m_bits_count == 0); }
+
+    ALWAYS_INLINE uint64_t* words() { return m_words.data(); }
+    ALWAYS_INLINE const uint64_t* words() const { return m_words.data(); }
+    ALWAYS_INLINE size_t words_count() const { return m_words.size(); }
+
+public:
+    ALWAYS_INLINE bool test(size_t index) const
+    {
+        HC_DASSERT(index < m_bits_count); // Index out of range!
+        return (m_words[index / BitOperations::BitsPerWord] & BitOperations::get_bit_mask(index)) != 0;
+    }
+
+    ALWAYS_INLINE void set(size_t index)
+    {
+        HC_DASSERT(index < m_bits_count); // Index out of range!
+        m_words[index / BitOperations::BitsPerWord] |= BitOperations::get_bit_mask(index);
+    }
+
+    ALWAYS_INLINE void clear(size_t index)
+    {
+        HC_DASSERT(index < m_bits_count); // Index out of range!
+        m_words[index / BitOperations::BitsPerWord] &= ~BitOperations::get_bit_mask(index);
+    }
+
+    ALWAYS_INLINE void assign(size_t index, bool value)
+    {
+        value ? set(index) : clear(index);
+    }
+
+    ALWAYS_INLINE bool operator[](size_t index) const { return test(index); }
+
+public:
+    /**
+     * Resizes the array.
+     *
+     * @param new_count The new number of bits.
+     * @param value The value of the newly added bits.
+     */
+    void set_count(size_t new_count, bool value = false)
+    {
+        const size_t old_count = m_bits_count;
+        if (old_count > 0 && new_count > old_count)
+        {
+            // Filling the unused bits of the current last word.
+            uint64_t& last_word = m_words[(old_count - 1) / BitOperations::BitsPerWord];
+            if (value)
+            {
+                last_word |= ~BitOperations::get_last_word_mask(old_count);
+            }
+        }
+
+        m_words.set_size_uninitialized(BitOperations::get_words_count(new_count));
+        for (size_t word_index = BitOperations::get_words_count(old_count); word_index < m_words.size(); ++word_index)
+        {
+            m_words[word_index] = value ? ~0ULL : 0ULL;
+        }
+
+        m_bits_count = new_count;
+        clear_unused_bits();
+    }
+
+    /** Appends a bit. @return The index of the bit. */
+    size_t add(bool value)
+    {
+        const size_t index = m_bits_count;
+        set_count(m_bits_count + 1, value);
+        return index;
+    }
+
+    void set_all()
+    {
+        for (size_t word_index = 0; word_index < m_words.size(); ++word_index)
+        {
+            m_words[word_index] = ~0ULL;
+        }
+        clear_unused_bits();
+    }
+
+    void clear_all()
+    {
+        Memory::zero(m_words.data(), m_words.size() * sizeof(uint64_t));
+    }
+
+public:
+    ALWAYS_INLINE size_t find_first_set() const { return BitOperations::find_next_set(words(), m_bits_count, 0); }
+    ALWAYS_INLINE size_t find_next_set(size_t from) const { return BitOperations::find_next_set(words(), m_bits_count, from); }
+
+    ALWAYS_INLINE size_t find_first_clear() const { return BitOperations::find_next_clear(words(), m_bits_count, 0); }
+    ALWAYS_INLINE size_t find_next_clear(size_t from) const { return BitOperations::find_next_clear(words(), m_bits_count, from); }
+
+    /** @return The number of set bits. */
+    ALWAYS_INLINE size_t count_set() const { return BitOperations::count_set(words(), 0, m_bits_count); }
+
+    /** @return The number of set bits in the range [begin, end). */
+    ALWAYS_INLINE size_t count_set(size_t begin, size_t end) const
+    {
+        HC_DASSERT(begin <= end && end <= m_bits_count); // Invalid range!
+        return BitOperations::count_set(words(), begin, end);
+    }
+
+    ALWAYS_INLINE bool is_any_set() const { return BitOperations::is_any_set(words(), m_words.size()); }
+
+    /** Invokes 'function(index)' for each set bit, in ascending order. */
+    template<typename Function>
+    void for_each_set(const Function& function) const
+    {
+        for (size_t word_index = 0; word_index < m_words.size(); ++word_index)
+        {
+            for (uint64_t word = m_words[word_index]; word != 0; word &= word - 1)
+            {
+                function(word_index * BitOperations::BitsPerWord + Math::count_trailing_zeros(word));
+            }
+        }
+    }
+
+public:
+    // The bulk operations require both arrays to have the same number of bits.
+
+    void and_with(const BitArray& other)
+    {
+        HC_ASSERT(m_bits_count == other.m_bits_count); // The bit arrays have different sizes!
+        BitOperations::bitwise_and(words(), other.words(), m_words.size());
+    }
+
+    void or_with(const BitArray& other)
+    {
+        HC_ASSERT(m_bits_count == other.m_bits_count); // The bit arrays have different sizes!
+        BitOperations::bitwise_or(words(), other.words(), m_words.size());
+    }
+
+    /** Clears all the bits that are set in the other array. */
+    void and_not_with(const BitArray& other)
+    {
+        HC_ASSERT(m_bits_count == other.m_bits_count); // The bit arrays have different sizes!
+        BitOperations::bitwise_and_not(words(), other.words(), m_words.size());
+    }
+
+private:
+    ALWAYS_INLINE void clear_unused_bits()
+    {
+        if (m_bits_count > 0)
+        {
+            m_words.back() &= BitOperations::get_last_word_mask(m_bits_count);
+        }
+    }
+
+private:
+    Array<uint64_t, AllocatorType> m_words;
+    size_t m_bits_count;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Fixed Bit Array.
+ *----------------------------------------------------------------
+ * A bit array whose size is fixed at compile time, so the words are stored inline.
+ */
+template<size_t BitsCount>
+class FixedBitArray
+{
+public:
+    static constexpr size_t InvalidIndex = BitOperations::InvalidIndex;
+    static constexpr size_t WordsCount = BitOperations::get_words_count(BitsCount);
+
+public:
+    ALWAYS_INLINE static constexpr size_t count() { return BitsCount; }
+
+    ALWAYS_INLINE uint64_t* words() { return m_words; }
+    ALWAYS_INLINE const uint64_t* words() const { return m_words; }
+    ALWAYS_INLINE static constexpr size_t words_count() { return WordsCount; }
+
+public:
+    ALWAYS_INLINE bool test(size_t index) const
+    {
+        HC_DASSERT(index < BitsCount); // Index out of range!
+        return (m_words[index / BitOperations::BitsPerWord] & BitOperations::get_bit_mask(index)) != 0;
+    }
+
+    ALWAYS_INLINE void set(size_t index)
+    {
+        HC_DASSERT(index < BitsCount); // Index out of range!
+        m_words[index / BitOperations::BitsPerWord] |= BitOperations::get_bit_mask(index);
+    }
+
+    ALWAYS_INLINE void clear(size_t index)
+    {
+        HC_DASSERT(index < BitsCount); // Index out of range!
+        m_words[index / BitOperations::BitsPerWord] &= ~BitOperations::get_bit_mask(index);
+    }
+
+    ALWAYS_INLINE void assign(size_t index, bool value)
+    {
+        value ? set(index) : clear(index);
+    }
+
+    ALWAYS_INLINE bool operator[](size_t index) const { return test(index); }
+
+    void set_all()
+    {
+        for (size_t word_index = 0; word_index < WordsCount; ++word_index)
+        {
+            m_words[word_index] = ~0ULL;
+        }
+        m_words[WordsCount - 1] &= BitOperations::get_last_word_mask(BitsCount);
+    }
+
+    void clear_all()
+    {
+        Memory::zero(m_words, sizeof(m_words));
+    }
+
+public:
+    ALWAYS_INLINE size_t find_first_set() const { return BitOperations::find_next_set(m_words, BitsCount, 0); }
+    ALWAYS_INLINE size_t find_next_set(size_t from) const { return BitOperations::find_next_set(m_words, BitsCount, from); }
+
+    ALWAYS_INLINE size_t find_first_clear() const { return BitOperations::find_next_clear(m_words, BitsCount, 0); }
+    ALWAYS_INLINE size_t find_next_clear(size_t from) const { return BitOperations::find_next_clear(m_words, BitsCount, from); }
+
+    ALWAYS_INLINE size_t count_set() const { return BitOperations::count_set(m_words, 0, BitsCount); }
+
+    ALWAYS_INLINE size_t count_set(size_t begin, size_t end) const
+    {
+        HC_DASSERT(begin <= end && end <= BitsCount); // Invalid range!
+        return BitOperations::count_set(m_words, begin, end);
+    }
+
+    ALWAYS_INLINE bool is_any_set() const { return BitOperations::is_any_set(m_words, WordsCount); }
+
+    template<typename Function>
+    void for_each_set(const Function& function) const
+    {
+        for (size_t word_index = 0; word_index < WordsCount; ++word_index)
+        {
+            for (uint64_t word = m_words[word_index]; word != 0; word &= word - 1)
+            {
+                function(word_index * BitOperations::BitsPerWord + Math::count_trailing_zeros(word));
+            }
+        }
+    }
+
+public:
+    ALWAYS_INLINE void and_with(const FixedBitArray& other) { BitOperations::bitwise_and(m_words, other.m_words, WordsCount); }
+    ALWAYS_INLINE void or_with(const FixedBitArray& other) { BitOperations::bitwise_or(m_words, other.m_words, WordsCount); }
+    ALWAYS_INLINE void and_not_with(const FixedBitArray& other) { BitOperations::bitwise_and_not(m_words, other.m_words, WordsCount); }
+
+    /** @return True if all the bits set in the other array are also set in this one. */
+    bool contains_all(const FixedBitArray& other) const
+    {
+        for (size_t word_index = 0; word_index < WordsCount; ++word_index)
+        {
+            if ((m_words[word_index] & other.m_words[word_index]) != other.m_words[word_index])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** @return True if any bit set in the other array is also set in this one. */
+    bool contains_any(const FixedBitArray& other) const
+    {
+        for (size_t word_index = 0; word_index < WordsCount; ++word_index)
+        {
+            if ((m_words[word_index] & other.m_words[word_index]) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    ALWAYS_INLINE bool operator==(const FixedBitArray& other) const
+    {
+        for (size_t word_index = 0; word_index < WordsCount; ++word_index)
+        {
+            if (m_words[word_index] != other.m_words[word_index])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    uint64_t m_words[WordsCount] = {};
+};
+
+} // namespace HC
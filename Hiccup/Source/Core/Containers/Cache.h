@@ -0,0 +1,421 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Threading/Mutex.h"
+
+#include "IntrusiveList.h"
+#include "IntrusiveHashTable.h"
+
+namespace HC
+{
+
+enum class CacheEvictionPolicy : uint8_t
+{
+    // Evicts the least recently used entry. Every hit moves the entry to the end of the recency list.
+    LRU,
+
+    // Approximates LRU with a second-chance clock. A hit only sets the referenced flag of the
+    //   entry, so the hit path never touches the links of other entries.
+    Clock,
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Cache.
+ *----------------------------------------------------------------
+ * A bounded key-value cache. Each entry has a cost (bytes, for example), and inserting an entry
+ *   evicts the others, in the order given by the eviction policy, until the total cost fits the budget.
+ * The entries are indexed by an intrusive hash table and ordered by an intrusive list, so a hit
+ *   costs a single hash lookup and neither the lookup nor the eviction allocate memory.
+ * The cache is not thread safe - see 'ConcurrentCache'.
+ */
+template<typename KeyType, typename ValueType, CacheEvictionPolicy Policy = CacheEvictionPolicy::LRU,
+    typename Hasher = DefaultHasher, typename Comparator = DefaultComparator, typename AllocatorType = HeapAllocator>
+class Cache
+{
+public:
+    HC_NON_COPIABLE(Cache)
+    HC_NON_MOVABLE(Cache)
+
+private:
+    struct Entry
+    {
+        KeyType key;
+        ValueType value;
+        size_t cost;
+
+        // Only used by the clock policy.
+        bool is_referenced;
+
+        IntrusiveHashNode table_node;
+        IntrusiveListNode order_node;
+    };
+
+public:
+    explicit Cache(size_t budget = (size_t)-1)
+        : m_budget(budget)
+        , m_total_cost(0)
+        , m_clock_hand(nullptr)
+    {}
+
+    ~Cache()
+    {
+        clear();
+    }
+
+public:
+    ALWAYS_INLINE size_t size() const { return m_table.size(); }
+    ALWAYS_INLINE bool is_empty() const { return m_table.is_empty(); }
+    ALWAYS_INLINE size_t get_budget() const { return m_budget; }
+    ALWAYS_INLINE size_t get_total_cost() const { return m_total_cost; }
+
+    /** Changes the budget. Lowering it evicts entries right away. */
+    void set_budget(size_t budget)
+    {
+        m_budget = budget;
+        evict_over_budget(nullptr);
+    }
+
+public:
+    /** @return The cached value, or nullptr on a miss. A hit marks the entry as recently used. */
+    ValueType* find(const KeyType& key)
+    {
+        Entry* entry = m_table.find(key);
+        if (!entry)
+        {
+            return nullptr;
+        }
+
+        if (Policy == CacheEvictionPolicy::LRU)
+        {
+            m_order.move_to_back(entry);
+        }
+        else
+        {
+            entry->is_referenced = true;
+        }
+
+        return &entry->value;
+    }
+
+    /** @return The cached value, or nullptr on a miss. The entry isn't marked as recently used. */
+    ValueType* peek(const KeyType& key) const
+    {
+        Entry* entry = m_table.find(key);
+        return entry ? &entry->value : nullptr;
+    }
+
+    ALWAYS_INLINE bool contains(const KeyType& key) const
+    {
+        return m_table.contains(key);
+    }
+
+    /**
+     * Inserts (or replaces) an entry, then evicts the other entries until the total cost fits the budget.
+     * An entry whose cost alone exceeds the budget stays cached until the next eviction.
+     *
+     * @return Reference to the cached value. Valid until the entry is evicted or removed.
+     */
+    ValueType& insert(const KeyType& key, ValueType value, size_t cost = 1)
+    {
+        Entry* entry = m_table.find(key);
+        if (entry)
+        {
+            entry->value = Types::move(value);
+            m_total_cost = m_total_cost - entry->cost + cost;
+            entry->cost = cost;
+            if (Policy == CacheEvictionPolicy::LRU)
+            {
+                m_order.move_to_back(entry);
+            }
+            else
+            {
+                entry->is_referenced = true;
+            }
+        }
+        else
+        {
+            entry = (Entry*)m_allocator_instance.allocate_tagged_i(sizeof(Entry));
+            new (entry) Entry { key, Types::move(value), cost, false };
+            m_table.insert(entry);
+            m_total_cost += cost;
+
+            // New entries are placed right behind the clock hand, so they are inspected last.
+            if (Policy == CacheEvictionPolicy::Clock && m_clock_hand)
+            {
+                m_order.insert_before(m_clock_hand, entry);
+            }
+            else
+            {
+                m_order.push_back(entry);
+            }
+        }
+
+        evict_over_budget(entry);
+        return entry->value;
+    }
+
+    bool remove(const KeyType& key)
+    {
+        Entry* entry = m_table.find(key);
+        if (!entry)
+        {
+            return false;
+        }
+
+        destroy_entry(entry);
+        return true;
+    }
+
+    void clear()
+    {
+        while (!m_order.is_empty())
+        {
+            destroy_entry(m_order.front());
+        }
+    }
+
+    /**
+     * Iterates over the entries, in no particular order, without marking them as recently used.
+     *
+     * @param func A function of type bool(const KeyType&, ValueType&, size_t cost). If it returns false,
+     *   the iterating process will stop.
+     */
+    template<typename Func>
+    void for_each(Func func)
+    {
+        m_order.for_each([&func](Entry* entry) -> bool
+        {
+            return func(entry->key, entry->value, entry->cost);
+        });
+    }
+
+private:
+    // Evicts entries until the total cost fits the budget. The protected entry is never evicted.
+    void evict_over_budget(Entry* protected_entry)
+    {
+        while (m_total_cost > m_budget)
+        {
+            Entry* victim = (Policy == CacheEvictionPolicy::LRU) ? m_order.front() : advance_clock_hand(protected_entry);
+            if (!victim || victim == protected_entry)
+            {
+                break;
+            }
+            destroy_entry(victim);
+        }
+    }
+
+    // Gives every referenced entry a second chance, until an unreferenced one is found.
+    // Terminates, as each step either finds a victim or clears a flag.
+    Entry* advance_clock_hand(Entry* protected_entry)
+    {
+        if (m_order.is_empty() || (m_order.size() == 1 && m_order.front() == protected_entry))
+        {
+            return nullptr;
+        }
+
+        while (true)
+        {
+            if (!m_clock_hand)
+            {
+                m_clock_hand = m_order.front();
+            }
+
+            Entry* entry = m_clock_hand;
+            m_clock_hand = m_order.get_next(entry);
+
+            if (entry == protected_entry)
+            {
+                continue;
+            }
+
+            if (!entry->is_referenced)
+            {
+                return entry;
+            }
+            entry->is_referenced = false;
+        }
+    }
+
+    void destroy_entry(Entry* entry)
+    {
+        if (m_clock_hand == entry)
+        {
+            m_clock_hand = m_order.get_next(entry);
+        }
+
+        m_table.remove(entry);
+        m_order.remove(entry);
+        m_total_cost -= entry->cost;
+
+        entry->~Entry();
+        m_allocator_instance.free(entry, sizeof(Entry));
+    }
+
+private:
+    IntrusiveHashTable<Entry, KeyType, &Entry::key, &Entry::table_node, Hasher, Comparator, AllocatorType> m_table;
+
+    // LRU: from the least to the most recently used. Clock: the circular order inspected by the clock hand.
+    IntrusiveList<Entry, &Entry::order_node> m_order;
+
+    size_t m_budget;
+    size_t m_total_cost;
+
+    // The next entry inspected by the clock policy. Null means the front of the list.
+    Entry* m_clock_hand;
+
+    // The allocator instance used to allocate the entries.
+    AllocatorType m_allocator_instance;
+};
+
+template<typename KeyType, typename ValueType, typename Hasher = DefaultHasher, typename Comparator = DefaultComparator, typename AllocatorType = HeapAllocator>
+using LruCache = Cache<KeyType, ValueType, CacheEvictionPolicy::LRU, Hasher, Comparator, AllocatorType>;
+
+template<typename KeyType, typename ValueType, typename Hasher = DefaultHasher, typename Comparator = DefaultComparator, typename AllocatorType = HeapAllocator>
+using ClockCache = Cache<KeyType, ValueType, CacheEvictionPolicy::Clock, Hasher, Comparator, AllocatorType>;
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Concurrent Cache.
+ *----------------------------------------------------------------
+ * A thread safe cache, split into independently locked shards, so threads that access different
+ *   keys rarely contend. The budget is divided evenly between the shards, and each shard evicts on its own.
+ * As an entry can be evicted by another thread at any time, the values are returned by copy. Storing
+ *   reference counted values (for example 'RefPtr') keeps the copies cheap.
+ */
+template<typename KeyType, typename ValueType, CacheEvictionPolicy Policy = CacheEvictionPolicy::LRU, uint32_t ShardsCount = 16,
+    typename Hasher = DefaultHasher, typename Comparator = DefaultComparator, typename AllocatorType = HeapAllocator>
+class ConcurrentCache
+{
+public:
+    HC_NON_COPIABLE(ConcurrentCache)
+    HC_NON_MOVABLE(ConcurrentCache)
+
+    static_assert(ShardsCount > 0 && (ShardsCount & (ShardsCount - 1)) == 0, "The shards count must be a power of two!");
+
+private:
+    // Each shard has its own cache line(s), so the locks of different shards don't share lines.
+    struct alignas(CacheLineSize) Shard
+    {
+        Mutex lock;
+        Cache<KeyType, ValueType, Policy, Hasher, Comparator, AllocatorType> cache;
+    };
+
+public:
+    explicit ConcurrentCache(size_t budget = (size_t)-1)
+    {
+        set_budget(budget);
+    }
+
+public:
+    void set_budget(size_t budget)
+    {
+        for (uint32_t index = 0; index < ShardsCount; ++index)
+        {
+            ScopedLock<Mutex> lock(m_shards[index].lock);
+            m_shards[index].cache.set_budget((budget == (size_t)-1) ? budget : budget / ShardsCount);
+        }
+    }
+
+    /** Copies the cached value into 'out_value'. @return False on a miss, in which case 'out_value' is untouched. */
+    bool find(const KeyType& key, ValueType& out_value)
+    {
+        Shard& shard = get_shard(key);
+        ScopedLock<Mutex> lock(shard.lock);
+
+        ValueType* value = shard.cache.find(key);
+        if (!value)
+        {
+            return false;
+        }
+
+        out_value = *value;
+        return true;
+    }
+
+    bool contains(const KeyType& key)
+    {
+        Shard& shard = get_shard(key);
+        ScopedLock<Mutex> lock(shard.lock);
+        return shard.cache.contains(key);
+    }
+
+    void insert(const KeyType& key, ValueType value, size_t cost = 1)
+    {
+        Shard& shard = get_shard(key);
+        ScopedLock<Mutex> lock(shard.lock);
+        shard.cache.insert(key, Types::move(value), cost);
+    }
+
+    bool remove(const KeyType& key)
+    {
+        Shard& shard = get_shard(key);
+        ScopedLock<Mutex> lock(shard.lock);
+        return shard.cache.remove(key);
+    }
+
+    void clear()
+    {
+        for (uint32_t index = 0; index < ShardsCount; ++index)
+        {
+            ScopedLock<Mutex> lock(m_shards[index].lock);
+            m_shards[index].cache.clear();
+        }
+    }
+
+    /** The sum over all shards. Only a snapshot, as the shards are locked one at a time. */
+    size_t get_total_cost()
+    {
+        size_t total_cost = 0;
+        for (uint32_t index = 0; index < ShardsCount; ++index)
+        {
+            ScopedLock<Mutex> lock(m_shards[index].lock);
+            total_cost += m_shards[index].cache.get_total_cost();
+        }
+        return total_cost;
+    }
+
+    size_t size()
+    {
+        size_t count = 0;
+        for (uint32_t index = 0; index < ShardsCount; ++index)
+        {
+            ScopedLock<Mutex> lock(m_shards[index].lock);
+            count += m_shards[index].cache.size();
+        }
+        return count;
+    }
+
+private:
+    static constexpr uint32_t get_shards_bits_count()
+    {
+        uint32_t bits_count = 0;
+        while ((1u << bits_count) < ShardsCount)
+        {
+            ++bits_count;
+        }
+        return bits_count;
+    }
+
+    ALWAYS_INLINE Shard& get_shard(const KeyType& key)
+    {
+        // The shard is picked from the top bits of the mixed hash. The shard tables pick their buckets starting
+        //   from bit 32 (see 'get_hash_bucket_index'), so sharing those bits would leave most buckets unused.
+        if constexpr (ShardsCount == 1)
+        {
+            return m_shards[0];
+        }
+        else
+        {
+            return m_shards[mix_hash(Hasher::compute(key)) >> (64 - get_shards_bits_count())];
+        }
+    }
+
+private:
+    Shard m_shards[ShardsCount];
+};
+
+} // namespace HC
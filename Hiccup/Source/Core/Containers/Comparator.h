@@ -23,4 +23,20 @@ public:
 	}
 };
 
+/**
+ *----------------------------------------------------------------
+ * Hiccup Less Comparator.
+ *----------------------------------------------------------------
+ * Used, by default, by the sorting algorithms. Orders the elements ascending, using 'operator<'.
+ */
+class LessComparator
+{
+public:
+	template<typename T>
+	ALWAYS_INLINE static bool is_less(const T& a, const T& b)
+	{
+		return (a < b);
+	}
+};
+
 } // namespace HC
\ No newline at end of file
@@ -0,0 +1,321 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Memory/Memory.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Deque.
+ *----------------------------------------------------------------
+ * A double-ended queue, stored in a ring buffer whose capacity is always a power of two,
+ *   so wrapping an index is a single mask. Pushing and popping at both ends is amortized O(1),
+ *   and the elements are only moved when the buffer grows.
+ * Indexing is relative to the front: index 0 is the front, index 'size() - 1' is the back.
+ */
+template<typename T, typename AllocatorType = HeapAllocator>
+class Deque
+{
+public:
+    // The capacity of the first allocation.
+    static constexpr size_t MinCapacity = 8;
+
+public:
+    Deque()
+        : m_data(nullptr)
+        , m_capacity(0)
+        , m_head(0)
+        , m_size(0)
+    {}
+
+    Deque(const Deque<T, AllocatorType>& other)
+        : m_data(nullptr)
+        , m_capacity(0)
+        , m_head(0)
+        , m_size(0)
+    {
+        copy_from(other);
+    }
+
+    Deque(Deque<T, AllocatorType>&& other) noexcept
+        : m_data(other.m_data)
+        , m_capacity(other.m_capacity)
+        , m_head(other.m_head)
+        , m_size(other.m_size)
+    {
+        other.m_data = nullptr;
+        other.m_capacity = 0;
+        other.m_head = 0;
+        other.m_size = 0;
+    }
+
+    ~Deque()
+    {
+        clear();
+        release_memory();
+    }
+
+    Deque<T, AllocatorType>& operator=(const Deque<T, AllocatorType>& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    Deque<T, AllocatorType>& operator=(Deque<T, AllocatorType>&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            release_memory();
+
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            m_head = other.m_head;
+            m_size = other.m_size;
+
+            other.m_data = nullptr;
+            other.m_capacity = 0;
+            other.m_head = 0;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+public:
+    ALWAYS_INLINE size_t size() const { return m_size; }
+    ALWAYS_INLINE size_t capacity() const { return m_capacity; }
+    ALWAYS_INLINE bool is_empty() const { return (m_size == 0); }
+
+public:
+    ALWAYS_INLINE T& operator[](size_t index)
+    {
+        HC_ASSERT(index < m_size); // Index out of range!
+        return m_data[wrap(m_head + index)];
+    }
+
+    ALWAYS_INLINE const T& operator[](size_t index) const
+    {
+        HC_ASSERT(index < m_size); // Index out of range!
+        return m_data[wrap(m_head + index)];
+    }
+
+    ALWAYS_INLINE T& front()
+    {
+        HC_ASSERT(m_size > 0); // The deque is empty!
+        return m_data[m_head];
+    }
+
+    ALWAYS_INLINE const T& front() const
+    {
+        HC_ASSERT(m_size > 0); // The deque is empty!
+        return m_data[m_head];
+    }
+
+    ALWAYS_INLINE T& back()
+    {
+        HC_ASSERT(m_size > 0); // The deque is empty!
+        return m_data[wrap(m_head + m_size - 1)];
+    }
+
+    ALWAYS_INLINE const T& back() const
+    {
+        HC_ASSERT(m_size > 0); // The deque is empty!
+        return m_data[wrap(m_head + m_size - 1)];
+    }
+
+public:
+    T& push_back(const T& element)
+    {
+        T* slot = reserve_back();
+        new (slot) T(element);
+        return *slot;
+    }
+
+    T& push_back(T&& element)
+    {
+        T* slot = reserve_back();
+        new (slot) T(Types::move(element));
+        return *slot;
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        T* slot = reserve_back();
+        new (slot) T(Types::forward<Args>(args)...);
+        return *slot;
+    }
+
+    T& push_front(const T& element)
+    {
+        T* slot = reserve_front();
+        new (slot) T(element);
+        return *slot;
+    }
+
+    T& push_front(T&& element)
+    {
+        T* slot = reserve_front();
+        new (slot) T(Types::move(element));
+        return *slot;
+    }
+
+    template<typename... Args>
+    T& emplace_front(Args&&... args)
+    {
+        T* slot = reserve_front();
+        new (slot) T(Types::forward<Args>(args)...);
+        return *slot;
+    }
+
+    void pop_back()
+    {
+        HC_ASSERT(m_size > 0); // Trying to pop from an empty deque!
+        m_data[wrap(m_head + m_size - 1)].~T();
+        --m_size;
+    }
+
+    void pop_front()
+    {
+        HC_ASSERT(m_size > 0); // Trying to pop from an empty deque!
+        m_data[m_head].~T();
+        m_head = wrap(m_head + 1);
+        --m_size;
+    }
+
+    /** Moves the front element out of the deque and removes it. */
+    T take_front()
+    {
+        T element = Types::move(front());
+        pop_front();
+        return element;
+    }
+
+    /** Moves the back element out of the deque and removes it. */
+    T take_back()
+    {
+        T element = Types::move(back());
+        pop_back();
+        return element;
+    }
+
+public:
+    void clear()
+    {
+        for (size_t index = 0; index < m_size; ++index)
+        {
+            m_data[wrap(m_head + index)].~T();
+        }
+        m_head = 0;
+        m_size = 0;
+    }
+
+    /** Grows the buffer, so it can store at least the given number of elements without reallocating. */
+    void reserve(size_t min_capacity)
+    {
+        if (min_capacity <= m_capacity)
+        {
+            return;
+        }
+
+        size_t new_capacity = (m_capacity > 0) ? m_capacity : MinCapacity;
+        while (new_capacity < min_capacity)
+        {
+            new_capacity *= 2;
+        }
+        re_allocate(new_capacity);
+    }
+
+private:
+    ALWAYS_INLINE size_t wrap(size_t index) const
+    {
+        return index & (m_capacity - 1);
+    }
+
+    T* reserve_back()
+    {
+        if (m_size == m_capacity)
+        {
+            re_allocate((m_capacity > 0) ? m_capacity * 2 : MinCapacity);
+        }
+
+        T* slot = m_data + wrap(m_head + m_size);
+        ++m_size;
+        return slot;
+    }
+
+    T* reserve_front()
+    {
+        if (m_size == m_capacity)
+        {
+            re_allocate((m_capacity > 0) ? m_capacity * 2 : MinCapacity);
+        }
+
+        m_head = wrap(m_head + m_capacity - 1);
+        ++m_size;
+        return m_data + m_head;
+    }
+
+    // Moves the elements to a new buffer, unwrapping them so the front is at index 0.
+    void re_allocate(size_t new_capacity)
+    {
+        T* new_data = (T*)m_allocator_instance.allocate_tagged_i(new_capacity * sizeof(T));
+
+        for (size_t index = 0; index < m_size; ++index)
+        {
+            T& element = m_data[wrap(m_head + index)];
+            new (new_data + index) T(Types::move(element));
+            element.~T();
+        }
+
+        release_memory();
+
+        m_data = new_data;
+        m_capacity = new_capacity;
+        m_head = 0;
+    }
+
+    void copy_from(const Deque<T, AllocatorType>& other)
+    {
+        reserve(other.m_size);
+        for (size_t index = 0; index < other.m_size; ++index)
+        {
+            new (m_data + index) T(other[index]);
+        }
+        m_head = 0;
+        m_size = other.m_size;
+    }
+
+    void release_memory()
+    {
+        m_allocator_instance.free(m_data, m_capacity * sizeof(T));
+        m_data = nullptr;
+        m_capacity = 0;
+    }
+
+private:
+    // Pointer to the ring buffer.
+    T* m_data;
+
+    // The capacity (in elements) of the ring buffer. Always zero or a power of two.
+    size_t m_capacity;
+
+    // The index (in the ring buffer) of the front element.
+    size_t m_head;
+
+    // The number of elements stored in the deque.
+    size_t m_size;
+
+    // The allocator instance used to perform all memory allocations/deallocations.
+    AllocatorType m_allocator_instance;
+};
+
+} // namespace HC
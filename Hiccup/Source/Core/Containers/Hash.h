@@ -72,6 +72,25 @@ ALWAYS_INLINE uint64_t compute_hash(void* const& value)
 	return compute_hash((const void*)value);
 }
 
+/**
+ * Scrambles a hash before some of its bits are used to pick a bucket or a slot.
+ * Identity-like hashes (such as the ones of integers) would otherwise put all keys that differ only
+ *   in the unused bits in the same bucket.
+ */
+ALWAYS_INLINE uint64_t mix_hash(uint64_t hash)
+{
+	return hash * 0x9E3779B97F4A7C15ull;
+}
+
+/**
+ * Reduces a hash to a bucket index, where the buckets count is a power of two and 'mask' is the
+ *   buckets count minus one. The index is taken from the mixed bits starting at bit 32.
+ */
+ALWAYS_INLINE uint64_t get_hash_bucket_index(uint64_t hash, uint64_t mask)
+{
+	return (mix_hash(hash) >> 32) & mask;
+}
+
 /**
  *----------------------------------------------------------------
  * Hiccup Default Hasher.
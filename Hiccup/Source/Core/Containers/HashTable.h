@@ -85,6 +85,9 @@ public:
 	/** @return The load factor of the table. */
 	ALWAYS_INLINE float64_t get_load_factor() const;
 
+	/** @return The number of elements stored in the table. */
+	ALWAYS_INLINE size_t size() const { return m_size; }
+
 public:
 	/**
 	 * Gets the value associated with the given key.
@@ -322,6 +325,9 @@ private:
 	// Finds the index where the given key is stored, or the first unoccupied index if it doesn't exist.
 	size_t find_index_of_first_unoccupied(const KeyType& key) const;
 
+	// Finds the bucket where a new key is inserted. When asserts are enabled, also checks that the key isn't already in the table.
+	ALWAYS_INLINE size_t find_insert_index(const KeyType& key) const;
+
 	// Inserts an element in the table.
 	size_t internal_insert(const KeyType& key, const ValueType& value);
 
@@ -576,11 +582,11 @@ size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::find(co
 	{
 		return EndOfTable;
 	}
-	size_t index = Hasher::compute<KeyType>(key) % m_capacity;
+	size_t index = Hasher::template compute<KeyType>(key) % m_capacity;
 
 	for (size_t i = 0; i < m_capacity; ++i)
 	{
-		if (m_states[index] == BucketState::Occupied && Comparator::compare<KeyType>(key, m_key_values[index].key))
+		if (m_states[index] == BucketState::Occupied && Comparator::template compare<KeyType>(key, m_key_values[index].key))
 		{
 			return index;
 		}
@@ -598,11 +604,11 @@ size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::find(co
 template<typename KeyType, typename ValueType, typename AllocatorType, typename Hasher, typename Comparator>
 size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::find_existing_index(const KeyType& key) const
 {
-	size_t index = Hasher::compute<KeyType>(key) % m_capacity;
+	size_t index = Hasher::template compute<KeyType>(key) % m_capacity;
 
 	while (true)
 	{
-		if (m_states[index] == BucketState::Occupied && Comparator::compare<KeyType>(key, m_key_values[index].key))
+		if (m_states[index] == BucketState::Occupied && Comparator::template compare<KeyType>(key, m_key_values[index].key))
 		{
 			return index;
 		}
@@ -631,22 +637,13 @@ ValueType& HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::ins
 		re_allocate(calculate_growth());
 	}
 
-#if HC_ENABLE_ASSERTS
-
-	const size_t index = find_index_of_first_unoccupied(key);
-	HC_ASSERT(m_states[index] != BucketState::Occupied); // Key already exists in the table!
+	const size_t index = find_insert_index(key);
 
 	new (&m_key_values[index].key)   KeyType  (key);
 	new (&m_key_values[index].value) ValueType(value);
 	m_states[index] = BucketState::Occupied;
 	m_size++;
 
-#else
-
-	const size_t index = internal_insert(key, value);
-
-#endif // HC_ENABLE_ASSERTS
-
 	return m_key_values[index].value;
 }
 
@@ -658,22 +655,13 @@ ValueType& HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::ins
 		re_allocate(calculate_growth());
 	}
 
-#if HC_ENABLE_ASSERTS
-
-	const size_t index = find_index_of_first_unoccupied(key);
-	HC_ASSERT(m_states[index] != BucketState::Occupied); // Key already exists in the table!
+	const size_t index = find_insert_index(key);
 
 	new (&m_key_values[index].key)   KeyType(key);
 	new (&m_key_values[index].value) ValueType(Types::move(value));
 	m_states[index] = BucketState::Occupied;
 	m_size++;
 
-#else
-
-	const size_t index = internal_insert(key, Types::move(value));
-
-#endif // HC_ENABLE_ASSERTS
-
 	return m_key_values[index].value;
 }
 
@@ -685,22 +673,13 @@ ValueType& HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::ins
 		re_allocate(calculate_growth());
 	}
 
-#if HC_ENABLE_ASSERTS
-
-	const size_t index = find_index_of_first_unoccupied(key);
-	HC_ASSERT(m_states[index] != BucketState::Occupied); // Key already exists in the table!
+	const size_t index = find_insert_index(key);
 
 	new (&m_key_values[index].key)   KeyType(Types::move(key));
 	new (&m_key_values[index].value) ValueType(value);
 	m_states[index] = BucketState::Occupied;
 	m_size++;
 
-#else
-
-	const size_t index = internal_insert(Types::move(key), value);
-
-#endif // HC_ENABLE_ASSERTS
-
 	return m_key_values[index].value;
 }
 
@@ -712,22 +691,13 @@ ValueType& HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::ins
 		re_allocate(calculate_growth());
 	}
 
-#if HC_ENABLE_ASSERTS
-
-	const size_t index = find_index_of_first_unoccupied(key);
-	HC_ASSERT(m_states[index] != BucketState::Occupied); // Key already exists in the table!
+	const size_t index = find_insert_index(key);
 
 	new (&m_key_values[index].key)   KeyType(Types::move(key));
 	new (&m_key_values[index].value) ValueType(Types::move(value));
 	m_states[index] = BucketState::Occupied;
 	m_size++;
 
-#else
-
-	const size_t index = internal_insert(Types::move(key), Types::move(value));
-
-#endif // HC_ENABLE_ASSERTS
-
 	return m_key_values[index].value;
 }
 
@@ -824,7 +794,7 @@ ALWAYS_INLINE void HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparat
 template<typename KeyType, typename ValueType, typename AllocatorType, typename Hasher, typename Comparator>
 ALWAYS_INLINE bool HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::is_over_load_factor() const
 {
-	return (m_capacity == 0) || (get_load_factor() >= MaxLoadFactor);
+	return HC_UNLIKELY((m_capacity == 0) || (get_load_factor() >= MaxLoadFactor));
 }
 
 template<typename KeyType, typename ValueType, typename AllocatorType, typename Hasher, typename Comparator>
@@ -897,11 +867,11 @@ void HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::re_alloca
 
 
 	m_key_values = (KeyValue*)new_data;
-	m_states = (BucketState*)(new_key_values + newCapacity);
+	m_states = (BucketState*)(m_key_values + newCapacity);
 	m_capacity = newCapacity;
 	m_size = 0;
 
-	Memory::set(m_States, BucketState::Empty, m_Capacity * sizeof(BucketState));
+	Memory::set(m_states, (uint8_t)BucketState::Empty, m_capacity * sizeof(BucketState));
 }
 
 template<typename KeyType, typename ValueType, typename AllocatorType, typename Hasher, typename Comparator>
@@ -921,14 +891,14 @@ size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::find_fi
 template<typename KeyType, typename ValueType, typename AllocatorType, typename Hasher, typename Comparator>
 size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::find_index_of_first_unoccupied(const KeyType& key) const
 {
-	size_t index = Hasher::compute<KeyType>(key) % m_capacity;
+	size_t index = Hasher::template compute<KeyType>(key) % m_capacity;
 	size_t firstIndex = static_cast<size_t>(-1);
 
 	for (size_t i = 0; i < m_capacity; ++i)
 	{
 		if (m_states[index] == BucketState::Occupied)
 		{
-			if (Comparator::compare<KeyType>(key, m_key_values[index].key))
+			if (Comparator::template compare<KeyType>(key, m_key_values[index].key))
 			{
 				return index;
 			}
@@ -955,10 +925,23 @@ size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::find_in
 	return firstIndex;
 }
 
+template<typename KeyType, typename ValueType, typename AllocatorType, typename Hasher, typename Comparator>
+ALWAYS_INLINE size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::find_insert_index(const KeyType& key) const
+{
+#if HC_ENABLE_ASSERTS
+	// Probing with the key stops at an existing entry, so duplicates are caught without a second lookup.
+	const size_t index = find_index_of_first_unoccupied(key);
+	HC_ASSERT(m_states[index] != BucketState::Occupied); // Key already exists in the table!
+	return index;
+#else
+	return find_first_unoccupied_index(Hasher::template compute<KeyType>(key) % m_capacity);
+#endif // HC_ENABLE_ASSERTS
+}
+
 template<typename KeyType, typename ValueType, typename AllocatorType, typename Hasher, typename Comparator>
 size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::internal_insert(const KeyType& key, const ValueType& value)
 {
-	const size_t index = find_first_unoccupied_index(Hasher::compute<KeyType>(key) % m_capacity);
+	const size_t index = find_first_unoccupied_index(Hasher::template compute<KeyType>(key) % m_capacity);
 
 	new (&m_key_values[index].key)   KeyType  (key);
 	new (&m_key_values[index].value) ValueType(value);
@@ -971,7 +954,7 @@ size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::interna
 template<typename KeyType, typename ValueType, typename AllocatorType, typename Hasher, typename Comparator>
 size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::internal_insert(const KeyType& key, ValueType&& value)
 {
-	const size_t index = find_first_unoccupied_index(Hasher::compute<KeyType>(key) % m_capacity);
+	const size_t index = find_first_unoccupied_index(Hasher::template compute<KeyType>(key) % m_capacity);
 
 	new (&m_key_values[index].key)   KeyType  (key);
 	new (&m_key_values[index].value) ValueType(Types::move(value));
@@ -984,7 +967,7 @@ size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::interna
 template<typename KeyType, typename ValueType, typename AllocatorType, typename Hasher, typename Comparator>
 size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::internal_insert(KeyType&& key, const ValueType& value)
 {
-	const size_t index = find_first_unoccupied_index(Hasher::compute<KeyType>(key) % m_capacity);
+	const size_t index = find_first_unoccupied_index(Hasher::template compute<KeyType>(key) % m_capacity);
 
 	new (&m_key_values[index].key)   KeyType  (Types::move(key));
 	new (&m_key_values[index].value) ValueType(value);
@@ -997,7 +980,7 @@ size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::interna
 template<typename KeyType, typename ValueType, typename AllocatorType, typename Hasher, typename Comparator>
 size_t HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>::internal_insert(KeyType&& key, ValueType&& value)
 {
-	const size_t index = find_first_unoccupied_index(Hasher::compute<KeyType>(key) % m_capacity);
+	const size_t index = find_first_unoccupied_index(Hasher::template compute<KeyType>(key) % m_capacity);
 
 	new (&m_key_values[index].key)   KeyType  (Types::move(key));
 	new (&m_key_values[index].value) ValueType(Types::move(value));
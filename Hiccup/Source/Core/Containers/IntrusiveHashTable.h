@@ -0,0 +1,280 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Memory/Memory.h"
+
+#include "Hash.h"
+#include "Comparator.h"
+#include "IntrusiveList.h"
+
+namespace HC
+{
+
+/**
+ * The links of an object that is a member of an 'IntrusiveHashTable'.
+ * The hash of the key is cached in the node, so growing the table never reads the keys, and
+ *   most mismatches in a bucket are rejected without comparing the keys.
+ */
+struct IntrusiveHashNode
+{
+public:
+    HC_NON_COPIABLE(IntrusiveHashNode)
+    HC_NON_MOVABLE(IntrusiveHashNode)
+
+    IntrusiveHashNode() = default;
+
+    ALWAYS_INLINE bool is_linked() const { return (previous_next != nullptr); }
+
+public:
+    IntrusiveHashNode* next = nullptr;
+
+    // Points to the link that points to this node (either a bucket or the 'next' of the previous node),
+    //   so a node can be unlinked in O(1) from a singly linked bucket chain.
+    IntrusiveHashNode** previous_next = nullptr;
+
+    uint64_t hash = 0;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Intrusive Hash Table.
+ *----------------------------------------------------------------
+ * A chained hash table of objects that it doesn't own. The key and the chain links live inside
+ *   the objects, so inserting and removing an object never allocate memory - only the bucket
+ *   array is reallocated, when the number of elements exceeds the number of buckets.
+ * The keys must be unique, and must not be modified while the object is linked.
+ *
+ * Usage: 'IntrusiveHashTable<Asset, uint64_t, &Asset::m_path_hash, &Asset::m_table_node> assets;'
+ */
+template<typename T, typename KeyType, KeyType T::*KeyMember, IntrusiveHashNode T::*NodeMember,
+    typename Hasher = DefaultHasher, typename Comparator = DefaultComparator, typename AllocatorType = HeapAllocator>
+class IntrusiveHashTable
+{
+public:
+    HC_NON_COPIABLE(IntrusiveHashTable)
+    HC_NON_MOVABLE(IntrusiveHashTable)
+
+    using Member = IntrusiveMember<T, IntrusiveHashNode, NodeMember>;
+
+    // The number of buckets allocated by the first insertion. The buckets count is always a power of two.
+    static constexpr size_t MinBucketsCount = 16;
+
+public:
+    IntrusiveHashTable()
+        : m_buckets(nullptr)
+        , m_buckets_count(0)
+        , m_count(0)
+    {}
+
+    ~IntrusiveHashTable()
+    {
+        clear();
+        m_allocator_instance.free(m_buckets, m_buckets_count * sizeof(IntrusiveHashNode*));
+    }
+
+public:
+    ALWAYS_INLINE size_t size() const { return m_count; }
+    ALWAYS_INLINE bool is_empty() const { return (m_count == 0); }
+    ALWAYS_INLINE size_t get_buckets_count() const { return m_buckets_count; }
+
+    /** @return The element with the given key, or nullptr if there is none. */
+    T* find(const KeyType& key) const
+    {
+        if (m_count == 0)
+        {
+            return nullptr;
+        }
+
+        const uint64_t hash = Hasher::compute(key);
+        for (IntrusiveHashNode* node = m_buckets[get_bucket_index(hash)]; node; node = node->next)
+        {
+            if (node->hash == hash)
+            {
+                T* element = Member::get_owner(node);
+                if (Comparator::compare(element->*KeyMember, key))
+                {
+                    return element;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    ALWAYS_INLINE bool contains(const KeyType& key) const
+    {
+        return (find(key) != nullptr);
+    }
+
+public:
+    /**
+     * Links the element into the table, under the key stored in it.
+     *
+     * @return False if an element with the same key is already linked. The element is not linked in that case.
+     */
+    bool insert(T* element)
+    {
+        IntrusiveHashNode* node = Member::get_node(element);
+        HC_DASSERT(!node->is_linked()); // The element is already a member of a table!
+
+        if (find(element->*KeyMember))
+        {
+            return false;
+        }
+
+        if (m_count + 1 > m_buckets_count)
+        {
+            re_allocate(Math::max<size_t>(m_buckets_count * 2, MinBucketsCount));
+        }
+
+        node->hash = Hasher::compute(element->*KeyMember);
+        link(node);
+        ++m_count;
+        return true;
+    }
+
+    /** Unlinks the element, which must be a member of this table. */
+    void remove(T* element)
+    {
+        IntrusiveHashNode* node = Member::get_node(element);
+        HC_DASSERT(node->is_linked()); // The element isn't a member of a table!
+
+        *node->previous_next = node->next;
+        if (node->next)
+        {
+            node->next->previous_next = node->previous_next;
+        }
+
+        node->next = nullptr;
+        node->previous_next = nullptr;
+        --m_count;
+    }
+
+    /** Unlinks the element with the given key, if there is one. @return The unlinked element, or nullptr. */
+    T* remove_key(const KeyType& key)
+    {
+        T* element = find(key);
+        if (element)
+        {
+            remove(element);
+        }
+        return element;
+    }
+
+    /** Unlinks all the elements. The bucket array is kept. */
+    void clear()
+    {
+        for (size_t bucket = 0; bucket < m_buckets_count; ++bucket)
+        {
+            IntrusiveHashNode* node = m_buckets[bucket];
+            while (node)
+            {
+                IntrusiveHashNode* next = node->next;
+                node->next = nullptr;
+                node->previous_next = nullptr;
+                node = next;
+            }
+            m_buckets[bucket] = nullptr;
+        }
+        m_count = 0;
+    }
+
+    /** Allocates enough buckets for the given number of elements, so inserting them doesn't reallocate. */
+    void reserve(size_t elements_count)
+    {
+        size_t buckets_count = Math::max<size_t>(m_buckets_count, MinBucketsCount);
+        while (buckets_count < elements_count)
+        {
+            buckets_count *= 2;
+        }
+
+        if (buckets_count != m_buckets_count)
+        {
+            re_allocate(buckets_count);
+        }
+    }
+
+    /**
+     * Iterates over all the elements, in no particular order.
+     * The current element can be removed (or destroyed) by the function.
+     *
+     * @param func A function of type bool(T*). If it returns false, the iterating process will stop.
+     */
+    template<typename Func>
+    void for_each(Func func) const
+    {
+        for (size_t bucket = 0; bucket < m_buckets_count; ++bucket)
+        {
+            IntrusiveHashNode* node = m_buckets[bucket];
+            while (node)
+            {
+                IntrusiveHashNode* next = node->next;
+                if (!func(Member::get_owner(node)))
+                {
+                    return;
+                }
+                node = next;
+            }
+        }
+    }
+
+private:
+    ALWAYS_INLINE size_t get_bucket_index(uint64_t hash) const
+    {
+        return (size_t)get_hash_bucket_index(hash, m_buckets_count - 1);
+    }
+
+    ALWAYS_INLINE void link(IntrusiveHashNode* node)
+    {
+        IntrusiveHashNode** bucket = m_buckets + get_bucket_index(node->hash);
+
+        node->next = *bucket;
+        if (node->next)
+        {
+            node->next->previous_next = &node->next;
+        }
+        node->previous_next = bucket;
+        *bucket = node;
+    }
+
+    // Relinks all the nodes into a new bucket array. The cached hashes are used, so no key is read.
+    void re_allocate(size_t new_buckets_count)
+    {
+        IntrusiveHashNode** old_buckets = m_buckets;
+        const size_t old_buckets_count = m_buckets_count;
+
+        m_buckets = (IntrusiveHashNode**)m_allocator_instance.allocate_tagged_i(new_buckets_count * sizeof(IntrusiveHashNode*));
+        m_buckets_count = new_buckets_count;
+        Memory::zero(m_buckets, new_buckets_count * sizeof(IntrusiveHashNode*));
+
+        for (size_t bucket = 0; bucket < old_buckets_count; ++bucket)
+        {
+            IntrusiveHashNode* node = old_buckets[bucket];
+            while (node)
+            {
+                IntrusiveHashNode* next = node->next;
+                link(node);
+                node = next;
+            }
+        }
+
+        m_allocator_instance.free(old_buckets, old_buckets_count * sizeof(IntrusiveHashNode*));
+    }
+
+private:
+    // The heads of the bucket chains.
+    IntrusiveHashNode** m_buckets;
+
+    // The number of buckets. Always zero or a power of two.
+    size_t m_buckets_count;
+
+    // The number of linked elements.
+    size_t m_count;
+
+    // The allocator instance used to allocate the bucket array.
+    AllocatorType m_allocator_instance;
+};
+
+} // namespace HC
@@ -0,0 +1,245 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+
+namespace HC
+{
+
+/**
+ * Converts between an object and the intrusive node embedded in it, given the pointer to the node member.
+ * Shared by all the intrusive containers.
+ */
+template<typename T, typename NodeType, NodeType T::*NodeMember>
+struct IntrusiveMember
+{
+    ALWAYS_INLINE static NodeType* get_node(T* owner)
+    {
+        return &(owner->*NodeMember);
+    }
+
+    ALWAYS_INLINE static T* get_owner(NodeType* node)
+    {
+        // The offset is computed from a dummy, non-null address, the same way 'offsetof' does it.
+        T* dummy = (T*)(uintptr_t)alignof(T);
+        const size_t offset = (size_t)((uint8_t*)&(dummy->*NodeMember) - (uint8_t*)dummy);
+        return (T*)((uint8_t*)node - offset);
+    }
+};
+
+/**
+ * The links of an object that is a member of an 'IntrusiveList'.
+ * A node can be a member of a single list at a time. An object that must be a member of multiple
+ *   lists at the same time declares one node for each of them.
+ */
+struct IntrusiveListNode
+{
+public:
+    HC_NON_COPIABLE(IntrusiveListNode)
+    HC_NON_MOVABLE(IntrusiveListNode)
+
+    IntrusiveListNode() = default;
+
+    ALWAYS_INLINE bool is_linked() const { return (next != nullptr); }
+
+public:
+    IntrusiveListNode* previous = nullptr;
+    IntrusiveListNode* next = nullptr;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Intrusive List.
+ *----------------------------------------------------------------
+ * A doubly linked list of objects that it doesn't own. The links live inside the objects
+ *   ('IntrusiveListNode' members), so linking and unlinking never allocate memory, and an object
+ *   can be unlinked in O(1) without searching for it.
+ * The list is circular around a sentinel node stored in the list itself, so it can't be copied or moved.
+ *
+ * Usage: 'IntrusiveList<Window, &Window::m_active_node> active_windows;'
+ */
+template<typename T, IntrusiveListNode T::*NodeMember>
+class IntrusiveList
+{
+public:
+    HC_NON_COPIABLE(IntrusiveList)
+    HC_NON_MOVABLE(IntrusiveList)
+
+    using Member = IntrusiveMember<T, IntrusiveListNode, NodeMember>;
+
+public:
+    IntrusiveList()
+        : m_count(0)
+    {
+        m_sentinel.previous = &m_sentinel;
+        m_sentinel.next = &m_sentinel;
+    }
+
+    ~IntrusiveList()
+    {
+        clear();
+    }
+
+public:
+    ALWAYS_INLINE size_t size() const { return m_count; }
+    ALWAYS_INLINE bool is_empty() const { return (m_count == 0); }
+
+    /** @return The first element, or nullptr if the list is empty. */
+    ALWAYS_INLINE T* front() const { return to_owner(m_sentinel.next); }
+
+    /** @return The last element, or nullptr if the list is empty. */
+    ALWAYS_INLINE T* back() const { return to_owner(m_sentinel.previous); }
+
+    /** @return The element after the given one, or nullptr if it is the last. */
+    ALWAYS_INLINE T* get_next(T* element) const
+    {
+        HC_DASSERT(Member::get_node(element)->is_linked()); // The element isn't linked!
+        return to_owner(Member::get_node(element)->next);
+    }
+
+    /** @return The element before the given one, or nullptr if it is the first. */
+    ALWAYS_INLINE T* get_previous(T* element) const
+    {
+        HC_DASSERT(Member::get_node(element)->is_linked()); // The element isn't linked!
+        return to_owner(Member::get_node(element)->previous);
+    }
+
+public:
+    ALWAYS_INLINE void push_back(T* element)
+    {
+        link_before(&m_sentinel, Member::get_node(element));
+    }
+
+    ALWAYS_INLINE void push_front(T* element)
+    {
+        link_before(m_sentinel.next, Member::get_node(element));
+    }
+
+    /** Links the element right before 'position', which must be a member of this list. */
+    ALWAYS_INLINE void insert_before(T* position, T* element)
+    {
+        link_before(Member::get_node(position), Member::get_node(element));
+    }
+
+    /** Links the element right after 'position', which must be a member of this list. */
+    ALWAYS_INLINE void insert_after(T* position, T* element)
+    {
+        link_before(Member::get_node(position)->next, Member::get_node(element));
+    }
+
+    /** Unlinks the element, which must be a member of this list. */
+    ALWAYS_INLINE void remove(T* element)
+    {
+        unlink(Member::get_node(element));
+    }
+
+    /** Moves an element of this list to its end. Used to mark an element as the most recently used. */
+    ALWAYS_INLINE void move_to_back(T* element)
+    {
+        IntrusiveListNode* node = Member::get_node(element);
+        unlink(node);
+        link_before(&m_sentinel, node);
+    }
+
+    /** Unlinks and returns the first element, or nullptr if the list is empty. */
+    T* pop_front()
+    {
+        if (m_count == 0)
+        {
+            return nullptr;
+        }
+
+        IntrusiveListNode* node = m_sentinel.next;
+        unlink(node);
+        return Member::get_owner(node);
+    }
+
+    /** Unlinks and returns the last element, or nullptr if the list is empty. */
+    T* pop_back()
+    {
+        if (m_count == 0)
+        {
+            return nullptr;
+        }
+
+        IntrusiveListNode* node = m_sentinel.previous;
+        unlink(node);
+        return Member::get_owner(node);
+    }
+
+    /** Unlinks all the elements. The elements themselves are not touched otherwise. */
+    void clear()
+    {
+        IntrusiveListNode* node = m_sentinel.next;
+        while (node != &m_sentinel)
+        {
+            IntrusiveListNode* next = node->next;
+            node->previous = nullptr;
+            node->next = nullptr;
+            node = next;
+        }
+
+        m_sentinel.previous = &m_sentinel;
+        m_sentinel.next = &m_sentinel;
+        m_count = 0;
+    }
+
+    /**
+     * Iterates over the elements, from the front to the back.
+     * The current element can be unlinked (or destroyed) by the function.
+     *
+     * @param func A function of type bool(T*). If it returns false, the iterating process will stop.
+     */
+    template<typename Func>
+    void for_each(Func func) const
+    {
+        IntrusiveListNode* node = m_sentinel.next;
+        while (node != &m_sentinel)
+        {
+            IntrusiveListNode* next = node->next;
+            if (!func(Member::get_owner(node)))
+            {
+                return;
+            }
+            node = next;
+        }
+    }
+
+private:
+    ALWAYS_INLINE T* to_owner(IntrusiveListNode* node) const
+    {
+        return (node != &m_sentinel) ? Member::get_owner(node) : nullptr;
+    }
+
+    ALWAYS_INLINE void link_before(IntrusiveListNode* position, IntrusiveListNode* node)
+    {
+        HC_DASSERT(!node->is_linked()); // The element is already a member of a list!
+
+        node->previous = position->previous;
+        node->next = position;
+        position->previous->next = node;
+        position->previous = node;
+        ++m_count;
+    }
+
+    ALWAYS_INLINE void unlink(IntrusiveListNode* node)
+    {
+        HC_DASSERT(node->is_linked() && node != &m_sentinel); // The element isn't a member of a list!
+
+        node->previous->next = node->next;
+        node->next->previous = node->previous;
+        node->previous = nullptr;
+        node->next = nullptr;
+        --m_count;
+    }
+
+private:
+    // The list is circular around this node. Mutable, so the const functions can hand out its neighbours.
+    mutable IntrusiveListNode m_sentinel;
+
+    // The number of linked elements.
+    size_t m_count;
+};
+
+} // namespace HC
@@ -0,0 +1,271 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Memory/Memory.h"
+
+#include "Array.h"
+#include "Comparator.h"
+
+namespace HC
+{
+
+// Identifies an element of a priority queue, for as long as the element is in the queue.
+// After the element is popped or removed, the handle is recycled by the next push.
+using PriorityQueueHandle = uint32_t;
+
+static constexpr PriorityQueueHandle InvalidPriorityQueueHandle = 0xFFFFFFFF;
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Priority Queue.
+ *----------------------------------------------------------------
+ * A d-ary heap (4-ary, by default) stored contiguously in an array. A wider heap is shallower, so
+ *   sifting touches fewer cache lines than with a binary heap, and the children of a node are adjacent.
+ * The top element is the one that is ordered first by the comparator ('LessComparator' produces a min-heap).
+ * Every push returns a handle, that can be used to change the priority of the element (decrease-key)
+ *   or to remove it from the queue, in O(log n).
+ */
+template<typename T, typename Comparator = LessComparator, typename AllocatorType = HeapAllocator, uint32_t Arity = 4>
+class PriorityQueue
+{
+public:
+    static_assert(Arity >= 2, "The heap arity must be at least 2!");
+
+    // The heap position of a handle that is not in use.
+    static constexpr uint32_t InvalidPosition = 0xFFFFFFFF;
+
+private:
+    struct Node
+    {
+        T value;
+        PriorityQueueHandle handle;
+    };
+
+public:
+    ALWAYS_INLINE size_t size() const { return m_heap.size(); }
+    ALWAYS_INLINE bool is_empty() const { return m_heap.is_empty(); }
+
+    ALWAYS_INLINE const T& top() const
+    {
+        HC_ASSERT(!m_heap.is_empty()); // The priority queue is empty!
+        return m_heap[0].value;
+    }
+
+    ALWAYS_INLINE PriorityQueueHandle top_handle() const
+    {
+        HC_ASSERT(!m_heap.is_empty()); // The priority queue is empty!
+        return m_heap[0].handle;
+    }
+
+    ALWAYS_INLINE bool contains(PriorityQueueHandle handle) const
+    {
+        return (handle < m_positions.size()) && (m_positions[handle] != InvalidPosition);
+    }
+
+    ALWAYS_INLINE const T& get(PriorityQueueHandle handle) const
+    {
+        HC_ASSERT(contains(handle)); // Invalid handle!
+        return m_heap[m_positions[handle]].value;
+    }
+
+public:
+    PriorityQueueHandle push(const T& value)
+    {
+        const PriorityQueueHandle handle = acquire_handle();
+        m_heap.add({ value, handle });
+        sift_up((uint32_t)m_heap.size() - 1);
+        return handle;
+    }
+
+    PriorityQueueHandle push(T&& value)
+    {
+        const PriorityQueueHandle handle = acquire_handle();
+        m_heap.add({ Types::move(value), handle });
+        sift_up((uint32_t)m_heap.size() - 1);
+        return handle;
+    }
+
+    void pop()
+    {
+        HC_ASSERT(!m_heap.is_empty()); // Trying to pop from an empty priority queue!
+        remove_at(0);
+    }
+
+    /** Moves the top element out of the queue and removes it. */
+    T take_top()
+    {
+        HC_ASSERT(!m_heap.is_empty()); // Trying to pop from an empty priority queue!
+        T value = Types::move(m_heap[0].value);
+        remove_at(0);
+        return value;
+    }
+
+    /**
+     * Replaces the value of an element and restores the heap order. Works both when the priority
+     *   increases (decrease-key) and when it decreases.
+     */
+    void update(PriorityQueueHandle handle, const T& value)
+    {
+        HC_ASSERT(contains(handle)); // Invalid handle!
+        const uint32_t position = m_positions[handle];
+        m_heap[position].value = value;
+        restore(position);
+    }
+
+    void update(PriorityQueueHandle handle, T&& value)
+    {
+        HC_ASSERT(contains(handle)); // Invalid handle!
+        const uint32_t position = m_positions[handle];
+        m_heap[position].value = Types::move(value);
+        restore(position);
+    }
+
+    bool remove(PriorityQueueHandle handle)
+    {
+        if (!contains(handle))
+        {
+            return false;
+        }
+
+        remove_at(m_positions[handle]);
+        return true;
+    }
+
+    void clear()
+    {
+        m_heap.clear();
+        m_positions.clear();
+        m_free_handles.clear();
+    }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity > m_heap.capacity())
+        {
+            m_heap.set_capacity(capacity);
+        }
+    }
+
+private:
+    PriorityQueueHandle acquire_handle()
+    {
+        if (!m_free_handles.is_empty())
+        {
+            const PriorityQueueHandle handle = m_free_handles.back();
+            m_free_handles.pop();
+            m_positions[handle] = (uint32_t)m_heap.size();
+            return handle;
+        }
+
+        const PriorityQueueHandle handle = (PriorityQueueHandle)m_positions.size();
+        m_positions.add((uint32_t)m_heap.size());
+        return handle;
+    }
+
+    void remove_at(uint32_t position)
+    {
+        const PriorityQueueHandle handle = m_heap[position].handle;
+        m_positions[handle] = InvalidPosition;
+        m_free_handles.add(handle);
+
+        const uint32_t last_position = (uint32_t)m_heap.size() - 1;
+        if (position != last_position)
+        {
+            m_heap[position] = Types::move(m_heap[last_position]);
+            m_positions[m_heap[position].handle] = position;
+            m_heap.pop();
+            restore(position);
+        }
+        else
+        {
+            m_heap.pop();
+        }
+    }
+
+    // Moves the node at the given position either up or down, whichever its new value requires.
+    void restore(uint32_t position)
+    {
+        if (position > 0 && Comparator::is_less(m_heap[position].value, m_heap[(position - 1) / Arity].value))
+        {
+            sift_up(position);
+        }
+        else
+        {
+            sift_down(position);
+        }
+    }
+
+    // The node is held aside while its ancestors are moved down, so each step is a single move.
+    void sift_up(uint32_t position)
+    {
+        Node node = Types::move(m_heap[position]);
+
+        while (position > 0)
+        {
+            const uint32_t parent = (position - 1) / Arity;
+            if (!Comparator::is_less(node.value, m_heap[parent].value))
+            {
+                break;
+            }
+
+            m_heap[position] = Types::move(m_heap[parent]);
+            m_positions[m_heap[position].handle] = position;
+            position = parent;
+        }
+
+        m_heap[position] = Types::move(node);
+        m_positions[m_heap[position].handle] = position;
+    }
+
+    void sift_down(uint32_t position)
+    {
+        const uint32_t count = (uint32_t)m_heap.size();
+        Node node = Types::move(m_heap[position]);
+
+        while (true)
+        {
+            const uint32_t first_child = position * Arity + 1;
+            if (first_child >= count)
+            {
+                break;
+            }
+
+            // Finding the child that is ordered first. The children are adjacent in memory.
+            const uint32_t end_child = Math::min<uint32_t>(first_child + Arity, count);
+            uint32_t best_child = first_child;
+            for (uint32_t child = first_child + 1; child < end_child; ++child)
+            {
+                if (Comparator::is_less(m_heap[child].value, m_heap[best_child].value))
+                {
+                    best_child = child;
+                }
+            }
+
+            if (!Comparator::is_less(m_heap[best_child].value, node.value))
+            {
+                break;
+            }
+
+            m_heap[position] = Types::move(m_heap[best_child]);
+            m_positions[m_heap[position].handle] = position;
+            position = best_child;
+        }
+
+        m_heap[position] = Types::move(node);
+        m_positions[m_heap[position].handle] = position;
+    }
+
+private:
+    // The heap nodes. The children of the node at index 'i' are at '[i * Arity + 1, i * Arity + Arity]'.
+    Array<Node, AllocatorType> m_heap;
+
+    // Maps each handle to the position of its node in the heap, or to 'InvalidPosition' if it isn't used.
+    Array<uint32_t, AllocatorType> m_positions;
+
+    // The handles that can be recycled.
+    Array<PriorityQueueHandle, AllocatorType> m_free_handles;
+};
+
+} // namespace HC
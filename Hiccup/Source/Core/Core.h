@@ -13,23 +13,69 @@
 #include "Core/Memory/Memory.h"
 #include "Core/Memory/Buffer.h"
 #include "Core/Memory/Arena.h"
+#include "Core/Memory/VirtualArena.h"
 
 #include "Core/Performance.h"
+#include "Core/CommandLine.h"
+#include "Core/Config.h"
+
+//////// THREADING ////////
+
+#include "Core/Threading/Atomic.h"
+#include "Core/Threading/Thread.h"
+#include "Core/Threading/Mutex.h"
+#include "Core/Threading/ConditionVariable.h"
+#include "Core/Threading/Semaphore.h"
+#include "Core/Threading/ReadWriteLock.h"
+#include "Core/Threading/ThreadEvent.h"
+#include "Core/Threading/JobSystem.h"
+
+//////// FILE SYSTEM ////////
+
+#include "Core/FileSystem/FileSystem.h"
+#include "Core/FileSystem/AsyncIO.h"
+#include "Core/FileSystem/PackFile.h"
+#include "Core/FileSystem/PackBuilder.h"
+#include "Core/FileSystem/VirtualFileSystem.h"
+
+//////// COMPRESSION ////////
+
+#include "Core/Compression/Compression.h"
+
+//////// SERIALIZATION ////////
+
+#include "Core/Serialization/Blob.h"
+#include "Core/Serialization/BlobWriter.h"
 
 //////// CONTAINERS ////////
 
 #include "Core/Containers/Array.h"
+#include "Core/Containers/BitArray.h"
 #include "Core/Containers/FixedArray.h"
 #include "Core/Containers/String.h"
 #include "Core/Containers/StringView.h"
 #include "Core/Containers/Span.h"
 #include "Core/Containers/HashTable.h"
+#include "Core/Containers/Deque.h"
+#include "Core/Containers/PriorityQueue.h"
+#include "Core/Containers/IntrusiveList.h"
+#include "Core/Containers/IntrusiveHashTable.h"
+#include "Core/Containers/Cache.h"
 #include "Core/Containers/RefPtr.h"
 #include "Core/Containers/UniquePtr.h"
 
+//////// ALGORITHMS ////////
+
+#include "Core/Algorithms/Sort.h"
+
+//////// REFLECTION ////////
+
+#include "Core/Reflection/Reflection.h"
+
 //////// MATH ////////
 
 #include "Core/Math/MathUtilities.h"
 #include "Core/Math/Geometry.h"
 #include "Core/Math/Transform.h"
+#include "Core/Math/Frustum.h"
 #include "Core/Math/Random.h"
\ No newline at end of file
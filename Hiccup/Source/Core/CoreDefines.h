@@ -57,6 +57,15 @@
     #error Build configuration not specified!
 #endif // No build configuration.
 
+// A shipping build that keeps the asserts and verifies enabled.
+#ifndef HC_CONFIGURATION_CHECKED
+    #define HC_CONFIGURATION_CHECKED    0
+#endif // HC_CONFIGURATION_CHECKED
+
+#if HC_CONFIGURATION_CHECKED && !HC_CONFIGURATION_SHIPPING
+    #error The checked configuration is a variant of the shipping configuration!
+#endif // Checked, but not shipping.
+
 //////////////// COMPILER ////////////////
 
 #ifdef _MSC_BUILD
@@ -93,6 +102,17 @@
     #error Unknown or unsupported compiler! Hiccup only supports MSVC, Clang and GCC.
 #endif // No compiler.
 
+//////////////// INSTRUCTION SETS ////////////////
+
+// SSE2 is part of the x64 baseline, so it is always available on the supported platforms.
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__x86_64__) || defined(__SSE2__)
+    #define HC_SIMD_SSE                 1
+#endif // x64 or SSE2.
+
+#ifndef HC_SIMD_SSE
+    #define HC_SIMD_SSE                 0
+#endif // HC_SIMD_SSE
+
 //////////////// COMPILER WARNINGS SUPRESSION ////////////////
 
 #if HC_COMPILER_MSVC
@@ -108,16 +128,34 @@
 
 //////////////// COMPILER-SPECIFIC UTILITIES ////////////////
 
+// 'HC_LIKELY'/'HC_UNLIKELY' hint the branch layout, and are only honored by GCC and Clang.
+// 'HC_ASSUME' lets the optimizer rely on the expression being true. It might not be evaluated, so it must not have side effects.
 #if HC_COMPILER_MSVC
     #define HC_DEBUGBREAK               __debugbreak()
     #define ALWAYS_INLINE               __forceinline
     #define HC_FUNCTION_SIG             __FUNCSIG__
     #define HC_FUNCTION_NAME            __FUNCTION__
+    #define HC_NOINLINE                 __declspec(noinline)
+    #define HC_NORETURN                 __declspec(noreturn)
+    #define HC_COLD
+    #define HC_LIKELY(X)                (X)
+    #define HC_UNLIKELY(X)              (X)
+    #define HC_ASSUME(X)                __assume(X)
 #elif HC_COMPILER_GCC_CLANG
     #define HC_DEBUGBREAK               __builtin_trap()
     #define ALWAYS_INLINE               inline
     #define HC_FUNCTION_SIG             __PRETTY_FUNCTION__
     #define HC_FUNCTION_NAME            __func__
+    #define HC_NOINLINE                 __attribute__((noinline))
+    #define HC_NORETURN                 __attribute__((noreturn))
+    #define HC_COLD                     __attribute__((cold))
+    #define HC_LIKELY(X)                __builtin_expect(!!(X), 1)
+    #define HC_UNLIKELY(X)              __builtin_expect(!!(X), 0)
+    #if HC_COMPILER_CLANG
+        #define HC_ASSUME(X)            __builtin_assume(X)
+    #else
+        #define HC_ASSUME(X)            ((X) ? (void)0 : __builtin_unreachable())
+    #endif // HC_COMPILER_CLANG
 #endif // Compiler switch.
 
 //////////////// UTILITIES ////////////////
@@ -19,6 +19,9 @@ namespace HC
 
 static constexpr size_t InvalidSize = (size_t)(-1);
 
+// The size (in bytes) of a cache line, on all supported architectures.
+static constexpr size_t CacheLineSize = 64;
+
 using float32_t = float;
 using float64_t = double;
 
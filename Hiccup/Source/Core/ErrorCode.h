@@ -25,6 +25,16 @@ namespace HC
 enum class ErrorCode : uint32_t {
     Success = 0,
     KeyAlreadyExists,
+    InvalidParameter,
+
+    FileNotFound,
+    FileOpenFailed,
+    FileReadFailed,
+    FileWriteFailed,
+    FileMappingFailed,
+
+    CompressionFailed,
+    CorruptedData,
 };
 
 } // namespace HC
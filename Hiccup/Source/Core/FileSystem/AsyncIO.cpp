@@ -0,0 +1,279 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "AsyncIO.h"
+
+#include "Core/Memory/Memory.h"
+#include "Core/Threading/Thread.h"
+#include "Core/Threading/Mutex.h"
+#include "Core/Threading/Semaphore.h"
+#include "Core/Threading/JobSystem.h"
+
+namespace HC
+{
+
+// Doubly linked FIFO of pending requests. Protected by the queue mutex.
+struct AsyncIOQueue
+{
+    AsyncIORequest* head;
+    AsyncIORequest* tail;
+};
+
+struct AsyncIOData
+{
+    AsyncIODescription description;
+
+    Mutex queue_mutex;
+    AsyncIOQueue queues[(uint8_t)AsyncIOPriority::MaxEnumValue];
+
+    // Counts the queued requests, so idle IO threads can sleep.
+    Semaphore pending_requests;
+
+    Thread io_threads[AsyncIO::MaxIOThreadsCount];
+    Atomic<uint32_t> should_stop;
+};
+static_internal AsyncIOData* s_async_io_data = nullptr;
+
+static constexpr uint32_t DefaultIOThreadsCount = 2;
+
+AsyncIOStatus AsyncIORequest::wait() const
+{
+    uint32_t status = m_status.load(MemoryOrder::Acquire);
+    if (status == (uint32_t)AsyncIOStatus::Idle)
+    {
+        // The request was never submitted, so no one would ever wake this thread up.
+        return AsyncIOStatus::Idle;
+    }
+
+    while (status < (uint32_t)AsyncIOStatus::Completed)
+    {
+        Platform::wait_on_address(const_cast<Atomic<uint32_t>&>(m_status).address(), status);
+        status = m_status.load(MemoryOrder::Acquire);
+    }
+
+    return (AsyncIOStatus)status;
+}
+
+// Publishes the final status. The system must not access the request afterwards, as its owner might release or resubmit it.
+static_internal void finish_request(Atomic<uint32_t>& status, AsyncIOStatus final_status)
+{
+    volatile uint32_t* address = status.address();
+    status.store((uint32_t)final_status, MemoryOrder::Release);
+    Platform::wake_by_address_all(address);
+}
+
+bool AsyncIO::initialize(const AsyncIODescription& description)
+{
+    s_async_io_data = hc_new AsyncIOData();
+    s_async_io_data->description = description;
+
+    if (s_async_io_data->description.io_threads_count == 0)
+    {
+        s_async_io_data->description.io_threads_count = DefaultIOThreadsCount;
+    }
+
+    if (s_async_io_data->description.io_threads_count > MaxIOThreadsCount)
+    {
+        HC_LOG_WARN("AsyncIO::initialize - Too many IO threads requested! Clamping to %u.", MaxIOThreadsCount);
+        s_async_io_data->description.io_threads_count = MaxIOThreadsCount;
+    }
+
+    for (uint32_t index = 0; index < s_async_io_data->description.io_threads_count; ++index)
+    {
+        ThreadDescription thread_desc = {};
+        thread_desc.function = io_thread_function;
+        thread_desc.name = "Async IO";
+
+        // IO threads spend most of their time blocked, so a higher priority keeps the devices busy.
+        thread_desc.priority = Platform::ThreadPriority::High;
+
+        if (!s_async_io_data->io_threads[index].start(thread_desc))
+        {
+            HC_LOG_ERROR("AsyncIO::initialize - Failed to start the IO threads!");
+            shutdown();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void AsyncIO::shutdown()
+{
+    // Threads finish the transfer they are currently executing. Requests that are still queued are cancelled.
+    s_async_io_data->should_stop.store(1, MemoryOrder::Release);
+    s_async_io_data->pending_requests.release(s_async_io_data->description.io_threads_count);
+
+    for (Thread& io_thread : s_async_io_data->io_threads)
+    {
+        io_thread.join();
+    }
+
+    for (AsyncIOQueue& queue : s_async_io_data->queues)
+    {
+        AsyncIORequest* request = queue.head;
+        while (request)
+        {
+            AsyncIORequest* next = request->m_next;
+            request->m_next = nullptr;
+            request->m_previous = nullptr;
+            finish_request(request->m_status, AsyncIOStatus::Cancelled);
+            request = next;
+        }
+    }
+
+    hc_delete s_async_io_data;
+    s_async_io_data = nullptr;
+}
+
+Platform::FileHandle AsyncIO::open_file(StringView filepath, Platform::FileAccess access)
+{
+    // Asynchronous requests are usually scattered across the file, so read-ahead would be wasted.
+    return Platform::open_file(filepath.c_str(), filepath.bytes_count(), access, Platform::FileOpenMode::OpenExisting, Platform::AccessHint::Random);
+}
+
+void AsyncIO::close_file(Platform::FileHandle file)
+{
+    Platform::close_file(file);
+}
+
+void AsyncIO::submit(AsyncIORequest& request)
+{
+    AsyncIORequest* requests[] = { &request };
+    submit(Span<AsyncIORequest* const>(requests, 1));
+}
+
+void AsyncIO::submit(Span<AsyncIORequest* const> requests)
+{
+    if (requests.is_empty())
+    {
+        return;
+    }
+
+    {
+        ScopedLock<Mutex> lock(s_async_io_data->queue_mutex);
+        for (size_t index = 0; index < requests.count(); ++index)
+        {
+            AsyncIORequest* request = requests.elements()[index];
+            HC_ASSERT(request->get_status() != AsyncIOStatus::Pending && request->get_status() != AsyncIOStatus::InProgress); // The request is already submitted!
+            HC_DASSERT(request->file != nullptr && (request->buffer != nullptr || request->bytes_count == 0)); // Invalid request!
+
+            request->m_status.store((uint32_t)AsyncIOStatus::Pending, MemoryOrder::Relaxed);
+
+            AsyncIOQueue& queue = s_async_io_data->queues[(uint8_t)request->priority];
+            request->m_next = nullptr;
+            request->m_previous = queue.tail;
+            if (queue.tail)
+            {
+                queue.tail->m_next = request;
+            }
+            else
+            {
+                queue.head = request;
+            }
+            queue.tail = request;
+        }
+    }
+
+    s_async_io_data->pending_requests.release((uint32_t)requests.count());
+}
+
+bool AsyncIO::cancel(AsyncIORequest& request)
+{
+    {
+        // Requests only leave the 'Pending' state while the queue mutex is held.
+        ScopedLock<Mutex> lock(s_async_io_data->queue_mutex);
+        if (request.get_status() != AsyncIOStatus::Pending)
+        {
+            return false;
+        }
+
+        AsyncIOQueue& queue = s_async_io_data->queues[(uint8_t)request.priority];
+        (request.m_previous ? request.m_previous->m_next : queue.head) = request.m_next;
+        (request.m_next ? request.m_next->m_previous : queue.tail) = request.m_previous;
+        request.m_next = nullptr;
+        request.m_previous = nullptr;
+    }
+
+    // The semaphore count is not decremented, so an IO thread will wake up and find nothing to do.
+    finish_request(request.m_status, AsyncIOStatus::Cancelled);
+    return true;
+}
+
+AsyncIORequest* AsyncIO::pop_request()
+{
+    ScopedLock<Mutex> lock(s_async_io_data->queue_mutex);
+
+    for (AsyncIOQueue& queue : s_async_io_data->queues)
+    {
+        AsyncIORequest* request = queue.head;
+        if (request)
+        {
+            queue.head = request->m_next;
+            (queue.head ? queue.head->m_previous : queue.tail) = nullptr;
+            request->m_next = nullptr;
+
+            request->m_status.store((uint32_t)AsyncIOStatus::InProgress, MemoryOrder::Relaxed);
+            return request;
+        }
+    }
+
+    return nullptr;
+}
+
+void AsyncIO::execute_request(AsyncIORequest& request)
+{
+    const bool succeeded = (request.operation == AsyncIOOperation::Read) ?
+        Platform::read_file(request.file, request.offset, request.buffer, request.bytes_count) :
+        Platform::write_file(request.file, request.offset, request.buffer, request.bytes_count);
+
+    const AsyncIOStatus result = succeeded ? AsyncIOStatus::Completed : AsyncIOStatus::Failed;
+
+    if (!request.on_completed)
+    {
+        finish_request(request.m_status, result);
+        return;
+    }
+
+    request.m_result = result;
+
+    // Without the job system, the callback is invoked on the IO thread, so the request still finishes.
+    if (request.invoke_callback_as_job && JobSystem::is_initialized())
+    {
+        JobSystem::schedule({ invoke_callback, &request });
+    }
+    else
+    {
+        invoke_callback(&request);
+    }
+}
+
+void AsyncIO::invoke_callback(void* request_pointer)
+{
+    AsyncIORequest& request = *(AsyncIORequest*)request_pointer;
+
+    // The status is published only after the callback returns, so threads that wait for the request
+    //   can't release it while the callback still uses it.
+    request.on_completed(request, request.m_result);
+    finish_request(request.m_status, request.m_result);
+}
+
+void AsyncIO::io_thread_function(void* user_data)
+{
+    while (true)
+    {
+        s_async_io_data->pending_requests.acquire();
+        if (s_async_io_data->should_stop.load(MemoryOrder::Acquire))
+        {
+            break;
+        }
+
+        // The request might have been cancelled in the meantime.
+        AsyncIORequest* request = pop_request();
+        if (request)
+        {
+            execute_request(*request);
+        }
+    }
+}
+
+} // namespace HC
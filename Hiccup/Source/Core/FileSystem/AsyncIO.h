@@ -0,0 +1,175 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Platform/Platform.h"
+#include "Core/Containers/Span.h"
+#include "Core/Containers/StringView.h"
+#include "Core/Threading/Atomic.h"
+
+namespace HC
+{
+
+enum class AsyncIOOperation : uint8_t
+{
+    Read = 0,
+    Write = 1,
+};
+
+enum class AsyncIOPriority : uint8_t
+{
+    High = 0, Normal = 1, Low = 2,
+
+    MaxEnumValue
+};
+
+enum class AsyncIOStatus : uint32_t
+{
+    // The request was never submitted.
+    Idle = 0,
+    // The request waits in the queue. Only pending requests can be cancelled.
+    Pending,
+    // The transfer is currently executing, or its completion callback is executing.
+    InProgress,
+
+    // Final states. Once a request reaches one of them, it is no longer referenced by the system.
+    Completed,
+    Failed,
+    Cancelled,
+};
+
+struct AsyncIORequest;
+
+// The signature of the function invoked when a request finishes. Not invoked for cancelled requests.
+using PFN_AsyncIOCallback = void(*)(AsyncIORequest& request, AsyncIOStatus status);
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Async IO Request.
+ *----------------------------------------------------------------
+ * Describes a single read or write that transfers data directly between the file and
+ *   caller-owned memory. The request itself is also owned by the caller, and must stay
+ *   alive (and untouched) until it reaches a final status. Submitting never allocates.
+ * The final status is published only after the completion callback returns, so once 'wait' returns
+ *   the request can be released or resubmitted. The callback receives the result as a parameter,
+ *   and must not resubmit the request itself.
+ */
+struct AsyncIORequest
+{
+public:
+    HC_NON_COPIABLE(AsyncIORequest)
+    HC_NON_MOVABLE(AsyncIORequest)
+
+    AsyncIORequest()
+        : m_status((uint32_t)AsyncIOStatus::Idle)
+        , m_result(AsyncIOStatus::Idle)
+        , m_next(nullptr)
+        , m_previous(nullptr)
+    {}
+
+public:
+    Platform::FileHandle file = nullptr;
+    uint64_t offset = 0;
+
+    // The memory that is read into (or written from). Must be at least 'bytes_count' bytes large.
+    void* buffer = nullptr;
+    size_t bytes_count = 0;
+
+    AsyncIOOperation operation = AsyncIOOperation::Read;
+    AsyncIOPriority priority = AsyncIOPriority::Normal;
+
+    // If true, the callback is executed as a job on the job system; otherwise, it is executed on
+    //   the IO thread, so it must be cheap (usually, just scheduling further processing).
+    bool invoke_callback_as_job = true;
+
+    PFN_AsyncIOCallback on_completed = nullptr;
+    void* user_data = nullptr;
+
+public:
+    ALWAYS_INLINE NODISCARD AsyncIOStatus get_status() const { return (AsyncIOStatus)m_status.load(MemoryOrder::Acquire); }
+
+    /** @return True if the request reached a final status. The completion callback (if any) has already returned. */
+    ALWAYS_INLINE NODISCARD bool is_finished() const { return (get_status() >= AsyncIOStatus::Completed); }
+
+    /**
+     * Blocks until the request reaches a final status, making the request usable as a future.
+     * A request that was never submitted doesn't block, and 'Idle' is returned right away.
+     *
+     * @return The final status of the request, or 'Idle' if it was never submitted.
+     */
+    HC_API AsyncIOStatus wait() const;
+
+private:
+    Atomic<uint32_t> m_status;
+
+    // The final status, stored until the completion callback returns.
+    AsyncIOStatus m_result;
+
+    // Intrusive links into the queue of pending requests.
+    AsyncIORequest* m_next;
+    AsyncIORequest* m_previous;
+
+    friend class AsyncIO;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Async IO System Description.
+ *----------------------------------------------------------------
+ */
+struct AsyncIODescription
+{
+    // The number of threads that issue the transfers. More threads keep more requests in flight,
+    //   which helps on SSDs. If 0, a default value is used.
+    uint32_t io_threads_count;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Async IO System.
+ *----------------------------------------------------------------
+ * Executes file reads and writes without blocking the submitting thread.
+ * Pending requests are queued by priority, and picked up by a small pool of dedicated IO threads
+ *   that issue positional transfers, so many requests are in flight at once.
+ */
+class AsyncIO
+{
+public:
+    static constexpr uint32_t MaxIOThreadsCount = 16;
+
+public:
+    static bool initialize(const AsyncIODescription& description);
+    static void shutdown();
+
+public:
+    /** Opens a file for asynchronous access. Must be closed by calling 'close_file'. */
+    HC_API static Platform::FileHandle open_file(StringView filepath, Platform::FileAccess access);
+
+    HC_API static void close_file(Platform::FileHandle file);
+
+public:
+    /** Queues the request. Its status must not be 'Pending' or 'InProgress'. */
+    HC_API static void submit(AsyncIORequest& request);
+
+    /** Queues all requests at once, taking the queue lock and waking the IO threads only once. */
+    HC_API static void submit(Span<AsyncIORequest* const> requests);
+
+    /**
+     * Removes the request from the queue, if it wasn't yet picked up by an IO thread.
+     *
+     * @return True if the request was cancelled; False if it is already in progress or finished.
+     */
+    HC_API static bool cancel(AsyncIORequest& request);
+
+private:
+    // Takes the highest priority pending request out of the queue, marking it as in progress.
+    static AsyncIORequest* pop_request();
+
+    static void execute_request(AsyncIORequest& request);
+    static void invoke_callback(void* request_pointer);
+
+    static void io_thread_function(void* user_data);
+};
+
+} // namespace HC
@@ -0,0 +1,307 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "FileSystem.h"
+
+namespace HC
+{
+
+// Picks the most relevant error code for a file that couldn't be opened.
+static_internal ErrorCode get_open_error(StringView filepath)
+{
+    return Platform::file_exists(filepath.c_str(), filepath.bytes_count()) ? ErrorCode::FileOpenFailed : ErrorCode::FileNotFound;
+}
+
+ErrorCode MappedFile::open(StringView filepath, FileMapMode mode, uint64_t offset, size_t size, Platform::AccessHint hint)
+{
+    close();
+
+    const Platform::FileAccess access = (mode == FileMapMode::ReadWrite) ? Platform::FileAccess::ReadWrite : Platform::FileAccess::Read;
+    Platform::FileHandle file = Platform::open_file(filepath.c_str(), filepath.bytes_count(), access, Platform::FileOpenMode::OpenExisting, hint);
+    if (!file)
+    {
+        HC_LOG_ERROR("MappedFile::open - Failed to open the file!");
+        return get_open_error(filepath);
+    }
+
+    uint64_t file_size = 0;
+    if (!Platform::get_file_size(file, &file_size))
+    {
+        Platform::close_file(file);
+        return ErrorCode::FileReadFailed;
+    }
+
+    if (offset > file_size || size > file_size - offset)
+    {
+        HC_LOG_ERROR("MappedFile::open - The requested range exceeds the file size!");
+        Platform::close_file(file);
+        return ErrorCode::InvalidParameter;
+    }
+
+    if (size == 0)
+    {
+        size = (size_t)(file_size - offset);
+    }
+
+    // The view keeps the file alive, so the handle can be closed right away.
+    const ErrorCode error = map(file, offset, size, mode);
+    Platform::close_file(file);
+
+    if (error == ErrorCode::Success && hint != Platform::AccessHint::Normal)
+    {
+        advise(hint);
+    }
+
+    return error;
+}
+
+ErrorCode MappedFile::create(StringView filepath, size_t size)
+{
+    close();
+
+    Platform::FileHandle file = Platform::open_file(filepath.c_str(), filepath.bytes_count(), Platform::FileAccess::ReadWrite, Platform::FileOpenMode::CreateAlways, Platform::AccessHint::Normal);
+    if (!file)
+    {
+        HC_LOG_ERROR("MappedFile::create - Failed to create the file!");
+        return ErrorCode::FileOpenFailed;
+    }
+
+    if (!Platform::set_file_size(file, size))
+    {
+        HC_LOG_ERROR("MappedFile::create - Failed to resize the file!");
+        Platform::close_file(file);
+        return ErrorCode::FileWriteFailed;
+    }
+
+    const ErrorCode error = map(file, 0, size, FileMapMode::ReadWrite);
+    Platform::close_file(file);
+    return error;
+}
+
+void MappedFile::close()
+{
+    if (!m_view)
+    {
+        return;
+    }
+
+    Platform::unmap_file(m_view, m_mapping);
+
+    m_view = nullptr;
+    m_mapping = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool MappedFile::flush()
+{
+    if (!m_view || !is_writable())
+    {
+        return false;
+    }
+
+    return Platform::flush_mapped_file(m_view, (size_t)(m_data - (uint8_t*)m_view) + m_size);
+}
+
+void MappedFile::advise(Platform::AccessHint hint, size_t offset, size_t size)
+{
+    if (!m_view || offset >= m_size)
+    {
+        return;
+    }
+
+    if (size > m_size - offset)
+    {
+        size = m_size - offset;
+    }
+
+    Platform::advise_memory(m_data + offset, size, hint);
+}
+
+ErrorCode MappedFile::map(Platform::FileHandle file, uint64_t offset, size_t size, FileMapMode mode)
+{
+    // The OS can't map empty ranges, so they are rejected. Callers that accept empty files must check the size first.
+    if (size == 0)
+    {
+        HC_LOG_ERROR("MappedFile::map - Mapping empty files is not supported!");
+        return ErrorCode::InvalidParameter;
+    }
+
+    // The view must start at a multiple of the mapping granularity, so the requested offset is rounded down.
+    const uint64_t granularity = Platform::get_mapping_granularity();
+    const uint64_t view_offset = offset - (offset % granularity);
+    const size_t view_delta = (size_t)(offset - view_offset);
+
+    m_view = Platform::map_file(file, view_offset, view_delta + size, mode == FileMapMode::ReadWrite, &m_mapping);
+    if (!m_view)
+    {
+        HC_LOG_ERROR("MappedFile::map - Failed to map the file!");
+        m_mapping = nullptr;
+        return ErrorCode::FileMappingFailed;
+    }
+
+    m_data = (uint8_t*)m_view + view_delta;
+    m_size = size;
+    m_mode = mode;
+    return ErrorCode::Success;
+}
+
+bool FileSystem::exists(StringView filepath)
+{
+    return Platform::file_exists(filepath.c_str(), filepath.bytes_count());
+}
+
+ErrorCode FileSystem::get_file_size(StringView filepath, uint64_t* out_file_size)
+{
+    Platform::FileHandle file = Platform::open_file(filepath.c_str(), filepath.bytes_count(), Platform::FileAccess::Read, Platform::FileOpenMode::OpenExisting, Platform::AccessHint::Normal);
+    if (!file)
+    {
+        return get_open_error(filepath);
+    }
+
+    const bool succeeded = Platform::get_file_size(file, out_file_size);
+    Platform::close_file(file);
+    return succeeded ? ErrorCode::Success : ErrorCode::FileReadFailed;
+}
+
+ErrorCode FileSystem::read_entire_file(StringView filepath, Buffer& out_buffer)
+{
+    Platform::FileHandle file = Platform::open_file(filepath.c_str(), filepath.bytes_count(), Platform::FileAccess::Read, Platform::FileOpenMode::OpenExisting, Platform::AccessHint::Sequential);
+    if (!file)
+    {
+        HC_LOG_ERROR("FileSystem::read_entire_file - Failed to open the file!");
+        return get_open_error(filepath);
+    }
+
+    uint64_t file_size = 0;
+    if (!Platform::get_file_size(file, &file_size))
+    {
+        Platform::close_file(file);
+        return ErrorCode::FileReadFailed;
+    }
+
+    out_buffer.allocate((size_t)file_size);
+    if (!Platform::read_file(file, 0, out_buffer.data, out_buffer.size))
+    {
+        HC_LOG_ERROR("FileSystem::read_entire_file - Failed to read the file!");
+        out_buffer.release();
+        Platform::close_file(file);
+        return ErrorCode::FileReadFailed;
+    }
+
+    Platform::close_file(file);
+    return ErrorCode::Success;
+}
+
+ErrorCode FileSystem::read_file_range(StringView filepath, uint64_t offset, Span<uint8_t> destination)
+{
+    Platform::FileHandle file = Platform::open_file(filepath.c_str(), filepath.bytes_count(), Platform::FileAccess::Read, Platform::FileOpenMode::OpenExisting, Platform::AccessHint::Normal);
+    if (!file)
+    {
+        return get_open_error(filepath);
+    }
+
+    const bool succeeded = Platform::read_file(file, offset, destination.elements(), destination.count());
+    Platform::close_file(file);
+    return succeeded ? ErrorCode::Success : ErrorCode::FileReadFailed;
+}
+
+ErrorCode FileSystem::write_entire_file(StringView filepath, Span<const uint8_t> contents)
+{
+    Platform::FileHandle file = Platform::open_file(filepath.c_str(), filepath.bytes_count(), Platform::FileAccess::Write, Platform::FileOpenMode::CreateAlways, Platform::AccessHint::Sequential);
+    if (!file)
+    {
+        HC_LOG_ERROR("FileSystem::write_entire_file - Failed to create the file!");
+        return ErrorCode::FileOpenFailed;
+    }
+
+    const bool succeeded = Platform::write_file(file, 0, contents.elements(), contents.count());
+    Platform::close_file(file);
+    return succeeded ? ErrorCode::Success : ErrorCode::FileWriteFailed;
+}
+
+struct FileIteratorContext
+{
+    char path[FileSystem::MaxPathBytesCount];
+    size_t path_length;
+
+    bool recursive;
+    bool succeeded;
+
+    PFN_FileVisitor visitor;
+    void* user_data;
+};
+
+static_internal bool iterate_files_recursive(FileIteratorContext& context);
+
+static_internal bool visit_directory_entry(const char* name, size_t name_length, bool is_directory, void* user_data)
+{
+    FileIteratorContext& context = *(FileIteratorContext*)user_data;
+    if (is_directory && !context.recursive)
+    {
+        return true;
+    }
+
+    // Appends the entry name (and the separator) to the current path.
+    const size_t parent_length = context.path_length;
+    if (parent_length + name_length + 2 > FileSystem::MaxPathBytesCount)
+    {
+        HC_LOG_ERROR("FileSystem::iterate_files - The path is too long! It will be skipped.");
+        context.succeeded = false;
+        return true;
+    }
+
+    if (parent_length > 0 && context.path[parent_length - 1] != '/' && context.path[parent_length - 1] != '\\')
+    {
+        context.path[context.path_length++] = '/';
+    }
+    Memory::copy(context.path + context.path_length, name, name_length);
+    context.path_length += name_length;
+    context.path[context.path_length] = 0;
+
+    if (is_directory)
+    {
+        iterate_files_recursive(context);
+    }
+    else
+    {
+        context.visitor(StringView(context.path, context.path_length), context.user_data);
+    }
+
+    context.path_length = parent_length;
+    context.path[context.path_length] = 0;
+    return true;
+}
+
+static_internal bool iterate_files_recursive(FileIteratorContext& context)
+{
+    if (!Platform::iterate_directory(context.path, context.path_length, visit_directory_entry, &context))
+    {
+        context.succeeded = false;
+        return false;
+    }
+
+    return true;
+}
+
+bool FileSystem::iterate_files(StringView directory_path, bool recursive, PFN_FileVisitor visitor, void* user_data)
+{
+    if (directory_path.bytes_count() >= MaxPathBytesCount)
+    {
+        HC_LOG_ERROR("FileSystem::iterate_files - The directory path is too long!");
+        return false;
+    }
+
+    FileIteratorContext context;
+    Memory::copy(context.path, directory_path.c_str(), directory_path.bytes_count());
+    context.path_length = directory_path.bytes_count();
+    context.path[context.path_length] = 0;
+    context.recursive = recursive;
+    context.succeeded = true;
+    context.visitor = visitor;
+    context.user_data = user_data;
+
+    iterate_files_recursive(context);
+    return context.succeeded;
+}
+
+} // namespace HC
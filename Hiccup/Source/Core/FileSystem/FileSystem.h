@@ -0,0 +1,198 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Platform/Platform.h"
+#include "Core/Memory/Buffer.h"
+#include "Core/Containers/Span.h"
+#include "Core/Containers/StringView.h"
+
+namespace HC
+{
+
+enum class FileMapMode : uint8_t
+{
+    Readonly = 0,
+    ReadWrite = 1,
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Mapped File.
+ *----------------------------------------------------------------
+ * A view of a file's contents, mapped directly into the address space of the process.
+ * The data is paged in from the OS file cache on first access, so no copy into a heap
+ *   buffer is ever made. Readonly views of the same file share the same physical pages.
+ * The view is released when the object is destroyed.
+ */
+class MappedFile
+{
+public:
+    HC_NON_COPIABLE(MappedFile)
+
+    MappedFile()
+        : m_view(nullptr)
+        , m_mapping(nullptr)
+        , m_data(nullptr)
+        , m_size(0)
+        , m_mode(FileMapMode::Readonly)
+    {}
+
+    MappedFile(MappedFile&& other) noexcept
+        : m_view(other.m_view)
+        , m_mapping(other.m_mapping)
+        , m_data(other.m_data)
+        , m_size(other.m_size)
+        , m_mode(other.m_mode)
+    {
+        other.m_view = nullptr;
+        other.m_mapping = nullptr;
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        close();
+
+        m_view = other.m_view;
+        m_mapping = other.m_mapping;
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_mode = other.m_mode;
+
+        other.m_view = nullptr;
+        other.m_mapping = nullptr;
+        other.m_data = nullptr;
+        other.m_size = 0;
+
+        return *this;
+    }
+
+public:
+    /**
+     * Maps a range of an existing file.
+     *
+     * @param filepath The path of the file to map.
+     * @param mode Whether or not the view is writable. Writes are visible to other views of the file.
+     * @param offset The offset of the mapped range. It doesn't have to be aligned.
+     * @param size The size of the mapped range. If 0, the range extends until the end of the file.
+     * @param hint How the view will be accessed. Applied both to the file and to the mapped range.
+     */
+    HC_API ErrorCode open(StringView filepath, FileMapMode mode, uint64_t offset = 0, size_t size = 0, Platform::AccessHint hint = Platform::AccessHint::Normal);
+
+    /**
+     * Creates (or truncates) a file of the given size and maps it as a writable view.
+     * Useful for producing large files in place, without intermediate heap buffers.
+     */
+    HC_API ErrorCode create(StringView filepath, size_t size);
+
+    /** Releases the view. If writable, the modified pages are eventually written to the file by the OS. */
+    HC_API void close();
+
+    /** Synchronously writes the modified pages back to the file. */
+    HC_API bool flush();
+
+    /** Hints the OS about how the given range of the view will be accessed. */
+    HC_API void advise(Platform::AccessHint hint, size_t offset = 0, size_t size = InvalidSize);
+
+    /** Asynchronously brings the given range of the view into memory, so later accesses don't page fault. */
+    ALWAYS_INLINE void prefetch(size_t offset = 0, size_t size = InvalidSize)
+    {
+        advise(Platform::AccessHint::WillNeed, offset, size);
+    }
+
+public:
+    ALWAYS_INLINE bool is_open() const { return (m_view != nullptr); }
+    ALWAYS_INLINE bool is_writable() const { return (m_mode == FileMapMode::ReadWrite); }
+
+    ALWAYS_INLINE const uint8_t* data() const { return m_data; }
+    ALWAYS_INLINE size_t size() const { return m_size; }
+
+    ALWAYS_INLINE Span<const uint8_t> readonly_span() const { return Span<const uint8_t>(m_data, m_size); }
+
+    ALWAYS_INLINE Span<uint8_t> read_write_span()
+    {
+        HC_DASSERT(is_writable()); // Writing to a readonly view causes an access violation!
+        return Span<uint8_t>(m_data, m_size);
+    }
+
+    /**
+     * @return A non-owning buffer that references the view's memory.
+     * The buffer must never be released, and is only valid for as long as the view is mapped.
+     */
+    ALWAYS_INLINE Buffer as_buffer() const
+    {
+        Buffer buffer;
+        buffer.data = m_data;
+        buffer.size = m_size;
+        return buffer;
+    }
+
+private:
+    // Maps the given range of an already opened file.
+    ErrorCode map(Platform::FileHandle file, uint64_t offset, size_t size, FileMapMode mode);
+
+private:
+    // The address returned by the platform. Aligned to the mapping granularity.
+    void* m_view;
+    Platform::FileMappingHandle m_mapping;
+
+    // The address of the first byte of the requested range, inside the view.
+    uint8_t* m_data;
+    size_t m_size;
+
+    FileMapMode m_mode;
+};
+
+// The signature of the function invoked for each file found by 'FileSystem::iterate_files'.
+// The path is composed of the iterated directory path, followed by the path of the file relative to it.
+using PFN_FileVisitor = void(*)(StringView filepath, void* user_data);
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup File System.
+ *----------------------------------------------------------------
+ * Whole-file utilities. For large assets, prefer 'MappedFile' over reading into heap buffers.
+ */
+class FileSystem
+{
+public:
+    // The maximum number of bytes a path built by the file system can occupy.
+    static constexpr size_t MaxPathBytesCount = 1024;
+
+public:
+    HC_API static bool exists(StringView filepath);
+
+    HC_API static ErrorCode get_file_size(StringView filepath, uint64_t* out_file_size);
+
+    /**
+     * Reads the entire contents of the file into a newly allocated buffer.
+     * The buffer is owned by the caller, and must be released by calling 'Buffer::release'.
+     */
+    HC_API static ErrorCode read_entire_file(StringView filepath, Buffer& out_buffer);
+
+    /** Reads a range of the file into the given (caller-owned) memory. */
+    HC_API static ErrorCode read_file_range(StringView filepath, uint64_t offset, Span<uint8_t> destination);
+
+    /** Creates (or truncates) the file and writes the given bytes to it. */
+    HC_API static ErrorCode write_entire_file(StringView filepath, Span<const uint8_t> contents);
+
+    /**
+     * Invokes the visitor for each file in the directory.
+     *
+     * @param directory_path The directory to iterate.
+     * @param recursive Whether or not the files in the subdirectories are visited as well.
+     *
+     * @return False if the directory (or one of its subdirectories) couldn't be opened; True otherwise.
+     */
+    HC_API static bool iterate_files(StringView directory_path, bool recursive, PFN_FileVisitor visitor, void* user_data);
+};
+
+} // namespace HC
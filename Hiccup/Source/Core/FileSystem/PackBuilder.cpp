@@ -0,0 +1,227 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "PackBuilder.h"
+
+#include "Core/Threading/JobSystem.h"
+
+namespace HC
+{
+
+static_internal uint64_t align_offset(uint64_t offset, uint64_t alignment)
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+ErrorCode PackBuilder::add_file(StringView pack_path, StringView source_filepath)
+{
+    uint64_t file_size = 0;
+    const ErrorCode error = FileSystem::get_file_size(source_filepath, &file_size);
+    if (error != ErrorCode::Success)
+    {
+        HC_LOG_ERROR("PackBuilder::add_file - Failed to query the source file '%.*s'!", (int)source_filepath.bytes_count(), source_filepath.c_str());
+        return error;
+    }
+
+    PendingEntry entry = {};
+    entry.path_hash = PackFile::compute_path_hash(pack_path);
+    entry.source_path_offset = m_path_pool.size();
+    entry.source_path_length = source_filepath.bytes_count();
+    entry.size = file_size;
+    HC_CHECK_ERROR(add_entry(pack_path, entry));
+
+    const size_t pool_offset = m_path_pool.add_uninitialized(source_filepath.bytes_count());
+    Memory::copy(m_path_pool.data() + pool_offset, source_filepath.c_str(), source_filepath.bytes_count());
+    return ErrorCode::Success;
+}
+
+ErrorCode PackBuilder::add_memory(StringView pack_path, Span<const uint8_t> data)
+{
+    PendingEntry entry = {};
+    entry.path_hash = PackFile::compute_path_hash(pack_path);
+    entry.memory = data.elements();
+    entry.size = data.count();
+    return add_entry(pack_path, entry);
+}
+
+struct AddDirectoryContext
+{
+    PackBuilder* builder;
+
+    // The number of bytes of the source directory path, including the trailing separator.
+    size_t source_prefix_length;
+
+    char pack_path[FileSystem::MaxPathBytesCount];
+    size_t pack_directory_length;
+
+    ErrorCode error;
+};
+
+static_internal void add_directory_file(StringView filepath, void* user_data)
+{
+    AddDirectoryContext& context = *(AddDirectoryContext*)user_data;
+    if (context.error != ErrorCode::Success)
+    {
+        return;
+    }
+
+    const char* relative_path = filepath.c_str() + context.source_prefix_length;
+    const size_t relative_path_length = filepath.bytes_count() - context.source_prefix_length;
+
+    if (context.pack_directory_length + relative_path_length > FileSystem::MaxPathBytesCount)
+    {
+        HC_LOG_ERROR("PackBuilder::add_directory - The pack path is too long!");
+        context.error = ErrorCode::InvalidParameter;
+        return;
+    }
+
+    Memory::copy(context.pack_path + context.pack_directory_length, relative_path, relative_path_length);
+    const StringView pack_path = StringView(context.pack_path, context.pack_directory_length + relative_path_length);
+
+    context.error = context.builder->add_file(pack_path, filepath);
+}
+
+ErrorCode PackBuilder::add_directory(StringView source_directory, StringView pack_directory)
+{
+    if (pack_directory.bytes_count() + 1 >= FileSystem::MaxPathBytesCount)
+    {
+        HC_LOG_ERROR("PackBuilder::add_directory - The pack directory path is too long!");
+        return ErrorCode::InvalidParameter;
+    }
+
+    AddDirectoryContext context;
+    context.builder = this;
+    context.error = ErrorCode::Success;
+
+    // The visited paths always have a separator between the directory path and the relative path.
+    const char source_last_character = (source_directory.bytes_count() > 0) ? source_directory.c_str()[source_directory.bytes_count() - 1] : '/';
+    context.source_prefix_length = source_directory.bytes_count() + ((source_last_character == '/' || source_last_character == '\\') ? 0 : 1);
+
+    Memory::copy(context.pack_path, pack_directory.c_str(), pack_directory.bytes_count());
+    context.pack_directory_length = pack_directory.bytes_count();
+    if (context.pack_directory_length > 0)
+    {
+        context.pack_path[context.pack_directory_length++] = '/';
+    }
+
+    if (!FileSystem::iterate_files(source_directory, true, add_directory_file, &context) && context.error == ErrorCode::Success)
+    {
+        HC_LOG_ERROR("PackBuilder::add_directory - Failed to iterate the source directory!");
+        return ErrorCode::FileReadFailed;
+    }
+
+    return context.error;
+}
+
+ErrorCode PackBuilder::build(StringView output_filepath)
+{
+    const uint64_t alignment = m_alignment;
+
+    PackHeader header = {};
+    header.magic = PackFile::Magic;
+    header.version = PackFile::Version;
+    header.entries_count = (uint32_t)m_entries.size();
+    header.alignment = m_alignment;
+    header.index_offset = sizeof(PackHeader);
+
+    // Computing the pack layout.
+    Array<PackEntry> index;
+    index.set_size_uninitialized(m_entries.size());
+
+    uint64_t cursor = header.index_offset + m_entries.size() * sizeof(PackEntry);
+    for (size_t entry_index = 0; entry_index < m_entries.size(); ++entry_index)
+    {
+        cursor = align_offset(cursor, alignment);
+
+        index[entry_index].path_hash = m_entries[entry_index].path_hash;
+        index[entry_index].offset = cursor;
+        index[entry_index].size = m_entries[entry_index].size;
+
+        cursor += m_entries[entry_index].size;
+    }
+    header.total_size = cursor;
+
+    MappedFile output_file;
+    const ErrorCode create_error = output_file.create(output_filepath, (size_t)header.total_size);
+    if (create_error != ErrorCode::Success)
+    {
+        HC_LOG_ERROR("PackBuilder::build - Failed to create the output file!");
+        return create_error;
+    }
+
+    uint8_t* output = output_file.read_write_span().elements();
+    Memory::copy(output, &header, sizeof(PackHeader));
+    Memory::copy(output + header.index_offset, index.data(), index.size() * sizeof(PackEntry));
+
+    // Copying the blobs. Each source file is mapped and copied directly into the mapped output file,
+    //   and the files are processed in parallel, as most of the time is spent waiting for page faults.
+    Atomic<uint32_t> failed_count(0);
+    JobSystem::parallel_for(m_entries.size(), 8, [&](size_t begin_index, size_t end_index)
+    {
+        for (size_t entry_index = begin_index; entry_index < end_index; ++entry_index)
+        {
+            const PendingEntry& entry = m_entries[entry_index];
+            uint8_t* destination = output + index[entry_index].offset;
+
+            if (entry.size == 0)
+            {
+                continue;
+            }
+
+            if (entry.memory)
+            {
+                Memory::copy(destination, entry.memory, (size_t)entry.size);
+                continue;
+            }
+
+            const StringView source_filepath = StringView(m_path_pool.data() + entry.source_path_offset, entry.source_path_length);
+
+            MappedFile source_file;
+            if (source_file.open(source_filepath, FileMapMode::Readonly, 0, 0, Platform::AccessHint::Sequential) != ErrorCode::Success || source_file.size() != entry.size)
+            {
+                HC_LOG_ERROR("PackBuilder::build - The source file '%.*s' is missing or was modified!", (int)source_filepath.bytes_count(), source_filepath.c_str());
+                failed_count.fetch_add(1, MemoryOrder::Relaxed);
+                continue;
+            }
+
+            Memory::copy(destination, source_file.data(), source_file.size());
+        }
+    });
+
+    if (failed_count.load() > 0)
+    {
+        output_file.close();
+        return ErrorCode::FileReadFailed;
+    }
+
+    if (!output_file.flush())
+    {
+        HC_LOG_ERROR("PackBuilder::build - Failed to write the output file!");
+        return ErrorCode::FileWriteFailed;
+    }
+
+    return ErrorCode::Success;
+}
+
+void PackBuilder::clear()
+{
+    m_entries.clear();
+    m_path_hashes.clear();
+    m_path_pool.clear();
+}
+
+ErrorCode PackBuilder::add_entry(StringView pack_path, const PendingEntry& entry)
+{
+    if (m_path_hashes.find(entry.path_hash) != m_path_hashes.EndOfTable)
+    {
+        // Different paths that hash to the same value can't be stored in the same pack, as the
+        //   pack index only stores the path hashes.
+        HC_LOG_ERROR("PackBuilder::add_entry - The path '%.*s' is already in the pack (or collides with another path)!", (int)pack_path.bytes_count(), pack_path.c_str());
+        return ErrorCode::KeyAlreadyExists;
+    }
+
+    m_path_hashes.insert(entry.path_hash, (uint32_t)m_entries.size());
+    m_entries.add(entry);
+    return ErrorCode::Success;
+}
+
+} // namespace HC
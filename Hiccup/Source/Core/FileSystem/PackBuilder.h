@@ -0,0 +1,97 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/HashTable.h"
+#include "Core/Containers/Span.h"
+#include "Core/Containers/StringView.h"
+
+#include "PackFile.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Pack Builder.
+ *----------------------------------------------------------------
+ * Collects files and writes them into a pack file, readable by 'PackFile'.
+ * The source files are only read when the pack is built, directly into the
+ *   memory-mapped output file.
+ */
+class PackBuilder
+{
+public:
+    HC_NON_COPIABLE(PackBuilder)
+    HC_NON_MOVABLE(PackBuilder)
+
+    /** @param alignment All blobs will start at a multiple of this value. Must be a power of two. */
+    PackBuilder(uint32_t alignment = PackFile::DefaultAlignment)
+        : m_alignment(alignment)
+    {
+        HC_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0); // The alignment must be a power of two!
+    }
+
+public:
+    /**
+     * Adds a file from the host file system.
+     *
+     * @param pack_path The path of the file, relative to the pack root.
+     * @param source_filepath The path of the file on the host file system.
+     */
+    HC_API ErrorCode add_file(StringView pack_path, StringView source_filepath);
+
+    /**
+     * Adds a memory block as a file. The memory is not copied, so it must stay alive until the pack is built.
+     *
+     * @param pack_path The path of the file, relative to the pack root.
+     */
+    HC_API ErrorCode add_memory(StringView pack_path, Span<const uint8_t> data);
+
+    /**
+     * Recursively adds all files of a host directory.
+     *
+     * @param source_directory The directory on the host file system.
+     * @param pack_directory The directory, relative to the pack root, where the files will be placed.
+     */
+    HC_API ErrorCode add_directory(StringView source_directory, StringView pack_directory);
+
+    /** Writes the pack file. The builder can be reused afterwards. */
+    HC_API ErrorCode build(StringView output_filepath);
+
+    HC_API void clear();
+
+public:
+    ALWAYS_INLINE size_t get_entries_count() const { return m_entries.size(); }
+
+private:
+    struct PendingEntry
+    {
+        uint64_t path_hash;
+
+        // Either the source file path (stored in the path pool), or the memory to pack.
+        size_t source_path_offset;
+        size_t source_path_length;
+        const uint8_t* memory;
+
+        uint64_t size;
+    };
+
+    // Registers the entry, checking for duplicated paths and hash collisions.
+    ErrorCode add_entry(StringView pack_path, const PendingEntry& entry);
+
+private:
+    uint32_t m_alignment;
+
+    Array<PendingEntry> m_entries;
+
+    // Maps the path hashes to indices into the entries array.
+    HashTable<uint64_t, uint32_t> m_path_hashes;
+
+    // Stores all source file paths back to back, to avoid an allocation for each file.
+    Array<char> m_path_pool;
+};
+
+} // namespace HC
@@ -0,0 +1,130 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "PackFile.h"
+
+namespace HC
+{
+
+ErrorCode PackFile::open(StringView filepath)
+{
+    close();
+
+    // Packs are mostly read in small, scattered pieces, so read-ahead would only waste memory.
+    HC_CHECK_ERROR(m_file.open(filepath, FileMapMode::Readonly, 0, 0, Platform::AccessHint::Random));
+
+    if (m_file.size() < sizeof(PackHeader))
+    {
+        HC_LOG_ERROR("PackFile::open - The file is too small to be a pack!");
+        close();
+        return ErrorCode::InvalidParameter;
+    }
+
+    const PackHeader& header = *(const PackHeader*)m_file.data();
+    if (header.magic != Magic || header.version != Version || header.total_size != m_file.size())
+    {
+        HC_LOG_ERROR("PackFile::open - Invalid pack header! The pack is either corrupted or was built by an incompatible version.");
+        close();
+        return ErrorCode::InvalidParameter;
+    }
+
+    // The bounds are checked without adding to the offsets, so a corrupted index can't overflow past the checks.
+    const uint64_t file_size = m_file.size();
+    const uint64_t index_size = (uint64_t)header.entries_count * sizeof(PackEntry);
+    if (index_size > file_size || header.index_offset > file_size - index_size || header.index_offset % alignof(PackEntry) != 0)
+    {
+        HC_LOG_ERROR("PackFile::open - The pack index exceeds the file size!");
+        close();
+        return ErrorCode::InvalidParameter;
+    }
+
+    m_entries = (const PackEntry*)(m_file.data() + header.index_offset);
+    m_entries_count = header.entries_count;
+
+    for (uint32_t index = 0; index < m_entries_count; ++index)
+    {
+        const PackEntry& entry = m_entries[index];
+        if (entry.size > file_size || entry.offset > file_size - entry.size)
+        {
+            HC_LOG_ERROR("PackFile::open - A pack entry exceeds the file size!");
+            close();
+            return ErrorCode::InvalidParameter;
+        }
+
+        if (m_index.find(entry.path_hash) != m_index.EndOfTable)
+        {
+            HC_LOG_ERROR("PackFile::open - Two pack entries have the same path hash!");
+            close();
+            return ErrorCode::InvalidParameter;
+        }
+
+        m_index.insert(entry.path_hash, index);
+    }
+
+    return ErrorCode::Success;
+}
+
+void PackFile::close()
+{
+    m_index.clear();
+    m_entries = nullptr;
+    m_entries_count = 0;
+    m_file.close();
+}
+
+const PackEntry* PackFile::find_entry(uint64_t path_hash) const
+{
+    const size_t index = m_index.find(path_hash);
+    if (index == m_index.EndOfTable)
+    {
+        return nullptr;
+    }
+
+    return m_entries + m_index.at_index(index);
+}
+
+void PackFile::prefetch(const PackEntry& entry)
+{
+    m_file.prefetch((size_t)entry.offset, (size_t)entry.size);
+}
+
+uint64_t PackFile::compute_path_hash(StringView path)
+{
+    // 64-bit FNV-1a.
+    uint64_t hash = 0xCBF29CE484222325;
+    bool previous_was_separator = true;
+
+    const char* characters = path.c_str();
+    for (size_t index = 0; index < path.bytes_count(); ++index)
+    {
+        char character = characters[index];
+        if (character == '\\')
+        {
+            character = '/';
+        }
+
+        if (character == '/')
+        {
+            if (previous_was_separator)
+            {
+                continue;
+            }
+            previous_was_separator = true;
+        }
+        else
+        {
+            previous_was_separator = false;
+        }
+
+        if (character >= 'A' && character <= 'Z')
+        {
+            character += 'a' - 'A';
+        }
+
+        hash ^= (uint8_t)character;
+        hash *= 0x100000001B3;
+    }
+
+    return hash;
+}
+
+} // namespace HC
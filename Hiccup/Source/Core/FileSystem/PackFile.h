@@ -0,0 +1,111 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Containers/Span.h"
+#include "Core/Containers/StringView.h"
+#include "Core/Containers/HashTable.h"
+
+#include "FileSystem.h"
+
+namespace HC
+{
+
+/**
+ * The layout of a pack file:
+ *   1. The header.
+ *   2. The index - an array of 'PackEntry', one for each stored file.
+ *   3. The blobs - the file contents, stored contiguously. Each blob starts at a multiple of the pack alignment.
+ * All offsets are relative to the beginning of the pack file. All values are little-endian.
+ */
+struct PackHeader
+{
+    uint32_t magic;
+    uint32_t version;
+
+    uint32_t entries_count;
+
+    // All blobs start at a multiple of this value. Always a power of two.
+    uint32_t alignment;
+
+    uint64_t index_offset;
+    uint64_t total_size;
+};
+
+struct PackEntry
+{
+    // The hash of the normalized path (relative to the pack root), as computed by 'PackFile::compute_path_hash'.
+    uint64_t path_hash;
+
+    uint64_t offset;
+    uint64_t size;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Pack File.
+ *----------------------------------------------------------------
+ * Read-only archive that stores many files in a single, memory-mapped file.
+ * Opening a pack is a single open and map; looking up a file is a single hash table
+ *   lookup; reading it returns a view directly into the mapped memory.
+ */
+class PackFile
+{
+public:
+    HC_NON_COPIABLE(PackFile)
+    HC_NON_MOVABLE(PackFile)
+
+    static constexpr uint32_t Magic = 0x4B504348; // 'HCPK'
+    static constexpr uint32_t Version = 1;
+
+    static constexpr uint32_t DefaultAlignment = 64;
+
+public:
+    PackFile()
+        : m_entries(nullptr)
+        , m_entries_count(0)
+    {}
+
+public:
+    HC_API ErrorCode open(StringView filepath);
+    HC_API void close();
+
+    ALWAYS_INLINE bool is_open() const { return m_file.is_open(); }
+
+    ALWAYS_INLINE uint32_t get_entries_count() const { return m_entries_count; }
+
+public:
+    /** @return The entry of the file with the given path hash, or nullptr if it isn't stored in the pack. */
+    HC_API const PackEntry* find_entry(uint64_t path_hash) const;
+
+    ALWAYS_INLINE const PackEntry* find_entry(StringView path) const { return find_entry(compute_path_hash(path)); }
+
+    /** @return A view of the file contents. Valid for as long as the pack is open. */
+    ALWAYS_INLINE Span<const uint8_t> get_data(const PackEntry& entry) const
+    {
+        return Span<const uint8_t>(m_file.data() + entry.offset, (size_t)entry.size);
+    }
+
+    /** Asynchronously brings the file contents into memory, so the first access doesn't page fault. */
+    HC_API void prefetch(const PackEntry& entry);
+
+public:
+    /**
+     * Hashes the path after normalizing it: backslashes become forward slashes, ASCII letters are
+     *   lowercase, and leading/repeated separators are ignored. This matches the host file system
+     *   behavior on Windows, where paths are case-insensitive.
+     */
+    HC_API static uint64_t compute_path_hash(StringView path);
+
+private:
+    MappedFile m_file;
+
+    const PackEntry* m_entries;
+    uint32_t m_entries_count;
+
+    // Maps the path hashes to indices into the entries array.
+    HashTable<uint64_t, uint32_t> m_index;
+};
+
+} // namespace HC
@@ -0,0 +1,423 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "VirtualFileSystem.h"
+#include "PackFile.h"
+
+#include "Core/Memory/Memory.h"
+#include "Core/Threading/ReadWriteLock.h"
+
+namespace HC
+{
+
+enum class MountType : uint8_t
+{
+    Directory = 0,
+    Pack = 1,
+};
+
+struct Mount
+{
+    MountType type;
+
+    char mount_point[VirtualFileSystem::MaxMountPointBytesCount];
+    size_t mount_point_length;
+
+    // Only used by directory mounts.
+    char directory_path[FileSystem::MaxPathBytesCount];
+    size_t directory_path_length;
+
+    // Only used by pack mounts.
+    PackFile* pack;
+};
+
+struct VirtualFileSystemData
+{
+    VirtualFileSystemDescription description;
+
+    // Guards the mounts. Lookups only need shared access.
+    ReadWriteLock mounts_lock;
+
+    // Ordered from the oldest to the most recent mount.
+    Mount mounts[VirtualFileSystem::MaxMountsCount];
+    uint32_t mounts_count;
+};
+static_internal VirtualFileSystemData* s_vfs_data = nullptr;
+
+static_internal char normalize_path_character(char character)
+{
+    if (character == '\\')
+    {
+        return '/';
+    }
+
+    if (character >= 'A' && character <= 'Z')
+    {
+        return character + ('a' - 'A');
+    }
+
+    return character;
+}
+
+/**
+ * Checks whether the path is located inside the mount point.
+ *
+ * @param out_relative_path The path, relative to the mount point.
+ */
+static_internal bool match_mount_point(const Mount& mount, StringView path, StringView* out_relative_path)
+{
+    const char* characters = path.c_str();
+    const size_t length = path.bytes_count();
+
+    if (mount.mount_point_length > length)
+    {
+        return false;
+    }
+
+    for (size_t index = 0; index < mount.mount_point_length; ++index)
+    {
+        if (normalize_path_character(characters[index]) != normalize_path_character(mount.mount_point[index]))
+        {
+            return false;
+        }
+    }
+
+    size_t relative_offset = mount.mount_point_length;
+    if (mount.mount_point_length > 0 && relative_offset < length)
+    {
+        // The mount point must match a whole directory name, not just a prefix of it.
+        if (normalize_path_character(characters[relative_offset]) != '/')
+        {
+            return false;
+        }
+        ++relative_offset;
+    }
+
+    *out_relative_path = StringView(characters + relative_offset, length - relative_offset);
+    return true;
+}
+
+// Checks whether any component of the path is '..', which would resolve outside of the directory mount.
+static_internal bool has_parent_directory_component(StringView path)
+{
+    const char* characters = path.c_str();
+    const size_t length = path.bytes_count();
+
+    size_t component_begin = 0;
+    for (size_t index = 0; index <= length; ++index)
+    {
+        if (index == length || normalize_path_character(characters[index]) == '/')
+        {
+            if (index - component_begin == 2 && characters[component_begin] == '.' && characters[component_begin + 1] == '.')
+            {
+                return true;
+            }
+            component_begin = index + 1;
+        }
+    }
+
+    return false;
+}
+
+// Builds the host path of a file located in a directory mount.
+static_internal bool build_host_path(const Mount& mount, StringView relative_path, char* out_buffer, size_t* out_length)
+{
+    if (has_parent_directory_component(relative_path))
+    {
+        HC_LOG_ERROR("VirtualFileSystem - Paths can't refer to parent directories ('..')!");
+        return false;
+    }
+
+    if (mount.directory_path_length + relative_path.bytes_count() + 2 > FileSystem::MaxPathBytesCount)
+    {
+        HC_LOG_ERROR("VirtualFileSystem - The resolved host path is too long!");
+        return false;
+    }
+
+    size_t length = mount.directory_path_length;
+    Memory::copy(out_buffer, mount.directory_path, length);
+    if (length > 0)
+    {
+        out_buffer[length++] = '/';
+    }
+
+    Memory::copy(out_buffer + length, relative_path.c_str(), relative_path.bytes_count());
+    length += relative_path.bytes_count();
+    out_buffer[length] = 0;
+
+    *out_length = length;
+    return true;
+}
+
+// Copies the mount point, stripping its trailing separators.
+static_internal bool set_mount_point(Mount& mount, StringView mount_point)
+{
+    size_t length = mount_point.bytes_count();
+    while (length > 0 && normalize_path_character(mount_point.c_str()[length - 1]) == '/')
+    {
+        --length;
+    }
+
+    if (length >= VirtualFileSystem::MaxMountPointBytesCount)
+    {
+        HC_LOG_ERROR("VirtualFileSystem - The mount point is too long!");
+        return false;
+    }
+
+    Memory::copy(mount.mount_point, mount_point.c_str(), length);
+    mount.mount_point[length] = 0;
+    mount.mount_point_length = length;
+    return true;
+}
+
+bool VirtualFileSystem::initialize(const VirtualFileSystemDescription& description)
+{
+    HC_MEMORY_TAG_SCOPE(FileSystem);
+    s_vfs_data = hc_new VirtualFileSystemData();
+    s_vfs_data->description = description;
+    s_vfs_data->mounts_count = 0;
+
+    if (description.root_directory.bytes_count() > 0)
+    {
+        if (mount_directory(StringView(), description.root_directory) != ErrorCode::Success)
+        {
+            hc_delete s_vfs_data;
+            s_vfs_data = nullptr;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void VirtualFileSystem::shutdown()
+{
+    for (uint32_t index = 0; index < s_vfs_data->mounts_count; ++index)
+    {
+        if (s_vfs_data->mounts[index].type == MountType::Pack)
+        {
+            hc_delete s_vfs_data->mounts[index].pack;
+        }
+    }
+
+    hc_delete s_vfs_data;
+    s_vfs_data = nullptr;
+}
+
+ErrorCode VirtualFileSystem::mount_directory(StringView mount_point, StringView directory_path)
+{
+    if (directory_path.bytes_count() >= FileSystem::MaxPathBytesCount)
+    {
+        HC_LOG_ERROR("VirtualFileSystem::mount_directory - The directory path is too long!");
+        return ErrorCode::InvalidParameter;
+    }
+
+    ScopedLock<ReadWriteLock> lock(s_vfs_data->mounts_lock);
+    if (s_vfs_data->mounts_count == MaxMountsCount)
+    {
+        HC_LOG_ERROR("VirtualFileSystem::mount_directory - Too many mounts!");
+        return ErrorCode::InvalidParameter;
+    }
+
+    Mount& mount = s_vfs_data->mounts[s_vfs_data->mounts_count];
+    if (!set_mount_point(mount, mount_point))
+    {
+        return ErrorCode::InvalidParameter;
+    }
+
+    mount.type = MountType::Directory;
+    mount.pack = nullptr;
+
+    // Trailing separators are stripped, as 'build_host_path' always inserts one.
+    size_t directory_path_length = directory_path.bytes_count();
+    while (directory_path_length > 1 && normalize_path_character(directory_path.c_str()[directory_path_length - 1]) == '/')
+    {
+        --directory_path_length;
+    }
+    Memory::copy(mount.directory_path, directory_path.c_str(), directory_path_length);
+    mount.directory_path[directory_path_length] = 0;
+    mount.directory_path_length = directory_path_length;
+
+    ++s_vfs_data->mounts_count;
+    return ErrorCode::Success;
+}
+
+ErrorCode VirtualFileSystem::mount_pack(StringView mount_point, StringView pack_filepath)
+{
+    // The pack is opened before taking the lock, so lookups are not blocked meanwhile.
+    PackFile* pack = hc_new PackFile();
+    const ErrorCode open_error = pack->open(pack_filepath);
+    if (open_error != ErrorCode::Success)
+    {
+        HC_LOG_ERROR("VirtualFileSystem::mount_pack - Failed to open the pack file '%.*s'!", (int)pack_filepath.bytes_count(), pack_filepath.c_str());
+        hc_delete pack;
+        return open_error;
+    }
+
+    ScopedLock<ReadWriteLock> lock(s_vfs_data->mounts_lock);
+    if (s_vfs_data->mounts_count == MaxMountsCount)
+    {
+        HC_LOG_ERROR("VirtualFileSystem::mount_pack - Too many mounts!");
+        hc_delete pack;
+        return ErrorCode::InvalidParameter;
+    }
+
+    Mount& mount = s_vfs_data->mounts[s_vfs_data->mounts_count];
+    if (!set_mount_point(mount, mount_point))
+    {
+        hc_delete pack;
+        return ErrorCode::InvalidParameter;
+    }
+
+    mount.type = MountType::Pack;
+    mount.pack = pack;
+    mount.directory_path[0] = 0;
+    mount.directory_path_length = 0;
+
+    ++s_vfs_data->mounts_count;
+    return ErrorCode::Success;
+}
+
+bool VirtualFileSystem::unmount(StringView mount_point)
+{
+    Mount candidate;
+    if (!set_mount_point(candidate, mount_point))
+    {
+        return false;
+    }
+
+    PackFile* pack_to_close = nullptr;
+    {
+        ScopedLock<ReadWriteLock> lock(s_vfs_data->mounts_lock);
+
+        uint32_t index = s_vfs_data->mounts_count;
+        while (index > 0)
+        {
+            const Mount& mount = s_vfs_data->mounts[index - 1];
+            StringView relative_path;
+            if (mount.mount_point_length == candidate.mount_point_length && match_mount_point(mount, StringView(candidate.mount_point, candidate.mount_point_length), &relative_path))
+            {
+                break;
+            }
+            --index;
+        }
+
+        if (index == 0)
+        {
+            return false;
+        }
+
+        pack_to_close = s_vfs_data->mounts[index - 1].pack;
+
+        // Preserving the mounts order, as it defines the overlay priority.
+        for (uint32_t mount_index = index; mount_index < s_vfs_data->mounts_count; ++mount_index)
+        {
+            s_vfs_data->mounts[mount_index - 1] = s_vfs_data->mounts[mount_index];
+        }
+        --s_vfs_data->mounts_count;
+    }
+
+    hc_delete pack_to_close;
+    return true;
+}
+
+bool VirtualFileSystem::exists(StringView path)
+{
+    ScopedSharedLock lock(s_vfs_data->mounts_lock);
+
+    for (uint32_t index = s_vfs_data->mounts_count; index > 0; --index)
+    {
+        const Mount& mount = s_vfs_data->mounts[index - 1];
+        StringView relative_path;
+        if (!match_mount_point(mount, path, &relative_path))
+        {
+            continue;
+        }
+
+        if (mount.type == MountType::Pack)
+        {
+            if (mount.pack->find_entry(relative_path))
+            {
+                return true;
+            }
+        }
+        else
+        {
+            char host_path[FileSystem::MaxPathBytesCount];
+            size_t host_path_length = 0;
+            if (build_host_path(mount, relative_path, host_path, &host_path_length) && FileSystem::exists(StringView(host_path, host_path_length)))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+ErrorCode VirtualFileSystem::open_file(StringView path, VirtualFile& out_file)
+{
+    out_file.close();
+
+    ScopedSharedLock lock(s_vfs_data->mounts_lock);
+
+    for (uint32_t index = s_vfs_data->mounts_count; index > 0; --index)
+    {
+        const Mount& mount = s_vfs_data->mounts[index - 1];
+        StringView relative_path;
+        if (!match_mount_point(mount, path, &relative_path))
+        {
+            continue;
+        }
+
+        if (mount.type == MountType::Pack)
+        {
+            const PackEntry* entry = mount.pack->find_entry(relative_path);
+            if (entry)
+            {
+                out_file.m_data = mount.pack->get_data(*entry);
+                return ErrorCode::Success;
+            }
+            continue;
+        }
+
+        char host_path[FileSystem::MaxPathBytesCount];
+        size_t host_path_length = 0;
+        if (!build_host_path(mount, relative_path, host_path, &host_path_length))
+        {
+            continue;
+        }
+
+        const StringView host_path_view = StringView(host_path, host_path_length);
+
+        uint64_t file_size = 0;
+        const ErrorCode size_error = FileSystem::get_file_size(host_path_view, &file_size);
+        if (size_error == ErrorCode::FileNotFound)
+        {
+            continue;
+        }
+        HC_CHECK_ERROR(size_error);
+
+        // Empty files can't be mapped, but they are valid files nonetheless.
+        if (file_size > 0)
+        {
+            HC_CHECK_ERROR(out_file.m_mapped_file.open(host_path_view, FileMapMode::Readonly));
+            out_file.m_data = out_file.m_mapped_file.readonly_span();
+        }
+
+        return ErrorCode::Success;
+    }
+
+    return ErrorCode::FileNotFound;
+}
+
+ErrorCode VirtualFileSystem::read_file(StringView path, Buffer& out_buffer)
+{
+    VirtualFile file;
+    HC_CHECK_ERROR(open_file(path, file));
+
+    out_buffer.allocate(file.size());
+    Memory::copy(out_buffer.data, file.data().elements(), file.size());
+    return ErrorCode::Success;
+}
+
+} // namespace HC
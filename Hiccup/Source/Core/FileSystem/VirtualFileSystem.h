@@ -0,0 +1,134 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Memory/Buffer.h"
+#include "Core/Containers/Span.h"
+#include "Core/Containers/StringView.h"
+
+#include "FileSystem.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Virtual File.
+ *----------------------------------------------------------------
+ * A read-only view of a file opened through the virtual file system.
+ * Files stored in packs reference the pack's mapped memory directly, while files from
+ *   directory mounts are mapped individually. In both cases, no copy is made.
+ */
+class VirtualFile
+{
+public:
+    HC_NON_COPIABLE(VirtualFile)
+
+    VirtualFile() = default;
+
+    VirtualFile(VirtualFile&& other) noexcept
+        : m_data(other.m_data)
+        , m_mapped_file(Types::move(other.m_mapped_file))
+    {
+        other.m_data = Span<const uint8_t>();
+    }
+
+    VirtualFile& operator=(VirtualFile&& other) noexcept
+    {
+        m_data = other.m_data;
+        m_mapped_file = Types::move(other.m_mapped_file);
+        other.m_data = Span<const uint8_t>();
+        return *this;
+    }
+
+public:
+    ALWAYS_INLINE Span<const uint8_t> data() const { return m_data; }
+    ALWAYS_INLINE size_t size() const { return m_data.count(); }
+
+    /** Releases the view. If the file was read from a pack, the pack stays mapped. */
+    ALWAYS_INLINE void close()
+    {
+        m_data = Span<const uint8_t>();
+        m_mapped_file.close();
+    }
+
+private:
+    Span<const uint8_t> m_data;
+
+    // Only used when the file is read from a directory mount.
+    MappedFile m_mapped_file;
+
+    friend class VirtualFileSystem;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Virtual File System Description.
+ *----------------------------------------------------------------
+ */
+struct VirtualFileSystemDescription
+{
+    // If not empty, this host directory is mounted at the root of the virtual file system.
+    StringView root_directory;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Virtual File System.
+ *----------------------------------------------------------------
+ * Resolves virtual paths (such as "Content/Textures/Brick.png") against a stack of mounts.
+ * A mount attaches either a host directory or a pack file at a mount point. Mounts overlay
+ *   each other: the most recent mount that contains a path wins, so patches and mods
+ *   can override files without touching the base content.
+ * Paths are case-insensitive, and both forward and back slashes are accepted as separators.
+ */
+class VirtualFileSystem
+{
+public:
+    static constexpr uint32_t MaxMountsCount = 32;
+    static constexpr size_t MaxMountPointBytesCount = 128;
+
+public:
+    static bool initialize(const VirtualFileSystemDescription& description);
+    static void shutdown();
+
+public:
+    /**
+     * Mounts a host directory.
+     *
+     * @param mount_point The virtual directory where the host directory is attached. Empty for the root.
+     * @param directory_path The path of the host directory.
+     */
+    HC_API static ErrorCode mount_directory(StringView mount_point, StringView directory_path);
+
+    /**
+     * Opens a pack file and mounts its contents.
+     *
+     * @param mount_point The virtual directory where the pack root is attached. Empty for the root.
+     * @param pack_filepath The path of the pack file, on the host file system.
+     */
+    HC_API static ErrorCode mount_pack(StringView mount_point, StringView pack_filepath);
+
+    /**
+     * Removes the most recent mount with the given mount point. Files opened from it (except from
+     *   packs) stay valid, but packs are closed so their views must be released beforehand.
+     *
+     * @return True if a mount was removed; False otherwise.
+     */
+    HC_API static bool unmount(StringView mount_point);
+
+public:
+    HC_API static bool exists(StringView path);
+
+    /** Opens a zero-copy view of the file. */
+    HC_API static ErrorCode open_file(StringView path, VirtualFile& out_file);
+
+    /**
+     * Reads the entire contents of the file into a newly allocated buffer.
+     * The buffer is owned by the caller, and must be released by calling 'Buffer::release'.
+     */
+    HC_API static ErrorCode read_file(StringView path, Buffer& out_buffer);
+};
+
+} // namespace HC
@@ -7,59 +7,117 @@
 #include "Core/Memory/Memory.h"
 #include "Core/Performance.h"
 #include "Core/Logger.h"
+#include "Core/CommandLine.h"
+#include "Core/Config.h"
+#include "Core/Threading/JobSystem.h"
+#include "Core/FileSystem/FileSystem.h"
+#include "Core/FileSystem/AsyncIO.h"
+#include "Core/FileSystem/VirtualFileSystem.h"
+#include "Core/SubsystemRegistry.h"
 
 namespace HC
 {
 
-#define HC_INITIALIZE(SYSTEM_NAME, SYSTEM_DESCRIPTION)          \
-    if (!SYSTEM_NAME::initialize(SYSTEM_DESCRIPTION))           \
-    {                                                            \
-        for (int32_t i = system_shutdowns_count - 1; i >= 0; --i) \
-        {                                                       \
-            system_shutdowns[i]();                              \
-        }                                                       \
-        return EXIT_FAILURE;                                    \
-    }                                                           \
-    system_shutdowns[system_shutdowns_count++] = SYSTEM_NAME::shutdown;
-
 HC_API int32_t guarded_main(bool(*create_application_desc_callback)(ApplicationDescription*), char** cmd_args, uint32_t cmd_args_count)
 {
-    // Shutdown graph.
-    using PFN_Shutdown = void(*)(void);
-    PFN_Shutdown system_shutdowns[4] = {};
-    uint16_t system_shutdowns_count = 0;
+    CommandLine::initialize(cmd_args, cmd_args_count);
 
     //---------------- Initializing the Platform system ----------------
+    // The platform layer provides the threads and the timers used by the subsystem registry,
+    //   so it is initialized before (and shut down after) all the other subsystems.
+    // The config file can only be read once the platform is initialized, so the platform is only configurable from the command line.
     PlatformDescription platform_desc = {};
 #if HC_CONFIGURATION_SHIPPING
     platform_desc.is_console_attached = false;
 #else
     platform_desc.is_console_attached = true;
 #endif
-    HC_INITIALIZE(Platform, platform_desc);
+    const ConfigBinding platform_bindings[] =
+    {
+        HC_CONFIG_BIND("Platform", platform_desc, is_console_attached),
+    };
+    Config::apply_command_line(platform_bindings);
+
+    if (!Platform::initialize(platform_desc))
+    {
+        return EXIT_FAILURE;
+    }
+
+    // The problems found while applying the platform config are reported now that the console is available.
+    Config::flush_problems();
     //------------------------------------------------------------------
 
+    //---------------- Registering the core subsystems ----------------
+    bool are_subsystems_registered = true;
 
-    //---------------- Initializing the Memory system ----------------
     MemoryDescription memory_desc = {};
     memory_desc.should_initialize_tracker = true;
-    HC_INITIALIZE(Memory, memory_desc);
-    //----------------------------------------------------------------
+    are_subsystems_registered &= HC_REGISTER_SUBSYSTEM(Memory, memory_desc);
 
+    LoggerDescription logger_desc = {};
+    are_subsystems_registered &= HC_REGISTER_SUBSYSTEM(Logger, logger_desc, "Memory");
 
-    //---------------- Initializing the Performance Profiling Tool ----------------
 #if HC_ENABLE_PROFILING
     ProfilerDescription profiler_desc = {};
-    HC_INITIALIZE(Profiler, profiler_desc);
+    are_subsystems_registered &= HC_REGISTER_SUBSYSTEM(Profiler, profiler_desc, "Memory", "Logger");
 #endif // HC_ENABLE_PROFILING
-    //-----------------------------------------------------------------------------
 
+    JobSystemDescription job_system_desc = {};
+    are_subsystems_registered &= HC_REGISTER_SUBSYSTEM(JobSystem, job_system_desc, "Memory", "Logger");
 
-    //---------------- Initializing the Logging system ----------------
-    LoggerDescription logger_desc = {};
-    HC_INITIALIZE(Logger, logger_desc);
+    AsyncIODescription async_io_desc = {};
+    are_subsystems_registered &= HC_REGISTER_SUBSYSTEM(AsyncIO, async_io_desc, "Memory", "Logger", "JobSystem");
+
+    VirtualFileSystemDescription vfs_desc = {};
+    are_subsystems_registered &= HC_REGISTER_SUBSYSTEM(VirtualFileSystem, vfs_desc, "Memory", "Logger");
+
+    // The logger isn't initialized yet, so the failure is reported directly to the console.
+    if (!are_subsystems_registered)
+    {
+        const char message[] = "Failed to register the core subsystems! Aborting...\n";
+        Platform::write_to_console(message, sizeof(message) - 1);
+        Platform::shutdown();
+        return EXIT_FAILURE;
+    }
+    //-----------------------------------------------------------------
+
+    //---------------- Applying the config ----------------
+    // The subsystems only read their descriptions when they are initialized, so the
+    //   config is applied directly into the registered descriptions.
+    const ConfigBinding bindings[] =
+    {
+        HC_CONFIG_BIND("Memory", memory_desc, should_initialize_tracker),
+        HC_CONFIG_BIND("Memory", memory_desc, use_guarded_allocator),
+        HC_CONFIG_BIND("Memory", memory_desc, guarded_allocator_reserve_size),
+        HC_CONFIG_BIND("Memory", memory_desc, guarded_allocator_quarantine_count),
+        HC_CONFIG_BIND("Memory", memory_desc, should_report_leaks),
+        HC_CONFIG_BIND("Memory", memory_desc, leak_report_json_filepath),
+        HC_CONFIG_BIND("Memory", memory_desc, should_fail_on_leaks),
+
+        HC_CONFIG_BIND("JobSystem", job_system_desc, workers_count),
+        HC_CONFIG_BIND("JobSystem", job_system_desc, queue_capacity),
+        HC_CONFIG_BIND("JobSystem", job_system_desc, should_pin_workers_to_numa_nodes),
+
+        HC_CONFIG_BIND("AsyncIO", async_io_desc, io_threads_count),
+
+        HC_CONFIG_BIND("VirtualFileSystem", vfs_desc, root_directory),
+    };
+
+    // The config file is given with '-config=<path>'. Otherwise, the default one is applied, if it exists.
+    StringView config_filepath = "Hiccup.ini"sv;
+    if (CommandLine::get_option("config"sv, config_filepath) || FileSystem::exists(config_filepath))
+    {
+        Config::apply_file(config_filepath, bindings);
+    }
+    Config::apply_command_line(bindings);
     //-----------------------------------------------------------------
 
+    if (!SubsystemRegistry::initialize_all())
+    {
+        Platform::shutdown();
+        return EXIT_FAILURE;
+    }
+
     // Creating the application description.
     ApplicationDescription application_desc = {};
     if (!create_application_desc_callback || !create_application_desc_callback(&application_desc))
@@ -68,6 +126,17 @@ HC_API int32_t guarded_main(bool(*create_application_desc_callback)(ApplicationD
         return EXIT_FAILURE;
     }
 
+    // Running the command instead of the application.
+    if (application_desc.run_command)
+    {
+        const int32_t exit_code = application_desc.run_command();
+
+        SubsystemRegistry::shutdown_all();
+        Platform::shutdown();
+
+        return (exit_code == EXIT_SUCCESS && Memory::has_failed_leak_check()) ? EXIT_FAILURE : exit_code;
+    }
+
     // Creating the application instance.
     Application* application = hc_new Application(application_desc);
     if (!application)
@@ -83,12 +152,10 @@ HC_API int32_t guarded_main(bool(*create_application_desc_callback)(ApplicationD
     hc_delete application;
 
     // Shutting down the core systems.
-    for (int32_t i = system_shutdowns_count - 1; i >= 0; --i)
-    {
-        system_shutdowns[i]();
-    }
+    SubsystemRegistry::shutdown_all();
+    Platform::shutdown();
 
-    return EXIT_SUCCESS;
+    return Memory::has_failed_leak_check() ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
 } // namespace HC
\ No newline at end of file
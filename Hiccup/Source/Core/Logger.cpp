@@ -6,6 +6,7 @@
 #include "Memory/Memory.h"
 #include "Memory/Buffer.h"
 #include "Math/MathUtilities.h"
+#include "Threading/Mutex.h"
 
 #include <cstdarg>
 #include <cstdio>
@@ -49,6 +50,9 @@ struct LoggerData
 
 #if HC_ENABLE_LOGS
 
+    // Guards the buffers and the console, as all threads log through the same buffers.
+    Mutex log_mutex;
+
     Buffer format_buffer;
     Buffer log_buffer;
 
@@ -58,34 +62,40 @@ static_internal LoggerData* s_logger_data = nullptr;
 
 bool Logger::initialize(const LoggerDescription& description)
 {
-    s_logger_data = hc_new LoggerData();
+    HC_MEMORY_TAG_SCOPE(Logger);
 
-    s_logger_data->description = description;
+    // The data is published only after it is fully built, as 'log' treats a non-null pointer as a ready logger.
+    LoggerData* logger_data = hc_new LoggerData();
+    logger_data->description = description;
 
     Buffer buffer = Buffer(2 * kilobytes(8));
 
 #if HC_ENABLE_LOGS
-    s_logger_data->format_buffer.data = buffer.data;
-    s_logger_data->format_buffer.size = buffer.size / 2;
+    logger_data->format_buffer.data = buffer.data;
+    logger_data->format_buffer.size = buffer.size / 2;
 
-    s_logger_data->log_buffer.data = buffer.data + buffer.size / 2;
-    s_logger_data->log_buffer.size = buffer.size / 2;
+    logger_data->log_buffer.data = buffer.data + buffer.size / 2;
+    logger_data->log_buffer.size = buffer.size / 2;
 #endif
 
+    s_logger_data = logger_data;
     return true;
 }
 
 void Logger::shutdown()
 {
+    // Unpublished first, so nothing logs into the buffers while they are released.
+    LoggerData* logger_data = s_logger_data;
+    s_logger_data = nullptr;
+
     Buffer buffer;
 #if HC_ENABLE_LOGS
-    buffer.data = s_logger_data->format_buffer.data;
-    buffer.size = s_logger_data->format_buffer.size + s_logger_data->log_buffer.size;
+    buffer.data = logger_data->format_buffer.data;
+    buffer.size = logger_data->format_buffer.size + logger_data->log_buffer.size;
 #endif
     buffer.release();
 
-    hc_delete s_logger_data;
-    s_logger_data = nullptr;
+    hc_delete logger_data;
 }
 
 #if HC_ENABLE_LOGS
@@ -97,6 +107,8 @@ void Logger::log(LogType type, const char* tag, const char* message, ...)
         return;
     }
 
+    ScopedLock<Mutex> lock(s_logger_data->log_mutex);
+
     va_list argList;
     va_start(argList, message);
 
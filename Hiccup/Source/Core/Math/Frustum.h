@@ -0,0 +1,135 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+
+#include "MathUtilities.h"
+#include "Geometry.h"
+#include "Transform.h"
+
+namespace HC
+{
+
+#pragma region Frustum
+
+enum class FrustumPlane : uint8_t
+{
+    Left = 0,
+    Right = 1,
+    Bottom = 2,
+    Top = 3,
+    Near = 4,
+    Far = 5,
+
+    MaxEnumValue
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Frustum.
+ *----------------------------------------------------------------
+ * Six planes, stored as (normal.x, normal.y, normal.z, distance), with the normals pointing inwards.
+ * A point is inside the frustum if 'dot(normal, point) + distance >= 0' for all planes.
+ */
+template<typename T>
+struct FrustumT
+{
+public:
+    Vector4T<T> planes[(uint8_t)FrustumPlane::MaxEnumValue];
+
+public:
+    /**
+     * Extracts the frustum planes from a view-projection matrix.
+     * The matrix uses the row-vector convention, with the clip-space depth in the [0, 1] range.
+     *
+     * @param view_projection The view-projection matrix.
+     *
+     * @return The frustum, with normalized planes.
+     */
+    ALWAYS_INLINE static FrustumT<T> from_matrix(const Matrix4T<T>& view_projection);
+
+public:
+    ALWAYS_INLINE bool contains_point(const Vector3T<T>& point) const;
+
+    /** @return True if the box is inside or intersects the frustum. Conservative near the frustum corners. */
+    ALWAYS_INLINE bool intersects_aabb(const AABB3T<T>& aabb) const;
+};
+
+using Frustumf  = FrustumT<float32_t>;
+using Frustumd  = FrustumT<float64_t>;
+
+using Frustum   = Frustumf;
+
+// Frustum
+#pragma endregion
+
+#pragma region Frustum Implementation
+
+template<typename T>
+ALWAYS_INLINE FrustumT<T> FrustumT<T>::from_matrix(const Matrix4T<T>& view_projection)
+{
+    const auto& m = view_projection.m;
+
+    // With row vectors, the clip coordinates are the dot products of the point with the matrix columns.
+    FrustumT<T> frustum;
+    frustum.planes[(uint8_t)FrustumPlane::Left]   = Vector4T<T>(m[0][3] + m[0][0], m[1][3] + m[1][0], m[2][3] + m[2][0], m[3][3] + m[3][0]);
+    frustum.planes[(uint8_t)FrustumPlane::Right]  = Vector4T<T>(m[0][3] - m[0][0], m[1][3] - m[1][0], m[2][3] - m[2][0], m[3][3] - m[3][0]);
+    frustum.planes[(uint8_t)FrustumPlane::Bottom] = Vector4T<T>(m[0][3] + m[0][1], m[1][3] + m[1][1], m[2][3] + m[2][1], m[3][3] + m[3][1]);
+    frustum.planes[(uint8_t)FrustumPlane::Top]    = Vector4T<T>(m[0][3] - m[0][1], m[1][3] - m[1][1], m[2][3] - m[2][1], m[3][3] - m[3][1]);
+    frustum.planes[(uint8_t)FrustumPlane::Near]   = Vector4T<T>(m[0][2],           m[1][2],           m[2][2],           m[3][2]);
+    frustum.planes[(uint8_t)FrustumPlane::Far]    = Vector4T<T>(m[0][3] - m[0][2], m[1][3] - m[1][2], m[2][3] - m[2][2], m[3][3] - m[3][2]);
+
+    for (uint8_t index = 0; index < (uint8_t)FrustumPlane::MaxEnumValue; ++index)
+    {
+        Vector4T<T>& plane = frustum.planes[index];
+        const T length = Math::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > T(0))
+        {
+            plane.x /= length;
+            plane.y /= length;
+            plane.z /= length;
+            plane.w /= length;
+        }
+    }
+
+    return frustum;
+}
+
+template<typename T>
+ALWAYS_INLINE bool FrustumT<T>::contains_point(const Vector3T<T>& point) const
+{
+    for (uint8_t index = 0; index < (uint8_t)FrustumPlane::MaxEnumValue; ++index)
+    {
+        const Vector4T<T>& plane = planes[index];
+        if (plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w < T(0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+ALWAYS_INLINE bool FrustumT<T>::intersects_aabb(const AABB3T<T>& aabb) const
+{
+    const Vector3T<T> center = (aabb.min_bound + aabb.max_bound) * T(0.5);
+    const Vector3T<T> extent = (aabb.max_bound - aabb.min_bound) * T(0.5);
+
+    for (uint8_t index = 0; index < (uint8_t)FrustumPlane::MaxEnumValue; ++index)
+    {
+        const Vector4T<T>& plane = planes[index];
+        const T distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+        const T radius = Math::abs(plane.x) * extent.x + Math::abs(plane.y) * extent.y + Math::abs(plane.z) * extent.z;
+        if (distance + radius < T(0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Frustum Implementation
+#pragma endregion
+
+} // namespace HC
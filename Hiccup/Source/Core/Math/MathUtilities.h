@@ -4,6 +4,10 @@
 
 #include "Core/CoreMinimal.h"
 
+#if HC_COMPILER_MSVC
+    #include <intrin.h>
+#endif // HC_COMPILER_MSVC
+
 namespace HC
 {
 
@@ -191,6 +195,45 @@ public:
      */
     HC_API static float32_t atan(float32_t x);
     HC_API static float64_t atan(float64_t x);
+
+public:
+    /**
+     * Finds the lowest set bit of a value. Compiles to a single 'tzcnt'/'bsf' instruction.
+     *
+     * @param value The value. Must not be zero.
+     *
+     * @return The index of the lowest set bit.
+     */
+    ALWAYS_INLINE static uint32_t count_trailing_zeros(uint64_t value)
+    {
+#if HC_COMPILER_MSVC
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return (uint32_t)index;
+#else
+        return (uint32_t)__builtin_ctzll(value);
+#endif // Compiler switch.
+    }
+
+    /**
+     * @return The number of set bits of the value.
+     * The 'popcnt' instruction isn't part of the x64 baseline, so it is only used when the build
+     *   targets AVX (all CPUs with AVX support it). Otherwise, the bits are counted in parallel.
+     */
+    ALWAYS_INLINE static uint32_t popcount(uint64_t value)
+    {
+#if HC_COMPILER_MSVC && defined(__AVX__)
+        return (uint32_t)__popcnt64(value);
+#elif HC_COMPILER_GCC_CLANG
+        // Compiles to 'popcnt' only when it is enabled ('-mpopcnt'), and to a portable sequence otherwise.
+        return (uint32_t)__builtin_popcountll(value);
+#else
+        value = value - ((value >> 1) & 0x5555555555555555);
+        value = (value & 0x3333333333333333) + ((value >> 2) & 0x3333333333333333);
+        value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0F;
+        return (uint32_t)((value * 0x0101010101010101) >> 56);
+#endif // Compiler switch.
+    }
 };
 
 // Converts kilobytes to bytes.
@@ -34,6 +34,31 @@ public:
      */
     ALWAYS_INLINE Matrix3T();
 
+    /**
+     * Copy constructor.
+     *
+     * @param other The matrix to copy.
+     */
+    ALWAYS_INLINE Matrix3T(const Matrix3T<T>& other);
+
+    /**
+     * Component constructor. The components are given row by row.
+     */
+    ALWAYS_INLINE Matrix3T(
+        T m00, T m01, T m02,
+        T m10, T m11, T m12,
+        T m20, T m21, T m22
+    );
+
+    /**
+     * Copy assignment operator.
+     *
+     * @param other The matrix to copy.
+     *
+     * @return Reference to this, after the copy.
+     */
+    ALWAYS_INLINE Matrix3T<T>& operator=(const Matrix3T<T>& other);
+
 public:
     /** @return An identity matrix. */
     ALWAYS_INLINE static Matrix3T<T> identity();
@@ -73,9 +98,95 @@ public:
      */
     ALWAYS_INLINE Matrix4T();
 
+    /**
+     * Copy constructor.
+     *
+     * @param other The matrix to copy.
+     */
+    ALWAYS_INLINE Matrix4T(const Matrix4T<T>& other);
+
+    /**
+     * Component constructor. The components are given row by row.
+     */
+    ALWAYS_INLINE Matrix4T(
+        T m00, T m01, T m02, T m03,
+        T m10, T m11, T m12, T m13,
+        T m20, T m21, T m22, T m23,
+        T m30, T m31, T m32, T m33
+    );
+
+    /**
+     * Copy assignment operator.
+     *
+     * @param other The matrix to copy.
+     *
+     * @return Reference to this, after the copy.
+     */
+    ALWAYS_INLINE Matrix4T<T>& operator=(const Matrix4T<T>& other);
+
+    /**
+     * Multiplication operator.
+     * The matrices use the row-vector convention, so 'a * b' applies 'a' first, then 'b'.
+     *
+     * @param other The right-hand side matrix.
+     *
+     * @return The product of the matrices.
+     */
+    ALWAYS_INLINE Matrix4T<T> operator*(const Matrix4T<T>& other) const;
+
+public:
+    /**
+     * Transforms a point (w = 1) by this matrix.
+     *
+     * @param point The point to transform.
+     *
+     * @return The transformed point.
+     */
+    ALWAYS_INLINE Vector3T<T> transform_point(const Vector3T<T>& point) const;
+
+    /**
+     * Transforms a direction (w = 0) by this matrix. The translation is ignored.
+     *
+     * @param direction The direction to transform.
+     *
+     * @return The transformed direction.
+     */
+    ALWAYS_INLINE Vector3T<T> transform_direction(const Vector3T<T>& direction) const;
+
+    /** @return The translation part of the matrix. */
+    ALWAYS_INLINE Vector3T<T> get_translation() const;
+
 public:
     /** @return An identity matrix. */
     ALWAYS_INLINE static Matrix4T<T> identity();
+
+    /** @return A translation matrix. */
+    ALWAYS_INLINE static Matrix4T<T> translation(const Vector3T<T>& translation);
+
+    /** @return A scale matrix. */
+    ALWAYS_INLINE static Matrix4T<T> scale(const Vector3T<T>& scale);
+
+    /**
+     * Creates a rotation matrix from Euler angles.
+     * The rotations are applied in the X, Y, Z order.
+     *
+     * @param euler_angles The rotation angles around each axis, in radians.
+     *
+     * @return The rotation matrix.
+     */
+    ALWAYS_INLINE static Matrix4T<T> rotation(const Vector3T<T>& euler_angles);
+
+    /**
+     * Creates a transform matrix that applies the scale, then the rotation, then the translation.
+     * Equivalent to 'scale(s) * rotation(r) * translation(t)', but without the full matrix products.
+     *
+     * @param translation The translation.
+     * @param euler_angles The rotation angles around each axis, in radians.
+     * @param scale The scale.
+     *
+     * @return The transform matrix.
+     */
+    ALWAYS_INLINE static Matrix4T<T> transform(const Vector3T<T>& translation, const Vector3T<T>& euler_angles, const Vector3T<T>& scale);
 };
 
 using Matrix4f  = Matrix4T<float32_t>;
@@ -95,6 +206,35 @@ ALWAYS_INLINE Matrix3T<T>::Matrix3T()
     : data{}
 {}
 
+template<typename T>
+ALWAYS_INLINE Matrix3T<T>::Matrix3T(const Matrix3T<T>& other)
+    : data{}
+{
+    for (uint8_t index = 0; index < 3 * 3; ++index)
+    {
+        data[index] = other.data[index];
+    }
+}
+
+template<typename T>
+ALWAYS_INLINE Matrix3T<T>::Matrix3T(
+    T m00, T m01, T m02,
+    T m10, T m11, T m12,
+    T m20, T m21, T m22
+)
+    : data{ m00, m01, m02, m10, m11, m12, m20, m21, m22 }
+{}
+
+template<typename T>
+ALWAYS_INLINE Matrix3T<T>& Matrix3T<T>::operator=(const Matrix3T<T>& other)
+{
+    for (uint8_t index = 0; index < 3 * 3; ++index)
+    {
+        data[index] = other.data[index];
+    }
+    return *this;
+}
+
 template<typename T>
 ALWAYS_INLINE Matrix3T<T> Matrix3T<T>::identity()
 {
@@ -113,9 +253,85 @@ ALWAYS_INLINE Matrix3T<T> Matrix3T<T>::identity()
 
 template<typename T>
 ALWAYS_INLINE Matrix4T<T>::Matrix4T()
-    : Data{}
+    : data{}
 {}
 
+template<typename T>
+ALWAYS_INLINE Matrix4T<T>::Matrix4T(const Matrix4T<T>& other)
+    : data{}
+{
+    for (uint8_t index = 0; index < 4 * 4; ++index)
+    {
+        data[index] = other.data[index];
+    }
+}
+
+template<typename T>
+ALWAYS_INLINE Matrix4T<T>::Matrix4T(
+    T m00, T m01, T m02, T m03,
+    T m10, T m11, T m12, T m13,
+    T m20, T m21, T m22, T m23,
+    T m30, T m31, T m32, T m33
+)
+    : data{ m00, m01, m02, m03, m10, m11, m12, m13, m20, m21, m22, m23, m30, m31, m32, m33 }
+{}
+
+template<typename T>
+ALWAYS_INLINE Matrix4T<T>& Matrix4T<T>::operator=(const Matrix4T<T>& other)
+{
+    for (uint8_t index = 0; index < 4 * 4; ++index)
+    {
+        data[index] = other.data[index];
+    }
+    return *this;
+}
+
+template<typename T>
+ALWAYS_INLINE Matrix4T<T> Matrix4T<T>::operator*(const Matrix4T<T>& other) const
+{
+    Matrix4T<T> result;
+    for (uint8_t row = 0; row < 4; ++row)
+    {
+        for (uint8_t column = 0; column < 4; ++column)
+        {
+            result.m[row][column] =
+                m[row][0] * other.m[0][column] +
+                m[row][1] * other.m[1][column] +
+                m[row][2] * other.m[2][column] +
+                m[row][3] * other.m[3][column];
+        }
+    }
+    return result;
+}
+
+template<typename T>
+ALWAYS_INLINE Vector3T<T> Matrix4T<T>::transform_point(const Vector3T<T>& point) const
+{
+    return Vector3T<T>
+    (
+        point.x * m[0][0] + point.y * m[1][0] + point.z * m[2][0] + m[3][0],
+        point.x * m[0][1] + point.y * m[1][1] + point.z * m[2][1] + m[3][1],
+        point.x * m[0][2] + point.y * m[1][2] + point.z * m[2][2] + m[3][2]
+    );
+}
+
+template<typename T>
+ALWAYS_INLINE Vector3T<T> Matrix4T<T>::transform_direction(const Vector3T<T>& direction) const
+{
+    return Vector3T<T>
+    (
+        direction.x * m[0][0] + direction.y * m[1][0] + direction.z * m[2][0],
+        direction.x * m[0][1] + direction.y * m[1][1] + direction.z * m[2][1],
+        direction.x * m[0][2] + direction.y * m[1][2] + direction.z * m[2][2]
+    );
+}
+
+template<typename T>
+ALWAYS_INLINE Vector3T<T> Matrix4T<T>::get_translation() const
+{
+    return Vector3T<T>(m[3][0], m[3][1], m[3][2]);
+}
+
 template<typename T>
 ALWAYS_INLINE Matrix4T<T> Matrix4T<T>::identity()
 {
@@ -128,6 +344,68 @@ ALWAYS_INLINE Matrix4T<T> Matrix4T<T>::identity()
     );
 }
 
+template<typename T>
+ALWAYS_INLINE Matrix4T<T> Matrix4T<T>::translation(const Vector3T<T>& translation)
+{
+    return Matrix4T<T>
+    (
+        T(1),          T(0),          T(0),          T(0),
+        T(0),          T(1),          T(0),          T(0),
+        T(0),          T(0),          T(1),          T(0),
+        translation.x, translation.y, translation.z, T(1)
+    );
+}
+
+template<typename T>
+ALWAYS_INLINE Matrix4T<T> Matrix4T<T>::scale(const Vector3T<T>& scale)
+{
+    return Matrix4T<T>
+    (
+        scale.x, T(0),    T(0),    T(0),
+        T(0),    scale.y, T(0),    T(0),
+        T(0),    T(0),    scale.z, T(0),
+        T(0),    T(0),    T(0),    T(1)
+    );
+}
+
+template<typename T>
+ALWAYS_INLINE Matrix4T<T> Matrix4T<T>::rotation(const Vector3T<T>& euler_angles)
+{
+    const T sx = Math::sin(euler_angles.x);
+    const T cx = Math::cos(euler_angles.x);
+    const T sy = Math::sin(euler_angles.y);
+    const T cy = Math::cos(euler_angles.y);
+    const T sz = Math::sin(euler_angles.z);
+    const T cz = Math::cos(euler_angles.z);
+
+    // Rx * Ry * Rz, expanded.
+    return Matrix4T<T>
+    (
+        cy * cz,                  cy * sz,                  -sy,     T(0),
+        sx * sy * cz - cx * sz,   sx * sy * sz + cx * cz,   sx * cy, T(0),
+        cx * sy * cz + sx * sz,   cx * sy * sz - sx * cz,   cx * cy, T(0),
+        T(0),                     T(0),                     T(0),    T(1)
+    );
+}
+
+template<typename T>
+ALWAYS_INLINE Matrix4T<T> Matrix4T<T>::transform(const Vector3T<T>& translation, const Vector3T<T>& euler_angles, const Vector3T<T>& scale)
+{
+    // Scaling the rows of the rotation matrix is equivalent to pre-multiplying by the scale matrix.
+    Matrix4T<T> result = rotation(euler_angles);
+    for (uint8_t column = 0; column < 3; ++column)
+    {
+        result.m[0][column] *= scale.x;
+        result.m[1][column] *= scale.y;
+        result.m[2][column] *= scale.z;
+    }
+
+    result.m[3][0] = translation.x;
+    result.m[3][1] = translation.y;
+    result.m[3][2] = translation.z;
+    return result;
+}
+
 // Matrix4 Implementation
 #pragma endregion
 
@@ -0,0 +1,260 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "GuardedAllocator.h"
+
+#include "Core/Platform/Platform.h"
+#include "Core/Threading/Mutex.h"
+
+namespace HC
+{
+
+// Stored right before each block. Used to validate the frees and to find the pages of the block.
+struct GuardedBlockHeader
+{
+    uint32_t magic;
+    uint32_t pages_count;
+    uint64_t bytes_count;
+};
+
+static_assert(sizeof(GuardedBlockHeader) == GuardedAllocator::Alignment, "The header must preserve the block alignment!");
+
+static constexpr uint32_t GuardedBlockMagic = 0x47415244;
+
+// A range of pages, identified by the index of its first page (relative to the region base).
+// The pages count includes the trailing guard page.
+struct GuardedRange
+{
+    uint32_t first_page;
+    uint32_t pages_count;
+};
+
+// Growable stack of page indices. The storage comes directly from the platform, as the
+//   allocator is used to implement the memory system itself.
+struct PageIndexStack
+{
+    uint32_t* data = nullptr;
+    uint32_t count = 0;
+    uint32_t capacity = 0;
+
+    // Returns false if the storage can't grow. The value is not pushed in that case.
+    bool push(uint32_t value)
+    {
+        if (count == capacity)
+        {
+            const uint32_t new_capacity = (capacity > 0) ? capacity * 2 : 64;
+            uint32_t* new_data = (uint32_t*)Platform::allocate_memory(new_capacity * sizeof(uint32_t));
+            if (!new_data)
+            {
+                return false;
+            }
+
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                new_data[index] = data[index];
+            }
+            Platform::free_memory(data);
+            data = new_data;
+            capacity = new_capacity;
+        }
+        data[count++] = value;
+        return true;
+    }
+};
+
+struct GuardedAllocatorData
+{
+    Mutex lock;
+
+    uint8_t* region_base = nullptr;
+    size_t region_size = 0;
+    size_t page_size = 0;
+
+    // The index of the first page that was never used.
+    uint32_t next_page = 0;
+    uint32_t total_pages_count = 0;
+    size_t committed_pages_count = 0;
+
+    // Ring buffer of the freed ranges that are still in quarantine.
+    GuardedRange* quarantine = nullptr;
+    uint32_t quarantine_capacity = 0;
+    uint32_t quarantine_head = 0;
+    uint32_t quarantine_count = 0;
+
+    // The ranges that left the quarantine, by pages count.
+    PageIndexStack free_ranges[GuardedAllocator::MaxReusablePagesCount + 1];
+};
+
+// Never destroyed - see the comment in the header.
+static_internal GuardedAllocatorData* s_guarded_data = nullptr;
+
+bool GuardedAllocator::initialize(size_t reserve_size, uint32_t quarantine_count)
+{
+    if (s_guarded_data)
+    {
+        return true;
+    }
+
+    GuardedAllocatorData* data = (GuardedAllocatorData*)Platform::allocate_memory(sizeof(GuardedAllocatorData));
+    if (!data)
+    {
+        return false;
+    }
+    new (data) GuardedAllocatorData();
+
+    data->page_size = Platform::get_page_size();
+    data->region_size = (reserve_size / data->page_size) * data->page_size;
+    data->total_pages_count = (uint32_t)Math::min<size_t>(data->region_size / data->page_size, 0xFFFFFFFF);
+    data->region_base = (uint8_t*)Platform::reserve_memory(data->region_size);
+    if (!data->region_base)
+    {
+        data->~GuardedAllocatorData();
+        Platform::free_memory(data);
+        return false;
+    }
+
+    data->quarantine_capacity = Math::max<uint32_t>(quarantine_count, 1);
+    data->quarantine = (GuardedRange*)Platform::allocate_memory(data->quarantine_capacity * sizeof(GuardedRange));
+    if (!data->quarantine)
+    {
+        Platform::release_memory(data->region_base, data->region_size);
+        data->~GuardedAllocatorData();
+        Platform::free_memory(data);
+        return false;
+    }
+
+    s_guarded_data = data;
+    return true;
+}
+
+bool GuardedAllocator::is_initialized()
+{
+    return s_guarded_data != nullptr;
+}
+
+void* GuardedAllocator::allocate(size_t bytes_count)
+{
+    HC_ASSERT(s_guarded_data); // The guarded allocator is not initialized!
+
+    const size_t page_size = s_guarded_data->page_size;
+    const size_t aligned_bytes_count = (bytes_count + Alignment - 1) & ~(Alignment - 1);
+    const uint32_t data_pages_count = (uint32_t)((aligned_bytes_count + sizeof(GuardedBlockHeader) + page_size - 1) / page_size);
+    const uint32_t pages_count = data_pages_count + 1;
+
+    uint32_t first_page = 0;
+    bool has_range = false;
+    {
+        ScopedLock<Mutex> lock(s_guarded_data->lock);
+
+        if (pages_count <= MaxReusablePagesCount && s_guarded_data->free_ranges[pages_count].count > 0)
+        {
+            PageIndexStack& free_ranges = s_guarded_data->free_ranges[pages_count];
+            first_page = free_ranges.data[--free_ranges.count];
+            has_range = true;
+        }
+        else if (s_guarded_data->next_page + pages_count <= s_guarded_data->total_pages_count)
+        {
+            first_page = s_guarded_data->next_page;
+            s_guarded_data->next_page += pages_count;
+            has_range = true;
+        }
+
+        if (has_range)
+        {
+            s_guarded_data->committed_pages_count += data_pages_count;
+        }
+    }
+
+    // Logging outside of the lock, as the logger might allocate memory.
+    if (!has_range)
+    {
+        HC_LOG_ERROR("GuardedAllocator::allocate - The guarded address range is exhausted!");
+        return nullptr;
+    }
+
+    // The guard page is never committed, so it stays inaccessible.
+    uint8_t* pages = s_guarded_data->region_base + (size_t)first_page * page_size;
+    if (!Platform::commit_memory(pages, (size_t)data_pages_count * page_size))
+    {
+        // Giving the range back. It was never used, so it skips the quarantine.
+        {
+            ScopedLock<Mutex> lock(s_guarded_data->lock);
+            s_guarded_data->committed_pages_count -= data_pages_count;
+
+            if (first_page + pages_count == s_guarded_data->next_page)
+            {
+                s_guarded_data->next_page = first_page;
+            }
+            else if (pages_count <= MaxReusablePagesCount)
+            {
+                s_guarded_data->free_ranges[pages_count].push(first_page);
+            }
+        }
+
+        HC_LOG_ERROR("GuardedAllocator::allocate - Failed to commit memory! The system might be out of memory.");
+        return nullptr;
+    }
+
+    uint8_t* memory_block = pages + (size_t)data_pages_count * page_size - aligned_bytes_count;
+    GuardedBlockHeader* header = (GuardedBlockHeader*)(memory_block - sizeof(GuardedBlockHeader));
+    header->magic = GuardedBlockMagic;
+    header->pages_count = pages_count;
+    header->bytes_count = bytes_count;
+
+    return memory_block;
+}
+
+void GuardedAllocator::free(void* memory_block)
+{
+    HC_ASSERT(owns(memory_block)); // The block wasn't allocated by the guarded allocator!
+
+    GuardedBlockHeader* header = (GuardedBlockHeader*)((uint8_t*)memory_block - sizeof(GuardedBlockHeader));
+    HC_ASSERT(header->magic == GuardedBlockMagic); // Corrupted block header! Possible underrun or double free.
+
+    const size_t page_size = s_guarded_data->page_size;
+    const size_t block_offset = (size_t)((uint8_t*)header - s_guarded_data->region_base);
+
+    GuardedRange range;
+    range.first_page = (uint32_t)(block_offset / page_size);
+    range.pages_count = header->pages_count;
+
+    // Clearing the magic, so a double free is detected even if the pages are reused.
+    header->magic = 0;
+
+    const uint32_t data_pages_count = range.pages_count - 1;
+    Platform::decommit_memory(s_guarded_data->region_base + (size_t)range.first_page * page_size, (size_t)data_pages_count * page_size);
+
+    ScopedLock<Mutex> lock(s_guarded_data->lock);
+    s_guarded_data->committed_pages_count -= data_pages_count;
+
+    // Evicting the oldest range from the quarantine, making its pages available again.
+    if (s_guarded_data->quarantine_count == s_guarded_data->quarantine_capacity)
+    {
+        // If the free list can't grow, the pages of the evicted range are never reused.
+        const GuardedRange& evicted = s_guarded_data->quarantine[s_guarded_data->quarantine_head];
+        if (evicted.pages_count <= MaxReusablePagesCount)
+        {
+            s_guarded_data->free_ranges[evicted.pages_count].push(evicted.first_page);
+        }
+
+        s_guarded_data->quarantine_head = (s_guarded_data->quarantine_head + 1) % s_guarded_data->quarantine_capacity;
+        --s_guarded_data->quarantine_count;
+    }
+
+    const uint32_t tail = (s_guarded_data->quarantine_head + s_guarded_data->quarantine_count) % s_guarded_data->quarantine_capacity;
+    s_guarded_data->quarantine[tail] = range;
+    ++s_guarded_data->quarantine_count;
+}
+
+bool GuardedAllocator::owns(const void* memory_block)
+{
+    return s_guarded_data &&
+        (const uint8_t*)memory_block >= s_guarded_data->region_base &&
+        (const uint8_t*)memory_block < s_guarded_data->region_base + s_guarded_data->region_size;
+}
+
+size_t GuardedAllocator::get_committed_pages_count()
+{
+    return s_guarded_data ? s_guarded_data->committed_pages_count : 0;
+}
+
+} // namespace HC
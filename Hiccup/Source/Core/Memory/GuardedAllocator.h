@@ -0,0 +1,56 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Guarded Allocator.
+ *----------------------------------------------------------------
+ * Debug allocator that detects buffer overruns and use-after-free bugs, by relying on the
+ *   hardware memory protection, with much less overhead than a full address sanitizer.
+ *
+ * Each block gets its own pages, and is placed flush against an inaccessible guard page, so
+ *   writing past its end faults immediately. The block end is aligned to 'Alignment' bytes, so
+ *   overruns smaller than the alignment padding are not detected.
+ * Freed pages are decommitted and kept in quarantine, so accessing a freed block faults as well.
+ *   After the quarantine window, their address range is reused for blocks of the same size.
+ *
+ * All blocks are allocated from a single reserved address range, so determining whether a
+ *   block belongs to the allocator is a simple range check. The range is only released when
+ *   the process exits, as blocks can be freed by static destructors, after the memory system shutdown.
+ */
+class GuardedAllocator
+{
+public:
+    // The alignment of the returned blocks.
+    static constexpr size_t Alignment = 16;
+
+    // Ranges of up to this number of pages are reused after they leave the quarantine.
+    static constexpr uint32_t MaxReusablePagesCount = 64;
+
+public:
+    /**
+     * @param reserve_size The size of the address range reserved for the allocator.
+     * @param quarantine_count The number of freed blocks kept inaccessible before their pages are reused.
+     */
+    static bool initialize(size_t reserve_size, uint32_t quarantine_count);
+
+    static bool is_initialized();
+
+public:
+    static void* allocate(size_t bytes_count);
+    static void free(void* memory_block);
+
+    /** @return True if the memory block was allocated by the guarded allocator. */
+    static bool owns(const void* memory_block);
+
+    /** @return The number of pages currently committed by the allocator, including the header space. */
+    static size_t get_committed_pages_count();
+};
+
+} // namespace HC
@@ -1,10 +1,17 @@
 // Copyright (c) 2022-2023 Avram Traian. All rights reserved.
 
 #include "Memory.h"
+#include "GuardedAllocator.h"
 
 #include "Core/Platform/Platform.h"
+#include "Core/Algorithms/Sort.h"
+#include "Core/Containers/Array.h"
 #include "Core/Containers/HashTable.h"
+#include "Core/Threading/Atomic.h"
+#include "Core/Threading/Mutex.h"
 
+#include <cstdarg>
+#include <cstdio>
 #include <cstring>
 
 namespace HC
@@ -16,17 +23,47 @@ struct MemoryData
 };
 static_internal MemoryData* s_memory_data = nullptr;
 
+// Cached outside of the memory data, as it is checked on every allocation.
+static_internal bool s_use_guarded_allocator = false;
+
+// Outlives the memory data, so the result can be queried after the shutdown.
+static_internal bool s_has_failed_leak_check = false;
+
+static_internal void release_memory_data()
+{
+    s_memory_data->~MemoryData();
+    Platform::free_memory(s_memory_data);
+    s_memory_data = nullptr;
+}
+
 bool Memory::initialize(const MemoryDescription& description)
 {
     s_memory_data = (MemoryData*)Platform::allocate_memory(sizeof(MemoryData));
+    if (!s_memory_data)
+    {
+        return false;
+    }
     new (s_memory_data) MemoryData();
 
     s_memory_data->description = description;
 
+    if (s_memory_data->description.use_guarded_allocator)
+    {
+        if (!GuardedAllocator::initialize(description.guarded_allocator_reserve_size, description.guarded_allocator_quarantine_count))
+        {
+            release_memory_data();
+            return false;
+        }
+        s_use_guarded_allocator = true;
+    }
+
 #if HC_ENABLE_MEMORY_TRACKING
-    if (s_memory_data->description.should_initialize_tracker)
+    if (s_memory_data->description.should_initialize_tracker && !Tracker::initialize())
     {
-        return Tracker::initialize();
+        // The guarded allocator stays initialized, as it is never shut down.
+        s_use_guarded_allocator = false;
+        release_memory_data();
+        return false;
     }
 #endif // HC_ENABLE_MEMORY_TRACKING
 
@@ -38,13 +75,24 @@ void Memory::shutdown()
 #if HC_ENABLE_MEMORY_TRACKING
     if (Tracker::is_active())
     {
+        // The leaks are counted even when they aren't reported, so 'should_fail_on_leaks' works on its own.
+        const size_t leaks_count = s_memory_data->description.should_report_leaks ?
+            Tracker::report_leaks(s_memory_data->description.leak_report_json_filepath) : Tracker::get_current_allocations_count();
+        s_has_failed_leak_check = (leaks_count > 0) && s_memory_data->description.should_fail_on_leaks;
+
         Tracker::shutdown();
     }
 #endif // HC_ENABLE_MEMORY_TRACKING
 
-    s_memory_data->~MemoryData();
-    Platform::free_memory(s_memory_data);
-    s_memory_data = nullptr;
+    // The guarded allocator is never shut down, as its blocks can still be freed after this point.
+    s_use_guarded_allocator = false;
+
+    release_memory_data();
+}
+
+bool Memory::has_failed_leak_check()
+{
+    return s_has_failed_leak_check;
 }
 
 void Memory::copy(void* detination, const void* source, size_t bytes_count)
@@ -69,6 +117,11 @@ void* Memory::allocate_raw(size_t bytes_count)
         return nullptr;
     }
 
+    if (s_use_guarded_allocator)
+    {
+        return GuardedAllocator::allocate(bytes_count);
+    }
+
     return Platform::allocate_memory(bytes_count);
 }
 
@@ -108,9 +161,80 @@ void* Memory::allocate_tagged(size_t bytes_count, const char* filename, const ch
 
 void Memory::free_raw(void* memory_block)
 {
+    // Blocks allocated before the memory system was initialized come from the platform, even
+    //   if the guarded allocator is used.
+    if (GuardedAllocator::owns(memory_block))
+    {
+        GuardedAllocator::free(memory_block);
+        return;
+    }
+
     Platform::free_memory(memory_block);
 }
 
+void* Memory::allocate_on_numa_node(size_t bytes_count, uint32_t numa_node)
+{
+    if (bytes_count == 0)
+    {
+        return nullptr;
+    }
+
+    return Platform::reserve_and_commit_memory_on_node(bytes_count, numa_node);
+}
+
+void Memory::free_on_numa_node(void* memory_block, size_t bytes_count)
+{
+    if (!memory_block)
+    {
+        return;
+    }
+
+    Platform::release_memory(memory_block, bytes_count);
+}
+
+// The maximum number of nested tag scopes on a thread.
+static constexpr uint32_t MaxMemoryTagStackDepth = 32;
+
+struct MemoryTagStack
+{
+    MemoryTag tags[MaxMemoryTagStackDepth];
+    uint32_t depth;
+};
+static_internal thread_local MemoryTagStack t_memory_tag_stack = {};
+
+void Memory::push_tag(MemoryTag tag)
+{
+    HC_ASSERT(t_memory_tag_stack.depth < MaxMemoryTagStackDepth); // Memory tag stack overflow!
+    t_memory_tag_stack.tags[t_memory_tag_stack.depth++] = tag;
+}
+
+void Memory::pop_tag()
+{
+    HC_ASSERT(t_memory_tag_stack.depth > 0); // Memory tag stack underflow!
+    --t_memory_tag_stack.depth;
+}
+
+MemoryTag Memory::get_current_tag()
+{
+    return (t_memory_tag_stack.depth > 0) ? t_memory_tag_stack.tags[t_memory_tag_stack.depth - 1] : MemoryTag::Unknown;
+}
+
+const char* Memory::get_tag_name(MemoryTag tag)
+{
+    switch (tag)
+    {
+        case MemoryTag::Unknown:    return "Unknown";
+        case MemoryTag::Containers: return "Containers";
+        case MemoryTag::Logger:     return "Logger";
+        case MemoryTag::FileSystem: return "FileSystem";
+        case MemoryTag::Assets:     return "Assets";
+        case MemoryTag::ECS:        return "ECS";
+        case MemoryTag::Rendering:  return "Rendering";
+        case MemoryTag::Editor:     return "Editor";
+        default:                    return "Invalid";
+    }
+}
+
 void Memory::free(void* memory_block)
 {
     if (!memory_block)
@@ -138,8 +262,71 @@ struct AllocationInfo
     const char* filename;
     const char* function_sig;
     uint32_t      line_number;
+    MemoryTag     tag;
+};
+
+// The counters are updated outside of the tracker lock, so reading the statistics never blocks.
+struct MemoryTagData
+{
+    Atomic<size_t> current_allocated;
+    Atomic<size_t> peak_allocated;
+    Atomic<size_t> current_allocations_count;
+    Atomic<size_t> frame_allocated;
+    Atomic<size_t> frame_deallocated;
+
+    Atomic<size_t> budget;
+    Atomic<uint8_t> budget_policy;
+
+    // Set while the tag is over its budget, so the policy is only applied once per overrun.
+    Atomic<bool> is_over_budget;
+
+    MemoryTagStatistics frame_snapshot;
 };
 
+// Statically allocated, so the budgets can be set before the tracker is initialized.
+static_internal MemoryTagData s_memory_tag_data[(uint8_t)MemoryTag::Count];
+
+static_internal void register_tag_allocation(MemoryTag tag, size_t bytes_count)
+{
+    MemoryTagData& tag_data = s_memory_tag_data[(uint8_t)tag];
+
+    const size_t current_allocated = tag_data.current_allocated.fetch_add(bytes_count, MemoryOrder::Relaxed) + bytes_count;
+    tag_data.current_allocations_count.fetch_add(1, MemoryOrder::Relaxed);
+    tag_data.frame_allocated.fetch_add(bytes_count, MemoryOrder::Relaxed);
+
+    size_t peak_allocated = tag_data.peak_allocated.load(MemoryOrder::Relaxed);
+    while (current_allocated > peak_allocated && !tag_data.peak_allocated.compare_exchange(peak_allocated, current_allocated, MemoryOrder::Relaxed))
+    {}
+
+    const size_t budget = tag_data.budget.load(MemoryOrder::Relaxed);
+    if (budget == 0 || current_allocated <= budget || tag_data.is_over_budget.exchange(true, MemoryOrder::Relaxed))
+    {
+        return;
+    }
+
+    // Must be called outside of the tracker lock, as the logger might allocate memory.
+    HC_LOG_WARN("Memory::Tracker - The '%s' memory tag exceeded its budget (%llu / %llu bytes)!",
+        Memory::get_tag_name(tag), (unsigned long long)current_allocated, (unsigned long long)budget);
+
+    const bool is_budget_exceeded = (MemoryBudgetPolicy)tag_data.budget_policy.load(MemoryOrder::Relaxed) == MemoryBudgetPolicy::Assert;
+    HC_ASSERT(!is_budget_exceeded); // Memory budget exceeded!
+}
+
+static_internal void register_tag_deallocation(MemoryTag tag, size_t bytes_count)
+{
+    MemoryTagData& tag_data = s_memory_tag_data[(uint8_t)tag];
+
+    const size_t current_allocated = tag_data.current_allocated.fetch_sub(bytes_count, MemoryOrder::Relaxed) - bytes_count;
+    tag_data.current_allocations_count.fetch_sub(1, MemoryOrder::Relaxed);
+    tag_data.frame_deallocated.fetch_add(bytes_count, MemoryOrder::Relaxed);
+
+    const size_t budget = tag_data.budget.load(MemoryOrder::Relaxed);
+    if (current_allocated <= budget)
+    {
+        tag_data.is_over_budget.store(false, MemoryOrder::Relaxed);
+    }
+}
+
 struct MemoryTrackerData
 {
     size_t allocated             = 0;
@@ -148,6 +335,9 @@ struct MemoryTrackerData
     size_t deallocations_count   = 0;
 
     UntrackedHashTable<void*, AllocationInfo> allocations_table;
+
+    // Allocations happen on any thread, including the ones that initialize the subsystems in parallel.
+    Mutex lock;
 };
 static_internal MemoryTrackerData* s_tracker_data = nullptr;
 
@@ -208,6 +398,8 @@ size_t Memory::Tracker::get_current_allocations_count()
 
 void Memory::Tracker::log_memory_usage()
 {
+    ScopedLock<Mutex> lock(s_tracker_data->lock);
+
     s_tracker_data->allocations_table.for_each([](void* memory_block, const AllocationInfo& allocation) -> bool
         {
             HC_LOG_DEBUG("Allocation [%p]:", memory_block);
@@ -219,42 +411,325 @@ void Memory::Tracker::log_memory_usage()
         });
 }
 
+struct LeakCallsite
+{
+    const char* filename = nullptr;
+    const char* function_sig = nullptr;
+    uint32_t line_number = 0;
+
+    size_t bytes_count = 0;
+    size_t allocations_count = 0;
+};
+
+// The maximum number of callsites written to the console. The JSON report contains all of them.
+static constexpr size_t MaxConsoleLeakCallsites = 32;
+
+static_internal void write_leak_report_line(const char* format, ...)
+{
+    char line[1024];
+
+    va_list arg_list;
+    va_start(arg_list, format);
+    const int line_length = vsnprintf(line, sizeof(line), format, arg_list);
+    va_end(arg_list);
+
+    if (line_length > 0)
+    {
+        Platform::write_to_console(line, Math::min<size_t>((size_t)line_length, sizeof(line) - 1));
+    }
+}
+
+static_internal void append_json(Array<char, UntrackedAllocator>& json, const char* string)
+{
+    const size_t length = std::strlen(string);
+    const size_t offset = json.add_uninitialized(length);
+    Memory::copy(json.data() + offset, string, length);
+}
+
+static_internal void append_json_string(Array<char, UntrackedAllocator>& json, const char* string)
+{
+    json.add('"');
+    for (const char* character = string ? string : "Unknown"; *character; ++character)
+    {
+        if (*character == '"' || *character == '\\')
+        {
+            json.add('\\');
+        }
+        json.add(*character);
+    }
+    json.add('"');
+}
+
+static_internal void write_leak_report_json(const char* json_filepath, const Array<LeakCallsite, UntrackedAllocator>& callsites, size_t leaked_bytes, size_t leaks_count)
+{
+    Array<char, UntrackedAllocator> json;
+    char number[64];
+
+    append_json(json, "{\n    \"leaked_bytes\": ");
+    snprintf(number, sizeof(number), "%llu", (unsigned long long)leaked_bytes);
+    append_json(json, number);
+    append_json(json, ",\n    \"leaked_allocations\": ");
+    snprintf(number, sizeof(number), "%llu", (unsigned long long)leaks_count);
+    append_json(json, number);
+    append_json(json, ",\n    \"callsites\": [");
+
+    for (size_t index = 0; index < callsites.size(); ++index)
+    {
+        const LeakCallsite& callsite = callsites[index];
+
+        append_json(json, (index > 0) ? ",\n        { \"file\": " : "\n        { \"file\": ");
+        append_json_string(json, callsite.filename);
+        append_json(json, ", \"function\": ");
+        append_json_string(json, callsite.function_sig);
+        snprintf(number, sizeof(number), ", \"line\": %u", callsite.line_number);
+        append_json(json, number);
+        snprintf(number, sizeof(number), ", \"bytes\": %llu", (unsigned long long)callsite.bytes_count);
+        append_json(json, number);
+        snprintf(number, sizeof(number), ", \"allocations\": %llu }", (unsigned long long)callsite.allocations_count);
+        append_json(json, number);
+    }
+    append_json(json, "\n    ]\n}\n");
+
+    Platform::FileHandle file = Platform::open_file(json_filepath, std::strlen(json_filepath), Platform::FileAccess::Write, Platform::FileOpenMode::CreateAlways, Platform::AccessHint::Sequential);
+    if (!file)
+    {
+        write_leak_report_line("Memory leak report - Failed to open '%s' for writing!\n", json_filepath);
+        return;
+    }
+
+    if (!Platform::write_file(file, 0, json.data(), json.size()))
+    {
+        write_leak_report_line("Memory leak report - Failed to write the report to '%s'!\n", json_filepath);
+    }
+    Platform::close_file(file);
+}
+
+size_t Memory::Tracker::report_leaks(const char* json_filepath)
+{
+    Array<LeakCallsite, UntrackedAllocator> callsites;
+    size_t leaked_bytes = 0;
+    size_t leaks_count = 0;
+    {
+        ScopedLock<Mutex> lock(s_tracker_data->lock);
+
+        // Maps a callsite to its index in the callsites array.
+        UntrackedHashTable<uint64_t, size_t> callsite_indices;
+
+        s_tracker_data->allocations_table.for_each([&](void* memory_block, const AllocationInfo& allocation) -> bool
+            {
+                // The filename and function signature are string literals, so their addresses identify them.
+                const uint64_t callsite_key =
+                    ((uint64_t)(uintptr_t)allocation.filename * 0x9E3779B97F4A7C15ull) ^
+                    ((uint64_t)(uintptr_t)allocation.function_sig * 0xC2B2AE3D27D4EB4Full) ^
+                    (uint64_t)allocation.line_number;
+
+                size_t callsite_index = callsite_indices.find(callsite_key);
+                if (callsite_index == UntrackedHashTable<uint64_t, size_t>::EndOfTable)
+                {
+                    LeakCallsite& callsite = callsites.add(LeakCallsite());
+                    callsite.filename = allocation.filename;
+                    callsite.function_sig = allocation.function_sig;
+                    callsite.line_number = allocation.line_number;
+                    callsite_indices.insert(callsite_key, callsites.size() - 1);
+                    callsite_index = callsites.size() - 1;
+                }
+                else
+                {
+                    callsite_index = callsite_indices.at_index(callsite_index);
+                }
+
+                callsites[callsite_index].bytes_count += allocation.bytes_count;
+                callsites[callsite_index].allocations_count++;
+                leaked_bytes += allocation.bytes_count;
+                leaks_count++;
+                return true;
+            });
+    }
+
+    if (leaks_count == 0)
+    {
+        return 0;
+    }
+
+    // Sorting the callsites by the number of leaked bytes, in descending order. The sort isn't stable, so callsites that
+    //   leaked the same number of bytes are ordered by their location, keeping the reports comparable between runs.
+    Sort::sort(callsites.span(), [](const LeakCallsite& a, const LeakCallsite& b) -> bool
+        {
+            if (a.bytes_count != b.bytes_count)
+            {
+                return a.bytes_count > b.bytes_count;
+            }
+
+            // The unknown callsite has no filename and is placed last.
+            if (!a.filename || !b.filename)
+            {
+                return a.filename && !b.filename;
+            }
+
+            const int filename_order = std::strcmp(a.filename, b.filename);
+            if (filename_order != 0)
+            {
+                return filename_order < 0;
+            }
+
+            if (a.line_number != b.line_number)
+            {
+                return a.line_number < b.line_number;
+            }
+
+            return std::strcmp(a.function_sig, b.function_sig) < 0;
+        });
+
+    Platform::set_console_color(Platform::ConsoleColor::LightRed, Platform::ConsoleColor::Black);
+    write_leak_report_line("Memory leak report - %llu bytes leaked by %llu allocations, from %llu callsites:\n",
+        (unsigned long long)leaked_bytes, (unsigned long long)leaks_count, (unsigned long long)callsites.size());
+
+    for (size_t index = 0; index < Math::min(callsites.size(), MaxConsoleLeakCallsites); ++index)
+    {
+        const LeakCallsite& callsite = callsites[index];
+        if (callsite.filename)
+        {
+            write_leak_report_line("    %10llu bytes in %6llu allocations - %s(%u): %s\n",
+                (unsigned long long)callsite.bytes_count, (unsigned long long)callsite.allocations_count,
+                callsite.filename, callsite.line_number, callsite.function_sig);
+        }
+        else
+        {
+            write_leak_report_line("    %10llu bytes in %6llu allocations - Unknown callsite\n",
+                (unsigned long long)callsite.bytes_count, (unsigned long long)callsite.allocations_count);
+        }
+    }
+
+    if (callsites.size() > MaxConsoleLeakCallsites)
+    {
+        write_leak_report_line("    ... and %llu more callsites.\n", (unsigned long long)(callsites.size() - MaxConsoleLeakCallsites));
+    }
+    Platform::set_console_color(Platform::ConsoleColor::White, Platform::ConsoleColor::Black);
+
+    if (json_filepath)
+    {
+        write_leak_report_json(json_filepath, callsites, leaked_bytes, leaks_count);
+    }
+
+    return leaks_count;
+}
+
 void Memory::Tracker::register_allocation(void* memory_block, size_t bytes_count)
 {
-    s_tracker_data->allocated += bytes_count;
-    s_tracker_data->allocations_count++;
+    const MemoryTag tag = Memory::get_current_tag();
+    {
+        ScopedLock<Mutex> lock(s_tracker_data->lock);
 
-    // TODO(Traian): Maybe have a separate table for allocation sizes?
-    //   Seems a bit wasteful to have a full 'AllocationInfo' used for only a 'size_t'.
-    AllocationInfo allocation = {};
-    allocation.bytes_count = bytes_count;
+        s_tracker_data->allocated += bytes_count;
+        s_tracker_data->allocations_count++;
 
-    s_tracker_data->allocations_table.insert(memory_block, Types::move(allocation));
+        // TODO(Traian): Maybe have a separate table for allocation sizes?
+        //   Seems a bit wasteful to have a full 'AllocationInfo' used for only a 'size_t'.
+        AllocationInfo allocation = {};
+        allocation.bytes_count = bytes_count;
+        allocation.tag = tag;
+
+        s_tracker_data->allocations_table.insert(memory_block, Types::move(allocation));
+    }
+    register_tag_allocation(tag, bytes_count);
 }
 
 void Memory::Tracker::register_tagged_allocation(void* memory_block, size_t bytes_count, const char* filename, const char* function_sig, uint32_t line_number)
 {
-    s_tracker_data->allocated += bytes_count;
-    s_tracker_data->allocations_count++;
+    const MemoryTag tag = Memory::get_current_tag();
+    {
+        ScopedLock<Mutex> lock(s_tracker_data->lock);
 
-    AllocationInfo allocation = {};
-    allocation.bytes_count = bytes_count;
-    allocation.filename = filename;
-    allocation.function_sig = function_sig;
-    allocation.line_number = line_number;
+        s_tracker_data->allocated += bytes_count;
+        s_tracker_data->allocations_count++;
 
-    s_tracker_data->allocations_table.insert(memory_block, Types::move(allocation));
+        AllocationInfo allocation = {};
+        allocation.bytes_count = bytes_count;
+        allocation.filename = filename;
+        allocation.function_sig = function_sig;
+        allocation.line_number = line_number;
+        allocation.tag = tag;
+
+        s_tracker_data->allocations_table.insert(memory_block, Types::move(allocation));
+    }
+    register_tag_allocation(tag, bytes_count);
 }
 
 void Memory::Tracker::register_deallocation(void* memory_block)
 {
-    const size_t allocationIndex = s_tracker_data->allocations_table.find_existing_index(memory_block);
-    const AllocationInfo& allocation = s_tracker_data->allocations_table.at_index(allocationIndex);
+    MemoryTag tag;
+    size_t bytes_count;
+    {
+        ScopedLock<Mutex> lock(s_tracker_data->lock);
+
+        const size_t allocationIndex = s_tracker_data->allocations_table.find_existing_index(memory_block);
+        const AllocationInfo& allocation = s_tracker_data->allocations_table.at_index(allocationIndex);
+        tag = allocation.tag;
+        bytes_count = allocation.bytes_count;
+
+        s_tracker_data->deallocated += allocation.bytes_count;
+        s_tracker_data->deallocations_count++;
+
+        s_tracker_data->allocations_table.remove_index(allocationIndex);
+    }
+    register_tag_deallocation(tag, bytes_count);
+}
+
+void Memory::Tracker::set_tag_budget(MemoryTag tag, size_t budget, MemoryBudgetPolicy policy)
+{
+    MemoryTagData& tag_data = s_memory_tag_data[(uint8_t)tag];
+    tag_data.budget_policy.store((uint8_t)policy, MemoryOrder::Relaxed);
+    tag_data.budget.store(budget, MemoryOrder::Relaxed);
+    tag_data.is_over_budget.store(false, MemoryOrder::Relaxed);
+}
+
+MemoryTagStatistics Memory::Tracker::get_tag_statistics(MemoryTag tag)
+{
+    const MemoryTagData& tag_data = s_memory_tag_data[(uint8_t)tag];
+
+    MemoryTagStatistics statistics = {};
+    statistics.current_allocated = tag_data.current_allocated.load(MemoryOrder::Relaxed);
+    statistics.peak_allocated = tag_data.peak_allocated.load(MemoryOrder::Relaxed);
+    statistics.current_allocations_count = tag_data.current_allocations_count.load(MemoryOrder::Relaxed);
+    statistics.frame_allocated = tag_data.frame_snapshot.frame_allocated;
+    statistics.frame_deallocated = tag_data.frame_snapshot.frame_deallocated;
+    statistics.budget = tag_data.budget.load(MemoryOrder::Relaxed);
+    return statistics;
+}
 
-    s_tracker_data->deallocated += allocation.bytes_count;
-    s_tracker_data->deallocations_count++;
+void Memory::Tracker::capture_frame_snapshot()
+{
+    for (uint8_t tag = 0; tag < (uint8_t)MemoryTag::Count; ++tag)
+    {
+        MemoryTagData& tag_data = s_memory_tag_data[tag];
+
+        MemoryTagStatistics& snapshot = tag_data.frame_snapshot;
+        snapshot.current_allocated = tag_data.current_allocated.load(MemoryOrder::Relaxed);
+        snapshot.peak_allocated = tag_data.peak_allocated.load(MemoryOrder::Relaxed);
+        snapshot.current_allocations_count = tag_data.current_allocations_count.load(MemoryOrder::Relaxed);
+        snapshot.frame_allocated = tag_data.frame_allocated.exchange(0, MemoryOrder::Relaxed);
+        snapshot.frame_deallocated = tag_data.frame_deallocated.exchange(0, MemoryOrder::Relaxed);
+        snapshot.budget = tag_data.budget.load(MemoryOrder::Relaxed);
+    }
+}
 
-    s_tracker_data->allocations_table.remove_index(allocationIndex);
+const MemoryTagStatistics& Memory::Tracker::get_frame_snapshot(MemoryTag tag)
+{
+    return s_memory_tag_data[(uint8_t)tag].frame_snapshot;
+}
+
+void Memory::Tracker::log_tag_statistics()
+{
+    for (uint8_t tag = 0; tag < (uint8_t)MemoryTag::Count; ++tag)
+    {
+        const MemoryTagStatistics statistics = get_tag_statistics((MemoryTag)tag);
+        HC_LOG_INFO("Memory tag '%s': %llu bytes in %llu allocations (peak: %llu bytes, budget: %llu bytes).",
+            get_tag_name((MemoryTag)tag),
+            (unsigned long long)statistics.current_allocated,
+            (unsigned long long)statistics.current_allocations_count,
+            (unsigned long long)statistics.peak_allocated,
+            (unsigned long long)statistics.budget);
+    }
 }
 #endif // HC_ENABLE_MEMORY_TRACKING
 
@@ -22,12 +22,58 @@
     // If the Memory Tracking Tool is not present in the binaries, there is no gain/need to use the tagged functions.
     #define hc_new                          new
     #define hc_delete                       delete
-    #define allocate_tagged_i(BYTES_COUNT)  Allocate(BYTES_COUNT)
+    #define allocate_tagged_i(BYTES_COUNT)  allocate(BYTES_COUNT)
 #endif // HC_ENABLE_MEMORY_TRACKING
 
 namespace HC
 {
 
+/**
+ * The categories the allocations are attributed to, so the memory footprint of each
+ *   subsystem can be tracked and kept under a budget.
+ * An allocation gets the tag on top of the calling thread's tag stack (see 'ScopedMemoryTag'),
+ *   or 'Unknown' if the stack is empty.
+ */
+enum class MemoryTag : uint8_t
+{
+    Unknown = 0,
+    Containers,
+    Logger,
+    FileSystem,
+    Assets,
+    ECS,
+    Rendering,
+    Editor,
+
+    Count
+};
+
+// What happens when the memory allocated under a tag exceeds its budget.
+enum class MemoryBudgetPolicy : uint8_t
+{
+    Warn    = 0,
+    Assert  = 1
+};
+
+struct MemoryTagStatistics
+{
+    // The number of bytes currently allocated under the tag.
+    size_t current_allocated;
+
+    // The highest value 'current_allocated' ever reached.
+    size_t peak_allocated;
+
+    // The number of allocations currently alive under the tag.
+    size_t current_allocations_count;
+
+    // The number of bytes allocated/deallocated under the tag during the last frame.
+    size_t frame_allocated;
+    size_t frame_deallocated;
+
+    // The budget of the tag. Zero means there is no budget.
+    size_t budget;
+};
+
 /**
  *----------------------------------------------------------------
  * Memory System Description.
@@ -38,6 +84,29 @@ struct MemoryDescription
     // Whether or not to initialize the tracker. This flag is ignored when
     //   'HC_ENABLE_MEMORY_TRACKING' is set to 0.
     bool should_initialize_tracker;
+
+    // Whether or not to route all the allocations through the guarded allocator, which places each
+    //   block against an inaccessible page, in order to catch buffer overruns and use-after-free bugs.
+    // Very memory hungry (at least two pages per allocation), so only meant for debugging sessions.
+    bool use_guarded_allocator = false;
+
+    // The size of the address range reserved by the guarded allocator.
+    size_t guarded_allocator_reserve_size = 64ull * 1024 * 1024 * 1024;
+
+    // The number of freed blocks kept inaccessible by the guarded allocator, before their pages are reused.
+    uint32_t guarded_allocator_quarantine_count = 4096;
+
+    // Whether or not to report the allocations still alive when the memory system shuts down,
+    //   grouped by callsite. Requires the tracker.
+    bool should_report_leaks = true;
+
+    // If not null, the leak report is also written to this file, as JSON.
+    const char* leak_report_json_filepath = nullptr;
+
+    // Whether or not leaks should make the application exit with a failure code. Useful for
+    //   automated tests, so regressions in the allocation hygiene are caught.
+    // Requires the tracker, but not 'should_report_leaks'.
+    bool should_fail_on_leaks = false;
 };
 
 /**
@@ -52,6 +121,13 @@ public:
     static bool initialize(const MemoryDescription& description);
     static void shutdown();
 
+    /**
+     * Can be called after the memory system is shut down.
+     *
+     * @return True if leaks were detected at shutdown and 'should_fail_on_leaks' was set.
+     */
+    HC_API static bool has_failed_leak_check();
+
 public:
     /**
      * Copies a block of memory.
@@ -138,6 +214,43 @@ public:
      */
     HC_API static void free(void* memory_block);
 
+    /**
+     * Allocates a block of memory, backed by physical pages preferably taken from the given NUMA node.
+     * The block is page-granular and is not tracked, so this is meant for large and long-lived
+     *   buffers, that are mostly accessed by threads pinned to that node.
+     * The memory block allocated must only be freed by the 'free_on_numa_node' function.
+     *
+     * @param bytes_count The number of bytes the memory block will have.
+     * @param numa_node The preferred NUMA node.
+     *
+     * @return The address of the allocated memory block.
+     */
+    HC_API static void* allocate_on_numa_node(size_t bytes_count, uint32_t numa_node);
+
+    /**
+     * Frees a memory block allocated by the 'allocate_on_numa_node' function.
+     *
+     * @param memory_block The address of the memory block to free.
+     * @param bytes_count The number of bytes the memory block was allocated with.
+     */
+    HC_API static void free_on_numa_node(void* memory_block, size_t bytes_count);
+
+public:
+    /**
+     * Pushes a tag on the calling thread's tag stack. All the following allocations made by the
+     *   thread are attributed to it, until it is popped.
+     * Prefer using 'ScopedMemoryTag' instead of calling this function directly.
+     */
+    HC_API static void push_tag(MemoryTag tag);
+
+    /** Pops the tag on top of the calling thread's tag stack. */
+    HC_API static void pop_tag();
+
+    /** @return The tag the allocations made by the calling thread are currently attributed to. */
+    HC_API static MemoryTag get_current_tag();
+
+    HC_API static const char* get_tag_name(MemoryTag tag);
+
 #if HC_ENABLE_MEMORY_TRACKING
 
 public:
@@ -182,6 +295,50 @@ public:
 
         HC_API static void log_memory_usage();
 
+    public:
+        /**
+         * Sets the budget of a tag. The budget is checked on every allocation attributed to the tag,
+         *   and the policy is applied once each time the tag goes over it.
+         *
+         * @param tag The tag to set the budget for.
+         * @param budget The maximum number of bytes allocated under the tag. Zero removes the budget.
+         * @param policy What happens when the budget is exceeded.
+         */
+        HC_API static void set_tag_budget(MemoryTag tag, size_t budget, MemoryBudgetPolicy policy = MemoryBudgetPolicy::Warn);
+
+        /**
+         * The statistics are read from lock-free counters, so this function is cheap to call at any time.
+         * The frame statistics are the ones captured by the last 'capture_frame_snapshot' call.
+         *
+         * @return The current statistics of the tag.
+         */
+        HC_API static MemoryTagStatistics get_tag_statistics(MemoryTag tag);
+
+        /**
+         * Captures the statistics of all the tags and starts a new frame. Called once per frame
+         *   by the application.
+         */
+        HC_API static void capture_frame_snapshot();
+
+        /** @return The statistics of the tag, as captured by the last 'capture_frame_snapshot' call. */
+        HC_API static const MemoryTagStatistics& get_frame_snapshot(MemoryTag tag);
+
+        HC_API static void log_tag_statistics();
+
+    public:
+        /**
+         * Reports all the allocations that are currently alive, grouped by their callsite and sorted
+         *   by the number of bytes. Called automatically when the memory system shuts down.
+         * Allocations made without tracking information (not by 'hc_new' or 'allocate_tagged') are
+         *   grouped under a single unknown callsite.
+         * The report is written directly to the console, as the logger might already be shut down.
+         *
+         * @param json_filepath If not null, the full report is also written to this file, as JSON.
+         *
+         * @return The number of allocations that are currently alive.
+         */
+        HC_API static size_t report_leaks(const char* json_filepath = nullptr);
+
     private:
         HC_API static void register_allocation(void* memory_block, size_t bytes_count);
         HC_API static void register_tagged_allocation(void* memory_block, size_t bytes_count, const char* filename, const char* function_sig, uint32_t line_number);
@@ -202,6 +359,37 @@ private:
 #endif // HC_ENABLE_MEMORY_TRACKING
 };
 
+/**
+ *----------------------------------------------------------------
+ * Hiccup Scoped Memory Tag.
+ *----------------------------------------------------------------
+ * Attributes all the allocations made by the calling thread, during its lifetime, to a tag.
+ * Scopes can be nested. The innermost tag wins.
+ */
+class ScopedMemoryTag
+{
+public:
+    HC_NON_COPIABLE(ScopedMemoryTag)
+    HC_NON_MOVABLE(ScopedMemoryTag)
+
+public:
+    ALWAYS_INLINE ScopedMemoryTag(MemoryTag tag)
+    {
+        Memory::push_tag(tag);
+    }
+
+    ALWAYS_INLINE ~ScopedMemoryTag()
+    {
+        Memory::pop_tag();
+    }
+};
+
+#define HC_MEMORY_TAG_SCOPE_INTERNAL1(TAG, LINE)    ::HC::ScopedMemoryTag __memory_tag##LINE(::HC::MemoryTag::TAG)
+#define HC_MEMORY_TAG_SCOPE_INTERNAL2(TAG, LINE)    HC_MEMORY_TAG_SCOPE_INTERNAL1(TAG, LINE)
+
+// Attributes all the allocations made in the current scope to the given tag (a 'MemoryTag' enumerator name).
+#define HC_MEMORY_TAG_SCOPE(TAG)                    HC_MEMORY_TAG_SCOPE_INTERNAL2(TAG, HC_LINE)
+
 } // namespace HC
 
 // New operator, providing only basic memory tracking functionality.
@@ -307,4 +495,53 @@ public:
     ALWAYS_INLINE constexpr bool operator==(const UntrackedAllocator&) const { return true; }
 };
 
+/**
+ *----------------------------------------------------------------------
+ * Hiccup Tagged Heap Allocator.
+ *----------------------------------------------------------------------
+ * Heap allocator that attributes all its allocations to a fixed tag, regardless of the
+ *   calling thread's tag stack. Used by containers that belong to a single subsystem.
+ */
+template<MemoryTag Tag>
+class TaggedHeapAllocator
+{
+public:
+    /** @see 'Memory::allocate_raw'. */
+    ALWAYS_INLINE void* allocate_raw(size_t bytes_count)
+    {
+        ScopedMemoryTag tag_scope(Tag);
+        return Memory::allocate(bytes_count);
+    }
+
+    /** @see 'Memory::allocate'. */
+    ALWAYS_INLINE void* allocate(size_t bytes_count)
+    {
+        ScopedMemoryTag tag_scope(Tag);
+        return Memory::allocate(bytes_count);
+    }
+
+    /** @see 'Memory::allocate_tagged'. */
+    ALWAYS_INLINE void* allocate_tagged(size_t bytes_count, const char* filename, const char* function_sig, uint32_t line_number)
+    {
+        ScopedMemoryTag tag_scope(Tag);
+        return Memory::allocate_tagged(bytes_count, filename, function_sig, line_number);
+    }
+
+    /** @see 'Memory::free_raw'. */
+    ALWAYS_INLINE void free_raw(void* memory_block, size_t bytes_count)
+    {
+        Memory::free(memory_block);
+    }
+
+    /** @see 'Memory::free'. */
+    ALWAYS_INLINE void free(void* memory_block, size_t bytes_count)
+    {
+        Memory::free(memory_block);
+    }
+
+public:
+    /** @returns Always true, because the memory is allocated directly from the global heap. */
+    ALWAYS_INLINE constexpr bool operator==(const TaggedHeapAllocator&) const { return true; }
+};
+
 } // namespace HC
\ No newline at end of file
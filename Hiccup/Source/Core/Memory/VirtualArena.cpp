@@ -0,0 +1,138 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "VirtualArena.h"
+
+#include "Core/Platform/Platform.h"
+
+namespace HC
+{
+
+static_internal size_t align_up(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+VirtualArena::VirtualArena()
+    : m_base(nullptr)
+    , m_reserved_size(0)
+    , m_committed_size(0)
+    , m_size(0)
+    , m_commit_granularity(0)
+    , m_numa_node(Platform::AnyNumaNode)
+{}
+
+VirtualArena::~VirtualArena()
+{
+    release();
+}
+
+bool VirtualArena::reserve(size_t reserve_size, size_t commit_granularity, uint32_t numa_node)
+{
+    HC_ASSERT(!is_valid()); // The arena already has its address space reserved!
+
+    m_numa_node = numa_node;
+
+    const size_t page_size = Platform::get_page_size();
+    m_commit_granularity = align_up(Math::max<size_t>(commit_granularity, 1), page_size);
+    m_reserved_size = align_up(reserve_size, m_commit_granularity);
+
+    m_base = (uint8_t*)Platform::reserve_memory_on_node(m_reserved_size, m_numa_node);
+    if (!m_base)
+    {
+        HC_LOG_ERROR("VirtualArena::reserve - Failed to reserve %llu bytes of address space!", (unsigned long long)m_reserved_size);
+        m_reserved_size = 0;
+        return false;
+    }
+
+    m_committed_size = 0;
+    m_size = 0;
+    return true;
+}
+
+void VirtualArena::release()
+{
+    if (!m_base)
+    {
+        return;
+    }
+
+    Platform::release_memory(m_base, m_reserved_size);
+    m_base = nullptr;
+    m_reserved_size = 0;
+    m_committed_size = 0;
+    m_size = 0;
+}
+
+void* VirtualArena::allocate(size_t bytes_count, size_t alignment)
+{
+    HC_DASSERT((alignment & (alignment - 1)) == 0);
+
+    // Checked against the reserved size first, so the end of the allocation can't overflow.
+    const size_t offset = align_up(m_size, alignment);
+    if (offset > m_reserved_size || bytes_count > m_reserved_size - offset)
+    {
+        return nullptr;
+    }
+
+    if (!set_size(offset + bytes_count))
+    {
+        return nullptr;
+    }
+
+    return m_base + offset;
+}
+
+bool VirtualArena::set_size(size_t bytes_count)
+{
+    if (!ensure_committed(bytes_count))
+    {
+        return false;
+    }
+
+    m_size = bytes_count;
+    return true;
+}
+
+void VirtualArena::reset(bool should_decommit)
+{
+    m_size = 0;
+    if (should_decommit)
+    {
+        decommit_unused();
+    }
+}
+
+void VirtualArena::decommit_unused()
+{
+    const size_t keep_size = align_up(m_size, m_commit_granularity);
+    if (keep_size < m_committed_size)
+    {
+        Platform::decommit_memory(m_base + keep_size, m_committed_size - keep_size);
+        m_committed_size = keep_size;
+    }
+}
+
+bool VirtualArena::ensure_committed(size_t bytes_count)
+{
+    if (bytes_count <= m_committed_size)
+    {
+        return true;
+    }
+
+    if (bytes_count > m_reserved_size)
+    {
+        return false;
+    }
+
+    const size_t new_committed_size = Math::min(align_up(bytes_count, m_commit_granularity), m_reserved_size);
+    if (!Platform::commit_memory(m_base + m_committed_size, new_committed_size - m_committed_size))
+    {
+        HC_LOG_ERROR("VirtualArena::ensure_committed - Failed to commit memory! The system might be out of memory.");
+        return false;
+    }
+
+    m_committed_size = new_committed_size;
+    return true;
+}
+
+} // namespace HC
@@ -0,0 +1,220 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+
+#include "Memory.h"
+#include "Core/Platform/Platform.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------------
+ * Hiccup Virtual Memory Arena.
+ *----------------------------------------------------------------------
+ * A linear arena that reserves a large range of the address space up front (gigabytes are fine),
+ *   and commits physical memory on demand, as the allocations grow.
+ * The base address never changes, so the allocations never move and the last allocation can
+ *   grow in place, without copying. Only the committed pages consume physical memory.
+ */
+class HC_API VirtualArena
+{
+public:
+    HC_NON_COPIABLE(VirtualArena)
+    HC_NON_MOVABLE(VirtualArena)
+
+    // The physical memory is committed in blocks of this size, to reduce the number of system calls.
+    static constexpr size_t DefaultCommitGranularity = 64 * 1024;
+
+public:
+    VirtualArena();
+    ~VirtualArena();
+
+public:
+    /**
+     * Reserves the address space of the arena.
+     *
+     * @param reserve_size The maximum number of bytes the arena can ever store.
+     * @param commit_granularity The physical memory is committed in multiples of this size. Rounded up to the page size.
+     * @param numa_node The NUMA node the physical memory is preferably taken from. Arenas used by threads pinned
+     *   to a node should pass that node, so their memory stays local.
+     *
+     * @return True if the address space was reserved successfully.
+     */
+    bool reserve(size_t reserve_size, size_t commit_granularity = DefaultCommitGranularity, uint32_t numa_node = Platform::AnyNumaNode);
+
+    /** Releases the address space and all the committed memory. */
+    void release();
+
+public:
+    /**
+     * Allocates a block of memory from the arena, committing more memory if needed.
+     *
+     * @param bytes_count The size of the block.
+     * @param alignment The alignment of the block. Must be a power of two.
+     *
+     * @return The allocated block, or nullptr if the reservation is exhausted.
+     */
+    void* allocate(size_t bytes_count, size_t alignment = 16);
+
+    template<typename T>
+    ALWAYS_INLINE T* allocate_type()
+    {
+        return (T*)allocate(sizeof(T), alignof(T));
+    }
+
+    template<typename T>
+    ALWAYS_INLINE T* allocate_array(size_t count)
+    {
+        return (T*)allocate(count * sizeof(T), alignof(T));
+    }
+
+    /**
+     * Sets the number of used bytes, committing more memory if needed. Used to grow or shrink
+     *   the last allocation in place.
+     *
+     * @return True on success; False if the reservation is exhausted.
+     */
+    bool set_size(size_t bytes_count);
+
+    /**
+     * Frees all the allocations at once.
+     *
+     * @param should_decommit If true, the physical memory is returned to the OS. Otherwise, it is
+     *   kept committed, so it can be reused without any system call.
+     */
+    void reset(bool should_decommit = false);
+
+    /** Returns to the OS the committed memory that is not currently used. */
+    void decommit_unused();
+
+public:
+    ALWAYS_INLINE uint8_t* data() const { return m_base; }
+
+    /** @return The number of bytes currently used. */
+    ALWAYS_INLINE size_t size() const { return m_size; }
+
+    ALWAYS_INLINE size_t get_committed_size() const { return m_committed_size; }
+    ALWAYS_INLINE size_t get_reserved_size() const { return m_reserved_size; }
+    ALWAYS_INLINE uint32_t get_numa_node() const { return m_numa_node; }
+
+    ALWAYS_INLINE bool is_valid() const { return (m_base != nullptr); }
+
+private:
+    bool ensure_committed(size_t bytes_count);
+
+private:
+    uint8_t* m_base;
+    size_t m_reserved_size;
+    size_t m_committed_size;
+    size_t m_size;
+    size_t m_commit_granularity;
+    uint32_t m_numa_node;
+};
+
+/**
+ *----------------------------------------------------------------------
+ * Hiccup Virtual Array.
+ *----------------------------------------------------------------------
+ * A dynamic array, backed by a virtual memory arena. Growing never reallocates, so the
+ *   elements never move and pointers to them stay valid for the lifetime of the array.
+ * The capacity is fixed when the array is created, but only the used part consumes memory.
+ */
+template<typename T>
+class VirtualArray
+{
+public:
+    HC_NON_COPIABLE(VirtualArray)
+    HC_NON_MOVABLE(VirtualArray)
+
+public:
+    explicit VirtualArray(size_t max_count)
+        : m_count(0)
+    {
+        // A count whose size doesn't fit in 'size_t' is rejected, instead of reserving the wrapped size.
+        const bool reserved = (max_count <= InvalidSize / sizeof(T)) && m_arena.reserve(max_count * sizeof(T));
+        HC_ASSERT(reserved); // Failed to reserve the address space of the array!
+    }
+
+    ~VirtualArray()
+    {
+        clear();
+    }
+
+public:
+    ALWAYS_INLINE T* data() const { return (T*)m_arena.data(); }
+    ALWAYS_INLINE size_t size() const { return m_count; }
+    ALWAYS_INLINE bool is_empty() const { return (m_count == 0); }
+    ALWAYS_INLINE size_t max_size() const { return m_arena.get_reserved_size() / sizeof(T); }
+
+    ALWAYS_INLINE T& operator[](size_t index)
+    {
+        HC_DASSERT(index < m_count);
+        return data()[index];
+    }
+
+    ALWAYS_INLINE const T& operator[](size_t index) const
+    {
+        HC_DASSERT(index < m_count);
+        return data()[index];
+    }
+
+public:
+    T& add(const T& element)
+    {
+        T* slot = grow(1);
+        new (slot) T(element);
+        return *slot;
+    }
+
+    T& add(T&& element)
+    {
+        T* slot = grow(1);
+        new (slot) T(Types::move(element));
+        return *slot;
+    }
+
+    /** @return The index of the first added element. */
+    size_t add_uninitialized(size_t count)
+    {
+        grow(count);
+        return m_count - count;
+    }
+
+    void pop()
+    {
+        HC_ASSERT(m_count > 0); // The array is empty!
+        data()[--m_count].~T();
+        m_arena.set_size(m_count * sizeof(T));
+    }
+
+    void clear()
+    {
+        for (size_t index = 0; index < m_count; ++index)
+        {
+            data()[index].~T();
+        }
+        m_count = 0;
+        m_arena.reset();
+    }
+
+private:
+    T* grow(size_t count)
+    {
+        // A count whose size doesn't fit in 'size_t' is rejected, instead of growing to the wrapped size.
+        const bool has_grown = (count <= InvalidSize / sizeof(T) - m_count) && m_arena.set_size((m_count + count) * sizeof(T));
+        HC_ASSERT(has_grown); // The virtual array exceeded its maximum size!
+
+        T* slot = data() + m_count;
+        m_count += count;
+        return slot;
+    }
+
+private:
+    VirtualArena m_arena;
+    size_t m_count;
+};
+
+} // namespace HC
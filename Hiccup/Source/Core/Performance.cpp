@@ -2,7 +2,7 @@
 
 #include "Performance.h"
 
-#include "Memory.h"
+#include "Memory/Memory.h"
 #include "Platform/Platform.h"
 
 namespace HC
@@ -15,6 +15,16 @@ struct ProfilerData
     ProfilerDescription   description;
     uint64_t                frame_index;
     bool                  is_in_frame;
+
+    uint64_t                frame_begin_time;
+    uint64_t                frame_idle_time;
+    uint32_t                frame_fixed_updates_count;
+
+    // Ring buffer with the durations of the last frames.
+    uint64_t                frame_times[Profiler::FrameHistoryCount];
+    uint32_t                frame_times_count;
+
+    FrameStatistics         statistics;
 };
 static_internal ProfilerData* s_profiler_data = nullptr;
 
@@ -26,6 +36,12 @@ bool Profiler::initialize(const ProfilerDescription& description)
     s_profiler_data->frame_index = 0;
     s_profiler_data->is_in_frame = false;
 
+    s_profiler_data->frame_begin_time = 0;
+    s_profiler_data->frame_idle_time = 0;
+    s_profiler_data->frame_fixed_updates_count = 0;
+    s_profiler_data->frame_times_count = 0;
+    Memory::zero(&s_profiler_data->statistics, sizeof(FrameStatistics));
+
     return true;
 }
 
@@ -44,6 +60,9 @@ void Profiler::begin_frame()
     }
 
     s_profiler_data->is_in_frame = true;
+    s_profiler_data->frame_begin_time = Platform::get_nanoseconds();
+    s_profiler_data->frame_idle_time = 0;
+    s_profiler_data->frame_fixed_updates_count = 0;
 }
 
 void Profiler::end_frame()
@@ -54,10 +73,49 @@ void Profiler::end_frame()
         return;
     }
 
+    const uint64_t frame_time = Platform::get_nanoseconds() - s_profiler_data->frame_begin_time;
+
+    s_profiler_data->frame_times[s_profiler_data->frame_index % FrameHistoryCount] = frame_time;
+    s_profiler_data->frame_times_count = Math::min(s_profiler_data->frame_times_count + 1, FrameHistoryCount);
+
+    FrameStatistics& statistics = s_profiler_data->statistics;
+    statistics.frame_index = s_profiler_data->frame_index;
+    statistics.last_frame_time = frame_time;
+    statistics.last_idle_time = s_profiler_data->frame_idle_time;
+    statistics.last_fixed_updates_count = s_profiler_data->frame_fixed_updates_count;
+
+    uint64_t total_time = 0;
+    statistics.min_frame_time = (uint64_t)(-1);
+    statistics.max_frame_time = 0;
+    for (uint32_t index = 0; index < s_profiler_data->frame_times_count; ++index)
+    {
+        const uint64_t time = s_profiler_data->frame_times[index];
+        total_time += time;
+        statistics.min_frame_time = Math::min(statistics.min_frame_time, time);
+        statistics.max_frame_time = Math::max(statistics.max_frame_time, time);
+    }
+    statistics.average_frame_time = total_time / s_profiler_data->frame_times_count;
+    statistics.frames_per_second = (statistics.average_frame_time > 0) ? 1e9 / (float64_t)statistics.average_frame_time : 0.0;
+
     s_profiler_data->is_in_frame = false;
     s_profiler_data->frame_index++;
 }
 
+void Profiler::record_frame_idle_time(uint64_t nanoseconds)
+{
+    s_profiler_data->frame_idle_time += nanoseconds;
+}
+
+void Profiler::record_frame_fixed_updates(uint32_t count)
+{
+    s_profiler_data->frame_fixed_updates_count += count;
+}
+
+const FrameStatistics& Profiler::get_frame_statistics()
+{
+    return s_profiler_data->statistics;
+}
+
 Profiler::ScopedTimer::ScopedTimer(const char* scope_name)
     : m_name(scope_name)
 {
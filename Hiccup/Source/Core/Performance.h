@@ -15,12 +15,18 @@
 
     #define HC_PROFILE_BEGIN_FRAME                  ::HC::Profiler::begin_frame()
     #define HC_PROFILE_END_FRAME                    ::HC::Profiler::end_frame()
+
+    #define HC_PROFILE_FRAME_IDLE_TIME(NS)          ::HC::Profiler::record_frame_idle_time(NS)
+    #define HC_PROFILE_FRAME_FIXED_UPDATES(COUNT)   ::HC::Profiler::record_frame_fixed_updates(COUNT)
 #else
     #define HC_PROFILE_FUNCTION()
     #define HC_PROFILE_SCOPE(SCOPE_NAME)
 
     #define HC_PROFILE_END_FRAME
     #define HC_PROFILE_BEGIN_FRAME
+
+    #define HC_PROFILE_FRAME_IDLE_TIME(NS)
+    #define HC_PROFILE_FRAME_FIXED_UPDATES(COUNT)
 #endif // HC_ENABLE_PROFILING
 
 namespace HC
@@ -37,6 +43,28 @@ struct ProfilerDescription
 {
 };
 
+/**
+ * Timing statistics of the last frames. All times are in nanoseconds.
+ * The minimum, maximum and average are computed over the last 'Profiler::FrameHistoryCount' frames.
+ */
+struct FrameStatistics
+{
+    uint64_t frame_index;
+
+    uint64_t last_frame_time;
+    uint64_t min_frame_time;
+    uint64_t max_frame_time;
+    uint64_t average_frame_time;
+
+    // The part of the last frame spent waiting for the frame limiter.
+    uint64_t last_idle_time;
+
+    // The number of fixed timestep updates executed during the last frame.
+    uint32_t last_fixed_updates_count;
+
+    float64_t frames_per_second;
+};
+
 /**
  *----------------------------------------------------------------
  * Hiccup Performance Profiler Tool.
@@ -49,9 +77,17 @@ public:
     static bool initialize(const ProfilerDescription& description);
     static void shutdown();
 
+    static constexpr uint32_t FrameHistoryCount = 128;
+
+public:
     static void begin_frame();
     static void end_frame();
 
+    static void record_frame_idle_time(uint64_t nanoseconds);
+    static void record_frame_fixed_updates(uint32_t count);
+
+    HC_API static const FrameStatistics& get_frame_statistics();
+
 public:
     struct ScopedTimer
     {
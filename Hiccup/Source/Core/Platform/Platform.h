@@ -4,6 +4,12 @@
 
 #include "Core/CoreMinimal.h"
 
+#if HC_COMPILER_MSVC
+    #include <intrin.h>
+#elif HC_COMPILER_GCC_CLANG
+    #include <immintrin.h>
+#endif // Compiler switch.
+
 namespace HC
 {
 
@@ -75,6 +81,71 @@ public:
         POPUP_FLAG_ICON_ERROR       = bit(10)
     };
 
+    // Opaque handle to a native thread. No guarantees are made about its value.
+    using ThreadHandle = void*;
+
+    // The signature of the function that is invoked on a newly created thread.
+    using PFN_ThreadEntryPoint = uint32_t(*)(void* user_data);
+
+    // All scheduling priorities that a thread can have.
+    enum class ThreadPriority : uint8_t
+    {
+        Lowest = 0, Low = 1, Normal = 2, High = 3, Highest = 4, TimeCritical = 5,
+
+        MaxEnumValue
+    };
+
+    // Passing this as a timeout value makes the wait functions block until they are woken up.
+    static constexpr uint32_t InfiniteTimeout = (uint32_t)(-1);
+
+    // How long before the target time 'sleep_until_nanoseconds' stops sleeping and starts spinning.
+    static constexpr uint64_t SleepSpinThresholdNanoseconds = 2000000;
+
+    // Opaque handle to a native file. No guarantees are made about its value.
+    using FileHandle = void*;
+
+    // Opaque handle to a native file mapping object. No guarantees are made about its value.
+    using FileMappingHandle = void*;
+
+    enum class FileAccess : uint8_t
+    {
+        Read = 0, Write = 1, ReadWrite = 2,
+
+        MaxEnumValue
+    };
+
+    enum class FileOpenMode : uint8_t
+    {
+        // Fails if the file doesn't exist.
+        OpenExisting = 0,
+        // Creates the file if it doesn't exist.
+        OpenAlways = 1,
+        // Creates the file, truncating it if it already exists.
+        CreateAlways = 2,
+
+        MaxEnumValue
+    };
+
+    // The signature of the function invoked for each entry found by 'iterate_directory'.
+    // Returning false stops the iteration.
+    using PFN_DirectoryIterator = bool(*)(const char* name, size_t name_length, bool is_directory, void* user_data);
+
+    // Hints about how a file or a memory range will be accessed.
+    enum class AccessHint : uint8_t
+    {
+        Normal = 0,
+        // The data is accessed once, from the beginning towards the end.
+        Sequential = 1,
+        // The data is accessed in no predictable order.
+        Random = 2,
+        // The data will be accessed soon, so it should be brought into memory.
+        WillNeed = 3,
+        // The data won't be accessed soon, so it can be evicted from memory.
+        DontNeed = 4,
+
+        MaxEnumValue
+    };
+
 public:
     static bool initialize(const PlatformDescription& description);
     static void shutdown();
@@ -84,6 +155,50 @@ public:
 
     static void free_memory(void* memory_block);
 
+    /** @return The size of a virtual memory page. Commits and decommits are done with page granularity. */
+    static uint32_t get_page_size();
+
+    /**
+     * Reserves a range of the address space, without backing it with physical memory.
+     * The range can't be accessed until it is committed.
+     *
+     * @param bytes_count The size of the range. Rounded up to the allocation granularity.
+     *
+     * @return The base address of the range, or nullptr on failure.
+     */
+    static void* reserve_memory(size_t bytes_count);
+
+    /** Backs a reserved range with zero-initialized, readable and writable memory. The range is rounded to whole pages. */
+    static bool commit_memory(void* address, size_t bytes_count);
+
+    /** Returns the physical memory of a committed range to the OS. The range stays reserved. */
+    static void decommit_memory(void* address, size_t bytes_count);
+
+    /** Releases a range obtained by 'reserve_memory'. */
+    static void release_memory(void* address, size_t bytes_count);
+
+public:
+    // Passed instead of a NUMA node index, when the memory or thread has no node preference.
+    static constexpr uint32_t AnyNumaNode = 0xFFFFFFFF;
+
+    /** @return The number of NUMA nodes of the system. Always at least one, even on non-NUMA systems. */
+    static uint32_t get_numa_node_count();
+
+    /** @return The number of logical processors that belong to the given NUMA node. */
+    static uint32_t get_numa_node_processor_count(uint32_t numa_node);
+
+    /** @return The NUMA node of the processor the calling thread currently runs on. */
+    static uint32_t get_current_numa_node();
+
+    /**
+     * Same as 'reserve_memory', but the pages committed later in the range are preferably taken from the given NUMA node.
+     * The preference is only a hint: if the node is out of memory, the pages come from another node.
+     */
+    static void* reserve_memory_on_node(size_t bytes_count, uint32_t numa_node);
+
+    /** Reserves and commits a range in a single call, with the same node preference as 'reserve_memory_on_node'. */
+    static void* reserve_and_commit_memory_on_node(size_t bytes_count, uint32_t numa_node);
+
 public:
     static uint64_t get_performance_tick_count();
     static uint64_t get_performance_tick_frequency();
@@ -102,6 +217,173 @@ public:
 
 public:
     static uint32_t open_popup(const char* title, const char* message, uint32_t flags);
+
+public:
+    /**
+     * Creates a new thread, in a suspended state. It starts executing once 'resume_thread' is called,
+     *   so its affinity, name and priority can be configured before it runs any instruction.
+     * The returned handle must be released by calling 'join_thread' or 'detach_thread'.
+     * 
+     * @param entry_point The function that the thread executes.
+     * @param user_data Opaque pointer that is passed to the entry point.
+     * @param stack_size The size (in bytes) of the thread's stack. If 0, the platform default is used.
+     * 
+     * @return The handle of the newly created thread, or nullptr on failure.
+     */
+    static ThreadHandle create_thread(PFN_ThreadEntryPoint entry_point, void* user_data, size_t stack_size);
+
+    /** Starts executing a thread created by 'create_thread'. */
+    static bool resume_thread(ThreadHandle thread);
+
+    /** Blocks until the given thread finishes its execution and releases its handle. */
+    static void join_thread(ThreadHandle thread);
+
+    /** Releases the thread handle, without waiting for the thread to finish its execution. */
+    static void detach_thread(ThreadHandle thread);
+
+    /**
+     * Destroys a thread that was created by 'create_thread' but never resumed, and releases its handle.
+     * Closing the handle alone would leave the suspended thread (and its stack) alive forever.
+     */
+    static void cancel_thread(ThreadHandle thread);
+
+    /** Sets the thread name, as visible in debuggers and profilers. */
+    static bool set_thread_name(ThreadHandle thread, const char* name);
+
+    /** Restricts the thread to the processors whose bits are set in the mask. */
+    static bool set_thread_affinity(ThreadHandle thread, uint64_t affinity_mask);
+
+    /** Restricts the thread to the processors of the given NUMA node. */
+    static bool set_thread_numa_node(ThreadHandle thread, uint32_t numa_node);
+
+    static bool set_thread_priority(ThreadHandle thread, ThreadPriority priority);
+
+    static uint32_t get_current_thread_id();
+
+    /** @return The number of logical processors available to the process. */
+    static uint32_t get_processor_count();
+
+    /** Gives up the remainder of the calling thread's time slice. */
+    static void yield_thread();
+
+    static void sleep_milliseconds(uint32_t milliseconds);
+
+    /**
+     * Blocks the calling thread until the given time, as returned by 'get_nanoseconds'.
+     * The thread sleeps while the target is far away, and spins for the remaining part, because
+     *   the sleeps are only as precise as the scheduler timer.
+     */
+    static void sleep_until_nanoseconds(uint64_t target_nanoseconds);
+
+public:
+    /**
+     * Futex-like wait primitive. Blocks the calling thread for as long as the value stored at
+     *   the given address is equal to the expected value. Spurious wake ups are possible, so
+     *   the caller must always re-check the condition it waits for.
+     * 
+     * @param address The address to wait on.
+     * @param expected_value The value that keeps the thread blocked.
+     * @param timeout_milliseconds The maximum wait duration, or 'InfiniteTimeout'.
+     * 
+     * @return False if the wait timed out; True otherwise.
+     */
+    static bool wait_on_address(volatile uint32_t* address, uint32_t expected_value, uint32_t timeout_milliseconds = InfiniteTimeout);
+
+    /** Wakes up one of the threads that wait on the given address. */
+    static void wake_by_address_single(volatile uint32_t* address);
+
+    /** Wakes up all threads that wait on the given address. */
+    static void wake_by_address_all(volatile uint32_t* address);
+
+public:
+    /**
+     * Opens (or creates) a file.
+     * The returned handle must be released by calling 'close_file'.
+     *
+     * @param filepath The UTF-8 encoded path of the file. Doesn't have to be null-terminated.
+     * @param filepath_length The number of bytes the path occupies.
+     * @param access The operations that will be performed with the handle.
+     * @param open_mode What to do if the file does (or doesn't) exist.
+     * @param hint How the file will be accessed. Only 'Normal', 'Sequential' and 'Random' are meaningful here.
+     *
+     * @return The handle of the opened file, or nullptr on failure.
+     */
+    static FileHandle open_file(const char* filepath, size_t filepath_length, FileAccess access, FileOpenMode open_mode, AccessHint hint);
+
+    static void close_file(FileHandle file);
+
+    /** @return True if the file (and not a directory) exists; False otherwise. */
+    static bool file_exists(const char* filepath, size_t filepath_length);
+
+    static bool get_file_size(FileHandle file, uint64_t* out_file_size);
+
+    /** Extends or truncates the file to the given size. */
+    static bool set_file_size(FileHandle file, uint64_t file_size);
+
+    /**
+     * Invokes the callback for each file and subdirectory of the given directory. The entries are not
+     *   visited recursively, and the special '.' and '..' entries are skipped.
+     *
+     * @return False if the directory couldn't be opened; True otherwise.
+     */
+    static bool iterate_directory(const char* directory_path, size_t directory_path_length, PFN_DirectoryIterator callback, void* user_data);
+
+    /**
+     * Reads from the file at the given offset. The file cursor is not used, so reads on the same
+     *   handle can be issued concurrently from multiple threads.
+     *
+     * @return True if exactly 'bytes_count' bytes were read; False otherwise.
+     */
+    static bool read_file(FileHandle file, uint64_t offset, void* destination, size_t bytes_count);
+
+    /**
+     * Writes to the file at the given offset. The file cursor is not used.
+     *
+     * @return True if exactly 'bytes_count' bytes were written; False otherwise.
+     */
+    static bool write_file(FileHandle file, uint64_t offset, const void* source, size_t bytes_count);
+
+public:
+    /**
+     * The file offset passed to 'map_file' must be a multiple of this value.
+     * This is usually larger than the page size (64KiB on Windows).
+     */
+    static uint32_t get_mapping_granularity();
+
+    /**
+     * Maps a range of the file into the address space of the process.
+     * The returned view must be released by calling 'unmap_file'.
+     *
+     * @param file The file to map. It can be closed while the view is still mapped.
+     * @param offset The offset of the range. Must be a multiple of 'get_mapping_granularity()'.
+     * @param bytes_count The size of the range. Must not exceed the file size.
+     * @param writable Whether or not the view is writable. The file must be opened with write access.
+     * @param out_mapping The native mapping object, that must be passed to 'unmap_file'.
+     *
+     * @return The address of the mapped view, or nullptr on failure.
+     */
+    static void* map_file(FileHandle file, uint64_t offset, size_t bytes_count, bool writable, FileMappingHandle* out_mapping);
+
+    static void unmap_file(void* view, FileMappingHandle mapping);
+
+    /** Writes the modified pages of the mapped view back to the file. */
+    static bool flush_mapped_file(void* view, size_t bytes_count);
+
+    /**
+     * Hints the OS about how a memory range (usually a mapped file view) will be accessed.
+     * Not all hints are supported by all platforms, in which case the call is ignored.
+     */
+    static void advise_memory(void* address, size_t bytes_count, AccessHint hint);
+
+public:
+    /**
+     * Hints the processor that the calling thread is spin-waiting. This reduces the power consumption
+     *   and the penalty of exiting the spin loop, and frees resources for the sibling hyper-thread.
+     */
+    ALWAYS_INLINE static void cpu_relax()
+    {
+        _mm_pause();
+    }
 };
 
 } // namespace HC
\ No newline at end of file
@@ -3,8 +3,11 @@
 #include "Core/Platform/Platform.h"
 
 #include "Core/Memory/Memory.h"
+#include "Core/Math/MathUtilities.h"
 
 #include <Windows.h>
+#include <timeapi.h>
+#include <intrin.h>
 #include <cstdlib>
 
 namespace HC
@@ -18,6 +21,7 @@ struct WindowsPlatformData
     HANDLE                  console_handle;
     Platform::ConsoleColor  console_foreground;
     Platform::ConsoleColor  console_background;
+    UINT                    timer_resolution;
 };
 static_internal WindowsPlatformData* s_platform_data = nullptr;
 
@@ -40,6 +44,13 @@ bool Platform::initialize(const PlatformDescription& description)
 
     s_platform_data->initialization_nanoseconds = get_nanoseconds();
 
+    // Raising the scheduler timer resolution, so the sleeps are precise enough for frame pacing.
+    TIMECAPS timer_caps;
+    if (timeGetDevCaps(&timer_caps, sizeof(TIMECAPS)) == MMSYSERR_NOERROR) {
+        s_platform_data->timer_resolution = Math::max<UINT>(timer_caps.wPeriodMin, 1);
+        timeBeginPeriod(s_platform_data->timer_resolution);
+    }
+
     if (s_platform_data->description.is_console_attached) {
         s_platform_data->console_handle = GetStdHandle(STD_OUTPUT_HANDLE);
         s_platform_data->console_foreground = ConsoleColor::MaxEnumValue;
@@ -56,6 +67,10 @@ void Platform::shutdown()
         set_console_color(ConsoleColor::LightGray, ConsoleColor::Black);
     }
 
+    if (s_platform_data->timer_resolution) {
+        timeEndPeriod(s_platform_data->timer_resolution);
+    }
+
     s_platform_data->~WindowsPlatformData();
     std::free(s_platform_data);
     s_platform_data = nullptr;
@@ -71,6 +86,81 @@ void Platform::free_memory(void* memory_block)
     std::free(memory_block);
 }
 
+uint32_t Platform::get_page_size()
+{
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return (uint32_t)system_info.dwPageSize;
+}
+
+void* Platform::reserve_memory(size_t bytes_count)
+{
+    return VirtualAlloc(nullptr, bytes_count, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool Platform::commit_memory(void* address, size_t bytes_count)
+{
+    return VirtualAlloc(address, bytes_count, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void Platform::decommit_memory(void* address, size_t bytes_count)
+{
+    VirtualFree(address, bytes_count, MEM_DECOMMIT);
+}
+
+void Platform::release_memory(void* address, size_t bytes_count)
+{
+    // The whole reservation is always released, so the size must be zero.
+    VirtualFree(address, 0, MEM_RELEASE);
+}
+
+uint32_t Platform::get_numa_node_count()
+{
+    ULONG highest_node_number = 0;
+    if (!GetNumaHighestNodeNumber(&highest_node_number)) {
+        return 1;
+    }
+    return (uint32_t)highest_node_number + 1;
+}
+
+uint32_t Platform::get_numa_node_processor_count(uint32_t numa_node)
+{
+    GROUP_AFFINITY group_affinity = {};
+    if (!GetNumaNodeProcessorMaskEx((USHORT)numa_node, &group_affinity)) {
+        return 0;
+    }
+    return Math::popcount((uint64_t)group_affinity.Mask);
+}
+
+uint32_t Platform::get_current_numa_node()
+{
+    PROCESSOR_NUMBER processor_number = {};
+    GetCurrentProcessorNumberEx(&processor_number);
+
+    USHORT numa_node = 0;
+    if (!GetNumaProcessorNodeEx(&processor_number, &numa_node)) {
+        return 0;
+    }
+    return (uint32_t)numa_node;
+}
+
+// The preferred node is stored by the reservation, so pages committed later into the range are taken from it.
+void* Platform::reserve_memory_on_node(size_t bytes_count, uint32_t numa_node)
+{
+    if (numa_node == AnyNumaNode) {
+        return reserve_memory(bytes_count);
+    }
+    return VirtualAllocExNuma(GetCurrentProcess(), nullptr, bytes_count, MEM_RESERVE, PAGE_NOACCESS, (DWORD)numa_node);
+}
+
+void* Platform::reserve_and_commit_memory_on_node(size_t bytes_count, uint32_t numa_node)
+{
+    if (numa_node == AnyNumaNode) {
+        return VirtualAlloc(nullptr, bytes_count, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    }
+    return VirtualAllocExNuma(GetCurrentProcess(), nullptr, bytes_count, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, (DWORD)numa_node);
+}
+
 uint64_t Platform::get_performance_tick_count()
 {
     LARGE_INTEGER performance_counter;
@@ -191,4 +281,376 @@ uint32_t Platform::open_popup(const char* title, const char* message, uint32_t f
     return POPUP_FLAG_NONE;
 }
 
+Platform::ThreadHandle Platform::create_thread(PFN_ThreadEntryPoint entry_point, void* user_data, size_t stack_size)
+{
+    // The Win32 thread procedure has the same ABI as 'PFN_ThreadEntryPoint', so no trampoline
+    //   (and thus no allocation) is required.
+    HANDLE thread_handle = CreateThread(NULL, stack_size, (LPTHREAD_START_ROUTINE)entry_point, user_data, CREATE_SUSPENDED, NULL);
+    return (ThreadHandle)thread_handle;
+}
+
+bool Platform::resume_thread(ThreadHandle thread)
+{
+    return ResumeThread((HANDLE)thread) != (DWORD)-1;
+}
+
+void Platform::join_thread(ThreadHandle thread)
+{
+    WaitForSingleObject((HANDLE)thread, INFINITE);
+    CloseHandle((HANDLE)thread);
+}
+
+void Platform::detach_thread(ThreadHandle thread)
+{
+    CloseHandle((HANDLE)thread);
+}
+
+void Platform::cancel_thread(ThreadHandle thread)
+{
+    // The thread never executed any code, so terminating it can't leave any state inconsistent.
+    TerminateThread((HANDLE)thread, 0);
+    WaitForSingleObject((HANDLE)thread, INFINITE);
+    CloseHandle((HANDLE)thread);
+}
+
+bool Platform::set_thread_name(ThreadHandle thread, const char* name)
+{
+    wchar_t buffer[128] = {};
+    MultiByteToWideChar(CP_UTF8, 0, name, -1, buffer, array_count(buffer) - 1);
+    return SUCCEEDED(SetThreadDescription((HANDLE)thread, buffer));
+}
+
+bool Platform::set_thread_affinity(ThreadHandle thread, uint64_t affinity_mask)
+{
+    return SetThreadAffinityMask((HANDLE)thread, (DWORD_PTR)affinity_mask) != 0;
+}
+
+bool Platform::set_thread_numa_node(ThreadHandle thread, uint32_t numa_node)
+{
+    // Only the primary processor group of the node is used. Nodes rarely span multiple groups.
+    GROUP_AFFINITY group_affinity = {};
+    if (!GetNumaNodeProcessorMaskEx((USHORT)numa_node, &group_affinity)) {
+        return false;
+    }
+    return SetThreadGroupAffinity((HANDLE)thread, &group_affinity, nullptr) != 0;
+}
+
+bool Platform::set_thread_priority(ThreadHandle thread, ThreadPriority priority)
+{
+    static_persistent const int s_priorities[(uint8_t)ThreadPriority::MaxEnumValue] =
+    {
+        THREAD_PRIORITY_LOWEST,         // Lowest
+        THREAD_PRIORITY_BELOW_NORMAL,   // Low
+        THREAD_PRIORITY_NORMAL,         // Normal
+        THREAD_PRIORITY_ABOVE_NORMAL,   // High
+        THREAD_PRIORITY_HIGHEST,        // Highest
+        THREAD_PRIORITY_TIME_CRITICAL   // TimeCritical
+    };
+
+    return SetThreadPriority((HANDLE)thread, s_priorities[(uint8_t)priority]) != 0;
+}
+
+uint32_t Platform::get_current_thread_id()
+{
+    return (uint32_t)GetCurrentThreadId();
+}
+
+uint32_t Platform::get_processor_count()
+{
+    return (uint32_t)GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+}
+
+void Platform::yield_thread()
+{
+    SwitchToThread();
+}
+
+void Platform::sleep_milliseconds(uint32_t milliseconds)
+{
+    Sleep((DWORD)milliseconds);
+}
+
+void Platform::sleep_until_nanoseconds(uint64_t target_nanoseconds)
+{
+    for (uint64_t now = get_nanoseconds(); now < target_nanoseconds; now = get_nanoseconds()) {
+        const uint64_t remaining = target_nanoseconds - now;
+        if (remaining > SleepSpinThresholdNanoseconds) {
+            sleep_milliseconds(Math::max<uint32_t>((uint32_t)((remaining - SleepSpinThresholdNanoseconds) / 1000000), 1));
+        }
+        else {
+            cpu_relax();
+        }
+    }
+}
+
+bool Platform::wait_on_address(volatile uint32_t* address, uint32_t expected_value, uint32_t timeout_milliseconds)
+{
+    // WaitOnAddress returns immediately if the values are already different.
+    const BOOL result = WaitOnAddress(address, &expected_value, sizeof(uint32_t), (DWORD)timeout_milliseconds);
+    return (result != FALSE) || (GetLastError() != ERROR_TIMEOUT);
+}
+
+void Platform::wake_by_address_single(volatile uint32_t* address)
+{
+    WakeByAddressSingle((PVOID)address);
+}
+
+void Platform::wake_by_address_all(volatile uint32_t* address)
+{
+    WakeByAddressAll((PVOID)address);
+}
+
+// Converts the UTF-8 encoded path to the UTF-16 encoding that the Win32 API expects.
+static_internal bool utf8_path_to_wide(const char* filepath, size_t filepath_length, wchar_t* out_buffer, size_t buffer_count)
+{
+    const int written = MultiByteToWideChar(CP_UTF8, 0, filepath, (int)filepath_length, out_buffer, (int)buffer_count - 1);
+    if (written <= 0 && filepath_length > 0) {
+        HC_LOG_ERROR("Platform - Failed to convert the filepath to UTF-16!");
+        return false;
+    }
+
+    out_buffer[written] = 0;
+    return true;
+}
+
+Platform::FileHandle Platform::open_file(const char* filepath, size_t filepath_length, FileAccess access, FileOpenMode open_mode, AccessHint hint)
+{
+    static_persistent const DWORD s_access_flags[(uint8_t)FileAccess::MaxEnumValue] =
+    {
+        GENERIC_READ,                   // Read
+        GENERIC_WRITE,                  // Write
+        GENERIC_READ | GENERIC_WRITE    // ReadWrite
+    };
+
+    static_persistent const DWORD s_creation_dispositions[(uint8_t)FileOpenMode::MaxEnumValue] =
+    {
+        OPEN_EXISTING,  // OpenExisting
+        OPEN_ALWAYS,    // OpenAlways
+        CREATE_ALWAYS   // CreateAlways
+    };
+
+    wchar_t wide_filepath[1024];
+    if (!utf8_path_to_wide(filepath, filepath_length, wide_filepath, array_count(wide_filepath))) {
+        return nullptr;
+    }
+
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (hint == AccessHint::Sequential) {
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    } else if (hint == AccessHint::Random) {
+        flags |= FILE_FLAG_RANDOM_ACCESS;
+    }
+
+    // Other handles are allowed to read the file, so multiple systems can stream from it at once.
+    const DWORD share_mode = (access == FileAccess::Read) ? FILE_SHARE_READ : 0;
+
+    HANDLE file_handle = CreateFileW(
+        wide_filepath, s_access_flags[(uint8_t)access], share_mode, NULL,
+        s_creation_dispositions[(uint8_t)open_mode], flags, NULL
+    );
+
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    return (FileHandle)file_handle;
+}
+
+void Platform::close_file(FileHandle file)
+{
+    CloseHandle((HANDLE)file);
+}
+
+bool Platform::file_exists(const char* filepath, size_t filepath_length)
+{
+    wchar_t wide_filepath[1024];
+    if (!utf8_path_to_wide(filepath, filepath_length, wide_filepath, array_count(wide_filepath))) {
+        return false;
+    }
+
+    const DWORD attributes = GetFileAttributesW(wide_filepath);
+    return (attributes != INVALID_FILE_ATTRIBUTES) && !(attributes & FILE_ATTRIBUTE_DIRECTORY);
+}
+
+bool Platform::get_file_size(FileHandle file, uint64_t* out_file_size)
+{
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx((HANDLE)file, &file_size)) {
+        return false;
+    }
+
+    *out_file_size = (uint64_t)file_size.QuadPart;
+    return true;
+}
+
+bool Platform::set_file_size(FileHandle file, uint64_t file_size)
+{
+    FILE_END_OF_FILE_INFO end_of_file_info;
+    end_of_file_info.EndOfFile.QuadPart = (LONGLONG)file_size;
+    return SetFileInformationByHandle((HANDLE)file, FileEndOfFileInfo, &end_of_file_info, sizeof(end_of_file_info)) != 0;
+}
+
+bool Platform::iterate_directory(const char* directory_path, size_t directory_path_length, PFN_DirectoryIterator callback, void* user_data)
+{
+    wchar_t search_pattern[1024];
+    if (!utf8_path_to_wide(directory_path, directory_path_length, search_pattern, array_count(search_pattern) - 2)) {
+        return false;
+    }
+
+    size_t pattern_length = wcslen(search_pattern);
+    if (pattern_length > 0 && search_pattern[pattern_length - 1] != L'/' && search_pattern[pattern_length - 1] != L'\\') {
+        search_pattern[pattern_length++] = L'/';
+    }
+    search_pattern[pattern_length++] = L'*';
+    search_pattern[pattern_length] = 0;
+
+    WIN32_FIND_DATAW find_data;
+    HANDLE find_handle = FindFirstFileExW(search_pattern, FindExInfoBasic, &find_data, FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+    if (find_handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    do {
+        const wchar_t* name = find_data.cFileName;
+        if (name[0] == L'.' && (name[1] == 0 || (name[1] == L'.' && name[2] == 0))) {
+            continue;
+        }
+
+        char utf8_name[MAX_PATH * 3];
+        const int name_length = WideCharToMultiByte(CP_UTF8, 0, name, -1, utf8_name, sizeof(utf8_name), NULL, NULL);
+        if (name_length <= 0) {
+            continue;
+        }
+
+        const bool is_directory = (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+
+        // The length reported by WideCharToMultiByte includes the null-termination character.
+        if (!callback(utf8_name, (size_t)name_length - 1, is_directory, user_data)) {
+            break;
+        }
+    } while (FindNextFileW(find_handle, &find_data));
+
+    FindClose(find_handle);
+    return true;
+}
+
+// ReadFile and WriteFile take the number of bytes to transfer as a 32-bit DWORD, so larger transfers are
+//   split into chunks. The chunks are 2GiB, which keeps each transfer well below the limit of the count.
+static constexpr size_t MaxFileTransferChunkSize = 0x80000000;
+
+bool Platform::read_file(FileHandle file, uint64_t offset, void* destination, size_t bytes_count)
+{
+    uint8_t* bytes = (uint8_t*)destination;
+    while (bytes_count > 0) {
+        const DWORD chunk_size = (DWORD)Math::min<size_t>(bytes_count, MaxFileTransferChunkSize);
+
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+        DWORD read_bytes = 0;
+        if (!ReadFile((HANDLE)file, bytes, chunk_size, &read_bytes, &overlapped) || read_bytes != chunk_size) {
+            return false;
+        }
+
+        bytes += chunk_size;
+        offset += chunk_size;
+        bytes_count -= chunk_size;
+    }
+
+    return true;
+}
+
+bool Platform::write_file(FileHandle file, uint64_t offset, const void* source, size_t bytes_count)
+{
+    const uint8_t* bytes = (const uint8_t*)source;
+    while (bytes_count > 0) {
+        const DWORD chunk_size = (DWORD)Math::min<size_t>(bytes_count, MaxFileTransferChunkSize);
+
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+        DWORD written_bytes = 0;
+        if (!WriteFile((HANDLE)file, bytes, chunk_size, &written_bytes, &overlapped) || written_bytes != chunk_size) {
+            return false;
+        }
+
+        bytes += chunk_size;
+        offset += chunk_size;
+        bytes_count -= chunk_size;
+    }
+
+    return true;
+}
+
+uint32_t Platform::get_mapping_granularity()
+{
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return (uint32_t)system_info.dwAllocationGranularity;
+}
+
+void* Platform::map_file(FileHandle file, uint64_t offset, size_t bytes_count, bool writable, FileMappingHandle* out_mapping)
+{
+    // The mapping object covers the entire file, so its maximum size doesn't have to be specified.
+    HANDLE mapping_handle = CreateFileMappingW((HANDLE)file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL);
+    if (!mapping_handle) {
+        return nullptr;
+    }
+
+    void* view = MapViewOfFile(
+        mapping_handle, writable ? FILE_MAP_WRITE : FILE_MAP_READ,
+        (DWORD)(offset >> 32), (DWORD)(offset & 0xFFFFFFFF), bytes_count
+    );
+
+    if (!view) {
+        CloseHandle(mapping_handle);
+        return nullptr;
+    }
+
+    *out_mapping = (FileMappingHandle)mapping_handle;
+    return view;
+}
+
+void Platform::unmap_file(void* view, FileMappingHandle mapping)
+{
+    UnmapViewOfFile(view);
+    CloseHandle((HANDLE)mapping);
+}
+
+bool Platform::flush_mapped_file(void* view, size_t bytes_count)
+{
+    return FlushViewOfFile(view, bytes_count) != 0;
+}
+
+void Platform::advise_memory(void* address, size_t bytes_count, AccessHint hint)
+{
+    switch (hint) {
+        case AccessHint::WillNeed:
+        {
+            // Issues large, asynchronous reads for the pages that are not already resident.
+            WIN32_MEMORY_RANGE_ENTRY range;
+            range.VirtualAddress = address;
+            range.NumberOfBytes = bytes_count;
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+            break;
+        }
+
+        case AccessHint::DontNeed:
+        {
+            // Unlocking pages that are not locked removes them from the working set. For file-backed
+            //   memory the pages stay in the standby list, so they are not lost.
+            VirtualUnlock(address, bytes_count);
+            break;
+        }
+
+        // Windows has no per-range equivalents for these; the access pattern can only be specified when opening the file.
+        case AccessHint::Normal:
+        case AccessHint::Sequential:
+        case AccessHint::Random:
+            break;
+    }
+}
+
 } // namespace HC
\ No newline at end of file
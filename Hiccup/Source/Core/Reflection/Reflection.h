@@ -0,0 +1,305 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Containers/Span.h"
+#include "Core/Containers/StringView.h"
+
+namespace HC
+{
+
+// Identifies a type. Computed at compile time, and identical across module boundaries.
+using TypeID = uint64_t;
+
+/**
+ * Describes a field of a reflected type, at compile time.
+ * Passed to the visitors of 'TypeReflection<T>::for_each_field', so the code generated for each field
+ *   knows the exact field type and accesses the field directly, without any dispatch.
+ */
+template<typename OwnerType, typename FieldType>
+struct Field
+{
+    using Owner = OwnerType;
+    using Type = FieldType;
+
+    const char* name;
+    FieldType OwnerType::* pointer;
+
+    ALWAYS_INLINE constexpr FieldType& get(OwnerType& owner) const { return owner.*pointer; }
+    ALWAYS_INLINE constexpr const FieldType& get(const OwnerType& owner) const { return owner.*pointer; }
+};
+
+struct FieldInfo;
+
+using PFN_GetFields = Span<const FieldInfo>(*)();
+
+/**
+ * Describes a field of a reflected type, at runtime. Intended for the code that handles
+ *   arbitrary types (the editor property grid, for example).
+ */
+struct FieldInfo
+{
+    const char* name;
+    uint32_t offset;
+    uint32_t size;
+    TypeID type_id;
+
+    // Returns the fields of the field type, if the field type is reflected. Null otherwise.
+    PFN_GetFields get_fields;
+};
+
+template<typename EnumType>
+struct EnumEntry
+{
+    EnumType value;
+    const char* name;
+};
+
+/**
+ * Specialized (by 'HC_REFLECT_TYPE_BEGIN') for each reflected type.
+ * Each specialization provides:
+ *   'IsReflected'    - true.
+ *   'Name'           - the name of the type, as written in the reflection declaration.
+ *   'for_each_field' - invokes a visitor with the 'Field' of each reflected field, in declaration order.
+ */
+template<typename T>
+struct TypeReflection
+{
+    static constexpr bool IsReflected = false;
+};
+
+/**
+ * Specialized (by 'HC_REFLECT_ENUM_BEGIN') for each reflected enum.
+ * Each specialization provides:
+ *   'IsReflected' - true.
+ *   'Name'        - the name of the enum.
+ *   'Entries'     - an array with the value and the name of each reflected enumerator.
+ */
+template<typename EnumType>
+struct EnumReflection
+{
+    static constexpr bool IsReflected = false;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Reflection.
+ *----------------------------------------------------------------
+ * Compile-time type reflection. RTTI is disabled, so types are identified by a hash of their
+ *   name (taken from the function signature), and the fields and enumerators are declared with
+ *   the reflection macros below. Everything that can be computed at compile time is 'constexpr'.
+ *
+ * Usage (at global scope, after the type declaration):
+ *   HC_REFLECT_TYPE_BEGIN(HC::TransformComponent)
+ *       HC_REFLECT_FIELD(translation)
+ *       HC_REFLECT_FIELD(rotation)
+ *   HC_REFLECT_TYPE_END()
+ *
+ *   HC_REFLECT_ENUM_BEGIN(HC::AssetPriority)
+ *       HC_REFLECT_ENUMERATOR(High)
+ *       HC_REFLECT_ENUMERATOR(Normal)
+ *   HC_REFLECT_ENUM_END()
+ */
+struct Reflection
+{
+public:
+    /** FNV-1a. Usable at compile time. */
+    static constexpr uint64_t hash_string(const char* string)
+    {
+        uint64_t hash = 0xCBF29CE484222325;
+        for (; *string; ++string)
+        {
+            hash = (hash ^ (uint8_t)*string) * 0x100000001B3;
+        }
+        return hash;
+    }
+
+    template<typename T>
+    static constexpr TypeID get_type_id()
+    {
+        // The function signature contains the name of the type, so its hash is unique for each type.
+        // The signature spells the type the same way in every module, unlike the address of a static.
+        return hash_string(HC_FUNCTION_SIG);
+    }
+
+    template<typename T>
+    static constexpr bool is_reflected()
+    {
+        return TypeReflection<T>::IsReflected;
+    }
+
+public:
+    template<typename T>
+    static constexpr uint32_t get_fields_count()
+    {
+        uint32_t count = 0;
+        TypeReflection<T>::for_each_field([&count](auto) { ++count; });
+        return count;
+    }
+
+    /** Visits each reflected field of the type, in declaration order. The visitor receives a 'Field<T, FieldType>'. */
+    template<typename T, typename Visitor>
+    ALWAYS_INLINE static constexpr void for_each_field(Visitor&& visitor)
+    {
+        static_assert(TypeReflection<T>::IsReflected, "The type is not reflected!");
+        TypeReflection<T>::for_each_field(visitor);
+    }
+
+    /**
+     * @return The runtime description of the reflected fields. Built once, on the first call.
+     * The table is a function-local static, so its initialization is thread-safe.
+     */
+    template<typename T>
+    static Span<const FieldInfo> get_fields()
+    {
+        static_assert(TypeReflection<T>::IsReflected, "The type is not reflected!");
+        constexpr uint32_t FieldsCount = get_fields_count<T>();
+
+        // The extra element keeps the array valid for types without reflected fields.
+        struct FieldsTable
+        {
+            FieldInfo fields[FieldsCount + 1];
+        };
+
+        static const FieldsTable s_table = []() -> FieldsTable
+        {
+            FieldsTable table = {};
+            uint32_t index = 0;
+            TypeReflection<T>::for_each_field([&table, &index](auto field)
+            {
+                using FieldType = typename decltype(field)::Type;
+
+                // The offset is computed from a dummy, non-null address, the same way 'offsetof' does it.
+                const T* dummy = (const T*)(uintptr_t)alignof(T);
+
+                FieldInfo& info = table.fields[index++];
+                info.name = field.name;
+                info.offset = (uint32_t)((const uint8_t*)&field.get(*dummy) - (const uint8_t*)dummy);
+                info.size = (uint32_t)sizeof(FieldType);
+                info.type_id = get_type_id<FieldType>();
+                info.get_fields = get_fields_function<FieldType>();
+            });
+            return table;
+        }();
+
+        return Span<const FieldInfo>(s_table.fields, FieldsCount);
+    }
+
+    /** @return The name given to the reflected type. */
+    template<typename T>
+    static constexpr const char* get_type_name()
+    {
+        static_assert(TypeReflection<T>::IsReflected, "The type is not reflected!");
+        return TypeReflection<T>::Name;
+    }
+
+public:
+    template<typename EnumType>
+    static constexpr Span<const EnumEntry<EnumType>> get_enum_entries()
+    {
+        static_assert(EnumReflection<EnumType>::IsReflected, "The enum is not reflected!");
+        return Span<const EnumEntry<EnumType>>(EnumReflection<EnumType>::Entries, array_count(EnumReflection<EnumType>::Entries));
+    }
+
+    /** @return The name of the enumerator, or nullptr if the value isn't a reflected enumerator. */
+    template<typename EnumType>
+    static constexpr const char* enum_to_string(EnumType value)
+    {
+        static_assert(EnumReflection<EnumType>::IsReflected, "The enum is not reflected!");
+        for (const EnumEntry<EnumType>& entry : EnumReflection<EnumType>::Entries)
+        {
+            if (entry.value == value)
+            {
+                return entry.name;
+            }
+        }
+        return nullptr;
+    }
+
+    /** Finds the enumerator with the given name (case sensitive). @return False if there is none. */
+    template<typename EnumType>
+    static bool string_to_enum(StringView name, EnumType& out_value)
+    {
+        static_assert(EnumReflection<EnumType>::IsReflected, "The enum is not reflected!");
+        for (const EnumEntry<EnumType>& entry : EnumReflection<EnumType>::Entries)
+        {
+            if (are_names_equal(entry.name, name))
+            {
+                out_value = entry.value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    template<typename T>
+    static constexpr PFN_GetFields get_fields_function()
+    {
+        if constexpr (TypeReflection<T>::IsReflected)
+        {
+            return &get_fields<T>;
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    static bool are_names_equal(const char* name, StringView other)
+    {
+        size_t index = 0;
+        for (; index < other.bytes_count(); ++index)
+        {
+            if (name[index] != other.c_str()[index] || name[index] == 0)
+            {
+                return false;
+            }
+        }
+        return (name[index] == 0);
+    }
+};
+
+} // namespace HC
+
+// The reflection declarations specialize templates of the HC namespace, so they must be placed at global scope.
+#define HC_REFLECT_TYPE_BEGIN(TYPE)                                         \
+    namespace HC {                                                          \
+    template<>                                                              \
+    struct TypeReflection<TYPE>                                             \
+    {                                                                       \
+        using ReflectedType = TYPE;                                         \
+        static constexpr bool IsReflected = true;                           \
+        static constexpr const char* Name = #TYPE;                          \
+                                                                            \
+        template<typename Visitor>                                          \
+        static constexpr void for_each_field(Visitor&& visitor)             \
+        {
+
+#define HC_REFLECT_FIELD(FIELD) \
+            visitor(::HC::Field<ReflectedType, decltype(ReflectedType::FIELD)> { #FIELD, &ReflectedType::FIELD });
+
+#define HC_REFLECT_TYPE_END()                                               \
+        }                                                                   \
+    };                                                                      \
+    }
+
+#define HC_REFLECT_ENUM_BEGIN(ENUM_TYPE)                                    \
+    namespace HC {                                                          \
+    template<>                                                              \
+    struct EnumReflection<ENUM_TYPE>                                        \
+    {                                                                       \
+        using ReflectedType = ENUM_TYPE;                                    \
+        static constexpr bool IsReflected = true;                           \
+        static constexpr const char* Name = #ENUM_TYPE;                     \
+        static constexpr ::HC::EnumEntry<ENUM_TYPE> Entries[] =             \
+        {
+
+#define HC_REFLECT_ENUMERATOR(ENUMERATOR) \
+            { ReflectedType::ENUMERATOR, #ENUMERATOR },
+
+#define HC_REFLECT_ENUM_END()                                               \
+        };                                                                  \
+    };                                                                      \
+    }
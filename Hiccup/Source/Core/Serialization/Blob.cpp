@@ -0,0 +1,149 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "Blob.h"
+#include "BlobWriter.h"
+
+namespace HC
+{
+
+ErrorCode BlobView::open(Span<const uint8_t> data)
+{
+    m_header = nullptr;
+
+    if (data.count() < sizeof(BlobHeader))
+    {
+        HC_LOG_ERROR("BlobView::open - The data is too small to be a blob!");
+        return ErrorCode::CorruptedData;
+    }
+
+    const BlobHeader* header = (const BlobHeader*)data.elements();
+    if (header->magic != Magic || header->format_version != FormatVersion)
+    {
+        HC_LOG_ERROR("BlobView::open - Invalid blob header! The blob is either corrupted or was written by an incompatible version.");
+        return ErrorCode::CorruptedData;
+    }
+
+    if (header->size != data.count() || header->root_offset < sizeof(BlobHeader) || header->root_offset >= header->size)
+    {
+        HC_LOG_ERROR("BlobView::open - The blob size doesn't match its header!");
+        return ErrorCode::CorruptedData;
+    }
+
+    m_header = header;
+    return ErrorCode::Success;
+}
+
+bool BlobView::check_root(uint32_t schema_version, size_t root_size, size_t root_alignment) const
+{
+    if (m_header->schema_version != schema_version)
+    {
+        HC_LOG_ERROR("BlobView::get_root - The blob was written with schema version %u, but version %u is expected!", m_header->schema_version, schema_version);
+        return false;
+    }
+
+    // 'open' guarantees that the root offset is inside the blob, so the subtraction can't wrap around.
+    const uintptr_t root_address = (uintptr_t)m_header + m_header->root_offset;
+    if (root_size > m_header->size - m_header->root_offset || root_address % root_alignment != 0)
+    {
+        HC_LOG_ERROR("BlobView::get_root - The root is either truncated or misaligned! The blob is corrupted.");
+        return false;
+    }
+
+    return true;
+}
+
+ErrorCode BlobFile::open(StringView filepath)
+{
+    close();
+
+    HC_CHECK_ERROR(m_file.open(filepath, FileMapMode::Readonly));
+
+    const ErrorCode error = m_view.open(m_file.readonly_span());
+    if (error != ErrorCode::Success)
+    {
+        close();
+        return error;
+    }
+
+    return ErrorCode::Success;
+}
+
+void BlobFile::close()
+{
+    m_view = BlobView();
+    m_file.close();
+}
+
+BlobWriter::BlobWriter()
+{
+    allocate(sizeof(BlobHeader), alignof(BlobHeader));
+
+    BlobHeader* header = (BlobHeader*)get_data(0);
+    header->magic = BlobView::Magic;
+    header->format_version = BlobView::FormatVersion;
+}
+
+uint32_t BlobWriter::allocate(size_t bytes_count, size_t alignment)
+{
+    HC_ASSERT(alignment > 0 && alignment <= MaxAlignment && (alignment & (alignment - 1)) == 0); // Invalid alignment!
+
+    const size_t offset = (m_data.size() + alignment - 1) & ~(alignment - 1);
+    const size_t new_size = offset + bytes_count;
+
+    // Offsets are stored as 32-bit signed integers.
+    HC_ASSERT(new_size <= 0x7FFFFFFF); // The blob is too big!
+
+    const size_t old_size = m_data.size();
+    m_data.add_uninitialized(new_size - old_size);
+    Memory::zero(m_data.data() + old_size, new_size - old_size);
+
+    return (uint32_t)offset;
+}
+
+void BlobWriter::write_string(uint32_t string_offset, StringView string)
+{
+    if (string.bytes_count() == 0)
+    {
+        link_array(string_offset, 0, 0);
+        return;
+    }
+
+    // The null-terminator is stored, but not counted, so 'BlobString::c_str' can be used directly.
+    const uint32_t characters_offset = allocate(string.bytes_count() + 1, alignof(char));
+    Memory::copy(get_data(characters_offset), string.c_str(), string.bytes_count());
+
+    link_array(string_offset, characters_offset, (uint32_t)string.bytes_count());
+}
+
+void BlobWriter::finalize(Buffer& out_buffer)
+{
+    update_header();
+
+    out_buffer.allocate(m_data.size());
+    Memory::copy(out_buffer.data, m_data.data(), m_data.size());
+}
+
+ErrorCode BlobWriter::write_to_file(StringView filepath)
+{
+    update_header();
+    return FileSystem::write_entire_file(filepath, Span<const uint8_t>(m_data.data(), m_data.size()));
+}
+
+void BlobWriter::set_root(uint32_t root_offset, uint32_t schema_version)
+{
+    BlobHeader* header = (BlobHeader*)get_data(0);
+    HC_ASSERT(header->root_offset == 0); // The blob root was already allocated!
+
+    header->root_offset = root_offset;
+    header->schema_version = schema_version;
+}
+
+void BlobWriter::update_header()
+{
+    BlobHeader* header = (BlobHeader*)get_data(0);
+    HC_ASSERT(header->root_offset != 0); // The blob has no root!
+
+    header->size = (uint32_t)m_data.size();
+}
+
+} // namespace HC
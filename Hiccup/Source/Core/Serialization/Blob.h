@@ -0,0 +1,347 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Containers/Span.h"
+#include "Core/Containers/StringView.h"
+#include "Core/Containers/Hash.h"
+#include "Core/FileSystem/FileSystem.h"
+
+namespace HC
+{
+
+/**
+ * A blob is a single memory block that can be used in-place, as soon as it is loaded or mapped.
+ * Instead of pointers, all references inside a blob are stored as offsets relative to the
+ *   location of the reference itself. Because of that, a blob can be placed at any address
+ *   and no deserialization (or pointer fix-up) pass is ever required.
+ * Blobs are built by 'BlobWriter' and read by 'BlobView' (or 'BlobFile' for files).
+ */
+struct BlobHeader
+{
+    uint32_t magic;
+    uint32_t format_version;
+
+    // The version of the root type layout, as declared by its 'SchemaVersion' constant.
+    uint32_t schema_version;
+
+    uint32_t root_offset;
+    uint32_t size;
+
+    uint32_t reserved;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Blob Pointer.
+ *----------------------------------------------------------------
+ * A self-relative pointer. A zero offset is the null pointer.
+ */
+template<typename T>
+class BlobPtr
+{
+public:
+    HC_NON_COPIABLE(BlobPtr)
+    HC_NON_MOVABLE(BlobPtr)
+
+public:
+    ALWAYS_INLINE const T* get() const
+    {
+        return (m_offset != 0) ? (const T*)((const uint8_t*)&m_offset + m_offset) : nullptr;
+    }
+
+    ALWAYS_INLINE const T* operator->() const { return get(); }
+    ALWAYS_INLINE const T& operator*() const { return *get(); }
+
+    ALWAYS_INLINE bool is_null() const { return m_offset == 0; }
+
+private:
+    int32_t m_offset;
+
+    friend class BlobWriter;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Blob Array.
+ *----------------------------------------------------------------
+ * A self-relative pointer to a contiguous array of elements, stored elsewhere in the blob.
+ */
+template<typename T>
+class BlobArray
+{
+public:
+    HC_NON_COPIABLE(BlobArray)
+    HC_NON_MOVABLE(BlobArray)
+
+public:
+    ALWAYS_INLINE const T* elements() const
+    {
+        return (m_offset != 0) ? (const T*)((const uint8_t*)&m_offset + m_offset) : nullptr;
+    }
+
+    ALWAYS_INLINE uint32_t count() const { return m_count; }
+    ALWAYS_INLINE bool is_empty() const { return m_count == 0; }
+
+    ALWAYS_INLINE Span<const T> to_span() const { return Span<const T>(elements(), m_count); }
+
+    ALWAYS_INLINE const T& operator[](size_t index) const
+    {
+        HC_ASSERT(index < m_count); // Index out of range!
+        return elements()[index];
+    }
+
+    ALWAYS_INLINE const T* begin() const { return elements(); }
+    ALWAYS_INLINE const T* end() const { return elements() + m_count; }
+
+private:
+    int32_t m_offset;
+    uint32_t m_count;
+
+    friend class BlobWriter;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Blob Fixed Array.
+ *----------------------------------------------------------------
+ * Stores the elements inline, as 'FixedArray' does.
+ */
+template<typename T, size_t C>
+class BlobFixedArray
+{
+public:
+    HC_NON_COPIABLE(BlobFixedArray)
+    HC_NON_MOVABLE(BlobFixedArray)
+
+public:
+    ALWAYS_INLINE static constexpr size_t count() { return C; }
+
+    ALWAYS_INLINE const T* elements() const { return &m_elements[0]; }
+    ALWAYS_INLINE Span<const T> to_span() const { return Span<const T>(elements(), C); }
+
+    ALWAYS_INLINE const T& operator[](size_t index) const
+    {
+        HC_ASSERT(index < C); // Index out of range!
+        return m_elements[index];
+    }
+
+private:
+    T m_elements[C];
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Blob String.
+ *----------------------------------------------------------------
+ * An UTF-8 string. It is always null-terminated, but the terminator is not part of the view.
+ */
+class BlobString
+{
+public:
+    HC_NON_COPIABLE(BlobString)
+    HC_NON_MOVABLE(BlobString)
+
+public:
+    ALWAYS_INLINE const char* c_str() const { return m_characters.is_empty() ? "" : m_characters.elements(); }
+    ALWAYS_INLINE size_t bytes_count() const { return m_characters.count(); }
+
+    ALWAYS_INLINE StringView to_view() const { return StringView(c_str(), bytes_count()); }
+
+private:
+    BlobArray<char> m_characters;
+
+    friend class BlobWriter;
+};
+
+/**
+ * The hash functions used by 'BlobHashMap'. They are part of the blob format, as the hashes
+ *   are computed when the blob is written, and must match the ones computed when it is read.
+ */
+ALWAYS_INLINE uint64_t compute_blob_key_hash(StringView key)
+{
+    // FNV-1a.
+    uint64_t hash = 0xCBF29CE484222325;
+    for (size_t index = 0; index < key.bytes_count(); ++index)
+    {
+        hash ^= (uint8_t)key.c_str()[index];
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+template<typename T>
+ALWAYS_INLINE uint64_t compute_blob_key_hash(const T& key)
+{
+    return compute_hash(key);
+}
+
+ALWAYS_INLINE bool blob_keys_equal(const BlobString& blob_key, StringView key)
+{
+    if (blob_key.bytes_count() != key.bytes_count())
+    {
+        return false;
+    }
+
+    for (size_t index = 0; index < key.bytes_count(); ++index)
+    {
+        if (blob_key.c_str()[index] != key.c_str()[index])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+ALWAYS_INLINE bool blob_keys_equal(const T& blob_key, const T& key)
+{
+    return blob_key == key;
+}
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Blob Hash Map.
+ *----------------------------------------------------------------
+ * A read-only, open-addressing hash table, built when the blob is written.
+ * Lookups are done in-place, just as with 'HashTable'.
+ */
+template<typename KeyType, typename ValueType>
+class BlobHashMap
+{
+public:
+    HC_NON_COPIABLE(BlobHashMap)
+    HC_NON_MOVABLE(BlobHashMap)
+
+public:
+    ALWAYS_INLINE uint32_t size() const { return m_keys.count(); }
+
+    ALWAYS_INLINE const BlobArray<KeyType>& keys() const { return m_keys; }
+    ALWAYS_INLINE const BlobArray<ValueType>& values() const { return m_values; }
+
+    /**
+     * @param key The key to search for. For string keys, it is a 'StringView'.
+     *
+     * @return The value associated with the key, or nullptr if the key isn't in the map.
+     */
+    template<typename LookupKeyType>
+    const ValueType* find(const LookupKeyType& key) const
+    {
+        if (m_slots.is_empty())
+        {
+            return nullptr;
+        }
+
+        const uint64_t hash = compute_blob_key_hash(key);
+        const uint32_t mask = m_slots.count() - 1;
+
+        for (uint32_t slot = get_first_slot(hash, mask); m_slots[slot] != 0; slot = (slot + 1) & mask)
+        {
+            const uint32_t index = m_slots[slot] - 1;
+            if (m_hashes[index] == hash && blob_keys_equal(m_keys[index], key))
+            {
+                return &m_values[index];
+            }
+        }
+
+        return nullptr;
+    }
+
+    ALWAYS_INLINE static uint32_t get_first_slot(uint64_t hash, uint32_t mask)
+    {
+        return (uint32_t)get_hash_bucket_index(hash, mask);
+    }
+
+private:
+    // The number of slots is always a power of two. Each slot stores the entry index plus one; zero is an empty slot.
+    BlobArray<uint32_t> m_slots;
+
+    BlobArray<uint64_t> m_hashes;
+    BlobArray<KeyType> m_keys;
+    BlobArray<ValueType> m_values;
+
+    template<typename T>
+    friend struct BlobTraits;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Blob View.
+ *----------------------------------------------------------------
+ * Validates the header of a blob that is already in memory, and provides access to its root.
+ * Only the header is validated - the contents are used as they are, so blobs must come
+ *   from a trusted source (such as the cooked game content).
+ */
+class BlobView
+{
+public:
+    static constexpr uint32_t Magic = 0x42434348; // 'HCCB'
+    static constexpr uint32_t FormatVersion = 1;
+
+public:
+    BlobView()
+        : m_header(nullptr)
+    {}
+
+public:
+    /** The memory must stay valid, and must not move, for as long as the view is used. */
+    HC_API ErrorCode open(Span<const uint8_t> data);
+
+    ALWAYS_INLINE bool is_open() const { return m_header != nullptr; }
+
+    ALWAYS_INLINE const BlobHeader* get_header() const { return m_header; }
+
+    /**
+     * @return The root of the blob, or nullptr if the blob was written with a different version
+     *   of the root type (its 'SchemaVersion' constant), or if the root doesn't fit in the blob.
+     */
+    template<typename T>
+    const T* get_root() const
+    {
+        HC_ASSERT(is_open()); // The blob view is not open!
+        if (!check_root(T::SchemaVersion, sizeof(T), alignof(T)))
+        {
+            return nullptr;
+        }
+        return (const T*)((const uint8_t*)m_header + m_header->root_offset);
+    }
+
+private:
+    // Checks the schema version, and that the root is aligned and lies entirely inside the blob.
+    HC_API bool check_root(uint32_t schema_version, size_t root_size, size_t root_alignment) const;
+
+private:
+    const BlobHeader* m_header;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Blob File.
+ *----------------------------------------------------------------
+ * Memory-maps a blob file. Loading it costs only the page faults of the parts that are read.
+ */
+class BlobFile
+{
+public:
+    HC_NON_COPIABLE(BlobFile)
+
+    BlobFile() = default;
+
+public:
+    HC_API ErrorCode open(StringView filepath);
+    HC_API void close();
+
+    ALWAYS_INLINE bool is_open() const { return m_view.is_open(); }
+
+    ALWAYS_INLINE const BlobView& get_view() const { return m_view; }
+
+    template<typename T>
+    ALWAYS_INLINE const T* get_root() const { return m_view.get_root<T>(); }
+
+private:
+    MappedFile m_file;
+    BlobView m_view;
+};
+
+} // namespace HC
@@ -0,0 +1,367 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Memory/Buffer.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/FixedArray.h"
+#include "Core/Containers/HashTable.h"
+#include "Core/Containers/String.h"
+#include "Core/Math/Geometry.h"
+#include "Core/Math/Transform.h"
+
+#include "Blob.h"
+
+namespace HC
+{
+
+class BlobWriter;
+
+/**
+ * Describes how a runtime type is stored in a blob.
+ * Each specialization provides:
+ *   'Type'      - the in-blob representation of the runtime type.
+ *   'IsTrivial' - whether the runtime type is stored as it is, so arrays of it can be copied in bulk.
+ *   'write'     - writes a value at the given blob offset, where a 'Type' has already been allocated.
+ * Types without a specialization can't be serialized.
+ */
+template<typename T>
+struct BlobTraits;
+
+template<typename T>
+using BlobType = typename BlobTraits<T>::Type;
+
+/**
+ * A typed offset into the blob being written.
+ * Unlike pointers, references stay valid when the blob grows.
+ */
+template<typename T>
+struct BlobRef
+{
+    uint32_t offset;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Blob Writer.
+ *----------------------------------------------------------------
+ * Builds a blob, appending each allocation to a single growing memory block.
+ * Typical usage:
+ *   BlobWriter writer;
+ *   BlobRef<SceneBlob> root = writer.allocate_root<SceneBlob>();
+ *   writer.write(root, &SceneBlob::name, scene.name);
+ *   writer.write(root, &SceneBlob::entities, scene.entities);
+ *   writer.write_to_file("Scene.hcblob"sv);
+ */
+class BlobWriter
+{
+public:
+    HC_NON_COPIABLE(BlobWriter)
+    HC_NON_MOVABLE(BlobWriter)
+
+    // The maximum alignment that an in-blob type can require.
+    static constexpr size_t MaxAlignment = 16;
+
+public:
+    HC_API BlobWriter();
+
+public:
+    /**
+     * Allocates zero-initialized memory in the blob.
+     *
+     * @return The offset of the allocated memory, relative to the beginning of the blob.
+     */
+    HC_API uint32_t allocate(size_t bytes_count, size_t alignment);
+
+    template<typename T>
+    ALWAYS_INLINE BlobRef<T> allocate()
+    {
+        return { allocate(sizeof(T), alignof(T)) };
+    }
+
+    /** Allocates the root of the blob. The root type must declare a 'SchemaVersion' constant, which is checked when the blob is read. */
+    template<typename T>
+    ALWAYS_INLINE BlobRef<T> allocate_root()
+    {
+        const BlobRef<T> root = allocate<T>();
+        set_root(root.offset, T::SchemaVersion);
+        return root;
+    }
+
+    /** @return A pointer to the blob memory. Invalidated by any allocation. */
+    ALWAYS_INLINE uint8_t* get_data(uint32_t offset)
+    {
+        HC_ASSERT(offset < m_data.size()); // Offset out of range!
+        return m_data.data() + offset;
+    }
+
+    /** @return A pointer to the referenced object. Invalidated by any allocation. */
+    template<typename T>
+    ALWAYS_INLINE T* get(BlobRef<T> ref)
+    {
+        return (T*)get_data(ref.offset);
+    }
+
+    ALWAYS_INLINE size_t get_size() const { return m_data.size(); }
+
+public:
+    /**
+     * Writes a runtime value into a field of an in-blob object.
+     * The field type must be the blob representation of the value type.
+     */
+    template<typename OwnerType, typename FieldType, typename ValueType>
+    void write(BlobRef<OwnerType> owner, FieldType OwnerType::* field, const ValueType& value)
+    {
+        static_assert(sizeof(FieldType) == sizeof(BlobType<ValueType>), "The field type doesn't match the value type!");
+
+        OwnerType* owner_object = get(owner);
+        const uint32_t field_offset = owner.offset + (uint32_t)((uint8_t*)&(owner_object->*field) - (uint8_t*)owner_object);
+        BlobTraits<ValueType>::write(*this, field_offset, value);
+    }
+
+    /** Writes a runtime value at the given offset, where its blob representation was allocated. */
+    template<typename ValueType>
+    ALWAYS_INLINE void write(uint32_t offset, const ValueType& value)
+    {
+        BlobTraits<ValueType>::write(*this, offset, value);
+    }
+
+    /** Makes the blob pointer located at 'pointer_offset' point to 'target_offset'. */
+    ALWAYS_INLINE void link_pointer(uint32_t pointer_offset, uint32_t target_offset)
+    {
+        ((BlobPtr<uint8_t>*)get_data(pointer_offset))->m_offset = (int32_t)target_offset - (int32_t)pointer_offset;
+    }
+
+    /** Makes the blob array located at 'array_offset' reference 'count' elements, starting at 'elements_offset'. */
+    ALWAYS_INLINE void link_array(uint32_t array_offset, uint32_t elements_offset, uint32_t count)
+    {
+        BlobArray<uint8_t>* blob_array = (BlobArray<uint8_t>*)get_data(array_offset);
+        blob_array->m_offset = (count > 0) ? (int32_t)elements_offset - (int32_t)array_offset : 0;
+        blob_array->m_count = count;
+    }
+
+    /**
+     * Writes an array of runtime values, and links the blob array at 'array_offset' to it.
+     * Trivial element types are copied in bulk.
+     */
+    template<typename T>
+    void write_array(uint32_t array_offset, const T* elements, size_t count)
+    {
+        using ElementType = BlobType<T>;
+
+        if (count == 0)
+        {
+            link_array(array_offset, 0, 0);
+            return;
+        }
+
+        const uint32_t elements_offset = allocate(count * sizeof(ElementType), alignof(ElementType));
+        if constexpr (BlobTraits<T>::IsTrivial)
+        {
+            Memory::copy(get_data(elements_offset), elements, count * sizeof(ElementType));
+        }
+        else
+        {
+            for (size_t index = 0; index < count; ++index)
+            {
+                BlobTraits<T>::write(*this, elements_offset + (uint32_t)(index * sizeof(ElementType)), elements[index]);
+            }
+        }
+
+        link_array(array_offset, elements_offset, (uint32_t)count);
+    }
+
+    /** Writes a string, and links the blob string at 'string_offset' to it. */
+    HC_API void write_string(uint32_t string_offset, StringView string);
+
+public:
+    /** Copies the finished blob into a newly allocated buffer, owned by the caller. */
+    HC_API void finalize(Buffer& out_buffer);
+
+    HC_API ErrorCode write_to_file(StringView filepath);
+
+private:
+    HC_API void set_root(uint32_t root_offset, uint32_t schema_version);
+
+    // Updates the size stored in the header.
+    HC_API void update_header();
+
+private:
+    Array<uint8_t> m_data;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Blob Traits.
+ *----------------------------------------------------------------
+ */
+
+// Types that are stored exactly as they are in memory: no pointers, no owned memory.
+template<typename T>
+struct TrivialBlobTraits
+{
+    using Type = T;
+    static constexpr bool IsTrivial = true;
+
+    ALWAYS_INLINE static void write(BlobWriter& writer, uint32_t offset, const T& value)
+    {
+        Memory::copy(writer.get_data(offset), &value, sizeof(T));
+    }
+};
+
+// Declares a user-defined plain-old-data type as storable in a blob.
+#define HC_DECLARE_TRIVIAL_BLOB_TYPE(TYPE) \
+    template<> struct BlobTraits<TYPE> : public TrivialBlobTraits<TYPE> {};
+
+HC_DECLARE_TRIVIAL_BLOB_TYPE(bool)
+HC_DECLARE_TRIVIAL_BLOB_TYPE(char)
+HC_DECLARE_TRIVIAL_BLOB_TYPE(uint8_t)
+HC_DECLARE_TRIVIAL_BLOB_TYPE(uint16_t)
+HC_DECLARE_TRIVIAL_BLOB_TYPE(uint32_t)
+HC_DECLARE_TRIVIAL_BLOB_TYPE(uint64_t)
+HC_DECLARE_TRIVIAL_BLOB_TYPE(int8_t)
+HC_DECLARE_TRIVIAL_BLOB_TYPE(int16_t)
+HC_DECLARE_TRIVIAL_BLOB_TYPE(int32_t)
+HC_DECLARE_TRIVIAL_BLOB_TYPE(int64_t)
+HC_DECLARE_TRIVIAL_BLOB_TYPE(float32_t)
+HC_DECLARE_TRIVIAL_BLOB_TYPE(float64_t)
+
+template<typename T> struct BlobTraits<Vector2T<T>> : public TrivialBlobTraits<Vector2T<T>> {};
+template<typename T> struct BlobTraits<Vector3T<T>> : public TrivialBlobTraits<Vector3T<T>> {};
+template<typename T> struct BlobTraits<Vector4T<T>> : public TrivialBlobTraits<Vector4T<T>> {};
+template<typename T> struct BlobTraits<Matrix3T<T>> : public TrivialBlobTraits<Matrix3T<T>> {};
+template<typename T> struct BlobTraits<Matrix4T<T>> : public TrivialBlobTraits<Matrix4T<T>> {};
+template<typename T> struct BlobTraits<RayT<T>> : public TrivialBlobTraits<RayT<T>> {};
+template<typename T> struct BlobTraits<AABB2T<T>> : public TrivialBlobTraits<AABB2T<T>> {};
+template<typename T> struct BlobTraits<AABB3T<T>> : public TrivialBlobTraits<AABB3T<T>> {};
+
+template<>
+struct BlobTraits<String>
+{
+    using Type = BlobString;
+    static constexpr bool IsTrivial = false;
+
+    ALWAYS_INLINE static void write(BlobWriter& writer, uint32_t offset, const String& value)
+    {
+        // The string bytes count includes the null-terminator.
+        writer.write_string(offset, StringView(value.c_str(), value.bytes_count() - 1));
+    }
+};
+
+template<>
+struct BlobTraits<StringView>
+{
+    using Type = BlobString;
+    static constexpr bool IsTrivial = false;
+
+    ALWAYS_INLINE static void write(BlobWriter& writer, uint32_t offset, StringView value)
+    {
+        writer.write_string(offset, value);
+    }
+};
+
+template<typename T, typename AllocatorType>
+struct BlobTraits<Array<T, AllocatorType>>
+{
+    using Type = BlobArray<BlobType<T>>;
+    static constexpr bool IsTrivial = false;
+
+    ALWAYS_INLINE static void write(BlobWriter& writer, uint32_t offset, const Array<T, AllocatorType>& value)
+    {
+        writer.write_array(offset, value.data(), value.size());
+    }
+};
+
+template<typename T>
+struct BlobTraits<Span<T>>
+{
+    using Type = BlobArray<BlobType<Types::RemoveConstType<T>>>;
+    static constexpr bool IsTrivial = false;
+
+    ALWAYS_INLINE static void write(BlobWriter& writer, uint32_t offset, const Span<T>& value)
+    {
+        writer.write_array(offset, (const Types::RemoveConstType<T>*)value.elements(), value.count());
+    }
+};
+
+template<typename T, size_t C>
+struct BlobTraits<FixedArray<T, C>>
+{
+    using Type = BlobFixedArray<BlobType<T>, C>;
+    static constexpr bool IsTrivial = BlobTraits<T>::IsTrivial;
+
+    static void write(BlobWriter& writer, uint32_t offset, const FixedArray<T, C>& value)
+    {
+        for (size_t index = 0; index < C; ++index)
+        {
+            BlobTraits<T>::write(writer, offset + (uint32_t)(index * sizeof(BlobType<T>)), value[index]);
+        }
+    }
+};
+
+// Gets the view used to hash and compare runtime keys, so they match the in-blob keys.
+template<typename T>
+ALWAYS_INLINE const T& get_blob_lookup_key(const T& key) { return key; }
+
+ALWAYS_INLINE StringView get_blob_lookup_key(const String& key) { return StringView(key.c_str(), key.bytes_count() - 1); }
+
+template<typename KeyType, typename ValueType, typename AllocatorType, typename Hasher, typename Comparator>
+struct BlobTraits<HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>>
+{
+    using Type = BlobHashMap<BlobType<KeyType>, BlobType<ValueType>>;
+    static constexpr bool IsTrivial = false;
+
+    static void write(BlobWriter& writer, uint32_t offset, const HashTable<KeyType, ValueType, AllocatorType, Hasher, Comparator>& value)
+    {
+        using BlobKeyType = BlobType<KeyType>;
+        using BlobValueType = BlobType<ValueType>;
+
+        const uint32_t count = (uint32_t)value.size();
+
+        // Keeping the load factor at most 0.5, so probe sequences stay short.
+        uint32_t slots_count = 0;
+        if (count > 0)
+        {
+            slots_count = 1;
+            while (slots_count < 2 * count)
+            {
+                slots_count <<= 1;
+            }
+        }
+
+        const uint32_t slots_offset = writer.allocate(slots_count * sizeof(uint32_t), alignof(uint32_t));
+        const uint32_t hashes_offset = writer.allocate(count * sizeof(uint64_t), alignof(uint64_t));
+        const uint32_t keys_offset = writer.allocate(count * sizeof(BlobKeyType), alignof(BlobKeyType));
+        const uint32_t values_offset = writer.allocate(count * sizeof(BlobValueType), alignof(BlobValueType));
+
+        uint32_t index = 0;
+        value.for_each([&](const KeyType& key, const ValueType& element) -> bool
+        {
+            const uint64_t hash = compute_blob_key_hash(get_blob_lookup_key(key));
+            Memory::copy(writer.get_data(hashes_offset + index * sizeof(uint64_t)), &hash, sizeof(uint64_t));
+
+            BlobTraits<KeyType>::write(writer, keys_offset + index * (uint32_t)sizeof(BlobKeyType), key);
+            BlobTraits<ValueType>::write(writer, values_offset + index * (uint32_t)sizeof(BlobValueType), element);
+
+            // The slots memory is re-fetched, as writing the key or the value might have grown the blob.
+            uint32_t* slots = (uint32_t*)writer.get_data(slots_offset);
+            uint32_t slot = BlobHashMap<BlobKeyType, BlobValueType>::get_first_slot(hash, slots_count - 1);
+            while (slots[slot] != 0)
+            {
+                slot = (slot + 1) & (slots_count - 1);
+            }
+            slots[slot] = ++index;
+
+            return true;
+        });
+
+        using MapType = BlobHashMap<BlobKeyType, BlobValueType>;
+        writer.link_array(offset + offsetof(MapType, m_slots), slots_offset, slots_count);
+        writer.link_array(offset + offsetof(MapType, m_hashes), hashes_offset, count);
+        writer.link_array(offset + offsetof(MapType, m_keys), keys_offset, count);
+        writer.link_array(offset + offsetof(MapType, m_values), values_offset, count);
+    }
+};
+
+} // namespace HC
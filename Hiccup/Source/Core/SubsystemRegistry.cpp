@@ -0,0 +1,249 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "SubsystemRegistry.h"
+
+#include "Core/Platform/Platform.h"
+#include "Core/Threading/Thread.h"
+
+namespace HC
+{
+
+struct SubsystemEntry
+{
+    const char* name;
+    PFN_SubsystemInitialize initialize;
+    PFN_SubsystemShutdown shutdown;
+    const void* description;
+
+    const char* dependency_names[SubsystemRegistry::MaxDependenciesCount];
+    uint32_t dependency_indices[SubsystemRegistry::MaxDependenciesCount];
+    uint32_t dependencies_count;
+
+    bool requires_main_thread;
+
+    // Written by the thread that initializes the subsystem.
+    bool is_initialized;
+    bool has_failed;
+    uint64_t initialization_time;
+};
+
+struct SubsystemRegistryData
+{
+    SubsystemEntry subsystems[SubsystemRegistry::MaxSubsystemsCount];
+    uint32_t subsystems_count;
+
+    // The indices of the initialized subsystems, in the order they were initialized.
+    uint32_t initialization_order[SubsystemRegistry::MaxSubsystemsCount];
+    uint32_t initialized_count;
+};
+
+// Statically allocated, as the registry runs before the memory system is initialized.
+static_internal SubsystemRegistryData s_registry_data = {};
+
+static_internal bool are_names_equal(const char* a, const char* b)
+{
+    while (*a && *a == *b)
+    {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+static_internal void initialize_entry(void* user_data)
+{
+    SubsystemEntry* entry = (SubsystemEntry*)user_data;
+
+    const uint64_t begin_time = Platform::get_nanoseconds();
+    const bool result = entry->initialize(entry->description);
+    entry->initialization_time = Platform::get_nanoseconds() - begin_time;
+
+    entry->is_initialized = result;
+    entry->has_failed = !result;
+}
+
+bool SubsystemRegistry::register_subsystem(
+    const char* name,
+    PFN_SubsystemInitialize initialize,
+    PFN_SubsystemShutdown shutdown,
+    const void* description,
+    std::initializer_list<const char*> dependencies,
+    bool requires_main_thread
+)
+{
+    HC_ASSERT(s_registry_data.initialized_count == 0); // Subsystems must be registered before the initialization!
+
+    if (s_registry_data.subsystems_count >= MaxSubsystemsCount || dependencies.size() > MaxDependenciesCount)
+    {
+        return false;
+    }
+
+    SubsystemEntry& entry = s_registry_data.subsystems[s_registry_data.subsystems_count++];
+    entry = {};
+    entry.name = name;
+    entry.initialize = initialize;
+    entry.shutdown = shutdown;
+    entry.description = description;
+    entry.requires_main_thread = requires_main_thread;
+
+    for (const char* dependency : dependencies)
+    {
+        entry.dependency_names[entry.dependencies_count++] = dependency;
+    }
+
+    return true;
+}
+
+bool SubsystemRegistry::initialize_all()
+{
+    const uint32_t subsystems_count = s_registry_data.subsystems_count;
+    const uint64_t begin_time = Platform::get_nanoseconds();
+
+    // Resolving the dependency names.
+    for (uint32_t index = 0; index < subsystems_count; ++index)
+    {
+        SubsystemEntry& entry = s_registry_data.subsystems[index];
+        for (uint32_t dependency = 0; dependency < entry.dependencies_count; ++dependency)
+        {
+            uint32_t dependency_index = 0;
+            while (dependency_index < subsystems_count && !are_names_equal(s_registry_data.subsystems[dependency_index].name, entry.dependency_names[dependency]))
+            {
+                ++dependency_index;
+            }
+
+            HC_ASSERT(dependency_index < subsystems_count); // Unknown subsystem dependency!
+            if (dependency_index == subsystems_count)
+            {
+                return false;
+            }
+            entry.dependency_indices[dependency] = dependency_index;
+        }
+    }
+
+    while (s_registry_data.initialized_count < subsystems_count)
+    {
+        // Collecting the wave: the subsystems whose dependencies are all initialized.
+        uint32_t wave[MaxSubsystemsCount];
+        uint32_t wave_size = 0;
+
+        for (uint32_t index = 0; index < subsystems_count; ++index)
+        {
+            const SubsystemEntry& entry = s_registry_data.subsystems[index];
+            if (entry.is_initialized)
+            {
+                continue;
+            }
+
+            bool is_ready = true;
+            for (uint32_t dependency = 0; dependency < entry.dependencies_count; ++dependency)
+            {
+                is_ready &= s_registry_data.subsystems[entry.dependency_indices[dependency]].is_initialized;
+            }
+
+            if (is_ready)
+            {
+                wave[wave_size++] = index;
+            }
+        }
+
+        HC_ASSERT(wave_size > 0); // Cyclic subsystem dependencies!
+        if (wave_size == 0)
+        {
+            shutdown_all();
+            return false;
+        }
+
+        // The first subsystem that doesn't require the main thread is initialized on the main thread as well,
+        //   so a wave with a single subsystem never creates a thread.
+        Thread threads[MaxSubsystemsCount];
+        bool has_main_thread_work = false;
+
+        for (uint32_t wave_index = 0; wave_index < wave_size; ++wave_index)
+        {
+            SubsystemEntry& entry = s_registry_data.subsystems[wave[wave_index]];
+            if (entry.requires_main_thread)
+            {
+                continue;
+            }
+
+            if (!has_main_thread_work)
+            {
+                // Deferred until the threads are started.
+                has_main_thread_work = true;
+                continue;
+            }
+
+            ThreadDescription thread_description = {};
+            thread_description.function = initialize_entry;
+            thread_description.user_data = &entry;
+            thread_description.name = entry.name;
+
+            if (!threads[wave_index].start(thread_description))
+            {
+                // Falling back to initializing the subsystem on the main thread.
+                initialize_entry(&entry);
+            }
+        }
+
+        has_main_thread_work = false;
+        for (uint32_t wave_index = 0; wave_index < wave_size; ++wave_index)
+        {
+            SubsystemEntry& entry = s_registry_data.subsystems[wave[wave_index]];
+            if (entry.requires_main_thread)
+            {
+                initialize_entry(&entry);
+            }
+            else if (!has_main_thread_work)
+            {
+                has_main_thread_work = true;
+                initialize_entry(&entry);
+            }
+        }
+
+        bool has_failed = false;
+        for (uint32_t wave_index = 0; wave_index < wave_size; ++wave_index)
+        {
+            if (threads[wave_index].is_running())
+            {
+                threads[wave_index].join();
+            }
+
+            const SubsystemEntry& entry = s_registry_data.subsystems[wave[wave_index]];
+            if (entry.is_initialized)
+            {
+                s_registry_data.initialization_order[s_registry_data.initialized_count++] = wave[wave_index];
+            }
+            has_failed |= entry.has_failed;
+        }
+
+        if (has_failed)
+        {
+            shutdown_all();
+            return false;
+        }
+    }
+
+    const uint64_t total_time = Platform::get_nanoseconds() - begin_time;
+    for (uint32_t order = 0; order < s_registry_data.initialized_count; ++order)
+    {
+        const SubsystemEntry& entry = s_registry_data.subsystems[s_registry_data.initialization_order[order]];
+        HC_LOG_INFO("SubsystemRegistry - '%s' initialized in %.3f ms.", entry.name, (float64_t)entry.initialization_time * 1e-6);
+    }
+    HC_LOG_INFO("SubsystemRegistry - %u subsystems initialized in %.3f ms.", subsystems_count, (float64_t)total_time * 1e-6);
+
+    return true;
+}
+
+void SubsystemRegistry::shutdown_all()
+{
+    for (uint32_t order = s_registry_data.initialized_count; order > 0; --order)
+    {
+        SubsystemEntry& entry = s_registry_data.subsystems[s_registry_data.initialization_order[order - 1]];
+        entry.shutdown();
+        entry.is_initialized = false;
+    }
+
+    s_registry_data.initialized_count = 0;
+}
+
+} // namespace HC
@@ -0,0 +1,91 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+
+#include <initializer_list>
+
+namespace HC
+{
+
+using PFN_SubsystemInitialize = bool(*)(const void* description);
+using PFN_SubsystemShutdown = void(*)();
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Subsystem Registry.
+ *----------------------------------------------------------------
+ * Declarative registry of the core subsystems and of their dependencies.
+ *
+ * The subsystems are initialized in waves: a wave contains all the subsystems whose dependencies
+ *   are already initialized. The subsystems of a wave are independent, so they are initialized in
+ *   parallel, on dedicated threads. The shutdown runs in the reverse initialization order, so a
+ *   subsystem is always shut down before its dependencies.
+ *
+ * The registry never allocates, as it is used before the memory system is initialized. It requires
+ *   the platform layer (threads and timers), so 'Platform' is initialized before the registry is used.
+ */
+class SubsystemRegistry
+{
+public:
+    static constexpr uint32_t MaxSubsystemsCount = 32;
+    static constexpr uint32_t MaxDependenciesCount = 8;
+
+public:
+    /** Adapts the 'static bool initialize(const XDescription&)' function of a subsystem to the registry signature. */
+    template<typename SystemType, typename DescriptionType>
+    static bool initialize_subsystem(const void* description)
+    {
+        return SystemType::initialize(*(const DescriptionType*)description);
+    }
+
+    /**
+     * Registers a subsystem. Must be called before 'initialize_all'.
+     *
+     * @param name The name of the subsystem. Dependencies refer to subsystems by name.
+     * @param initialize The initialization function.
+     * @param shutdown The shutdown function.
+     * @param description Passed to the initialization function. Must be valid until 'initialize_all' returns.
+     * @param dependencies The names of the subsystems that must be initialized before this one.
+     * @param requires_main_thread If true, the subsystem is never initialized on a worker thread.
+     *
+     * @return True if the subsystem was registered successfully.
+     */
+    static bool register_subsystem(
+        const char* name,
+        PFN_SubsystemInitialize initialize,
+        PFN_SubsystemShutdown shutdown,
+        const void* description,
+        std::initializer_list<const char*> dependencies,
+        bool requires_main_thread = false
+    );
+
+    /**
+     * Initializes all registered subsystems, in dependency order.
+     * On failure, the subsystems that were already initialized are shut down.
+     *
+     * @return True if all subsystems were initialized successfully.
+     */
+    static bool initialize_all();
+
+    /** Shuts down all initialized subsystems, in the reverse initialization order. */
+    static void shutdown_all();
+};
+
+/**
+ * Registers a subsystem that exposes 'initialize(const Description&)' and 'shutdown()'.
+ * The dependencies are given as subsystem names, for example:
+ *   HC_REGISTER_SUBSYSTEM(JobSystem, job_system_desc, "Memory", "Logger");
+ * Subsystems that might log while initializing (including failing to start a thread) must depend on "Logger".
+ */
+#define HC_REGISTER_SUBSYSTEM(SYSTEM_NAME, SYSTEM_DESCRIPTION, ...)                                 \
+    ::HC::SubsystemRegistry::register_subsystem(                                                    \
+        #SYSTEM_NAME,                                                                               \
+        ::HC::SubsystemRegistry::initialize_subsystem<SYSTEM_NAME, decltype(SYSTEM_DESCRIPTION)>,   \
+        SYSTEM_NAME::shutdown,                                                                      \
+        &(SYSTEM_DESCRIPTION),                                                                      \
+        { __VA_ARGS__ }                                                                             \
+    )
+
+} // namespace HC
@@ -0,0 +1,330 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+
+#if HC_COMPILER_MSVC
+    #include <intrin.h>
+#endif // HC_COMPILER_MSVC
+
+namespace HC
+{
+
+// The memory ordering constraints that an atomic operation can have.
+// They have the same semantics as the C++11 memory model orders.
+enum class MemoryOrder : uint8_t
+{
+    Relaxed                 = 0,
+    Acquire                 = 1,
+    Release                 = 2,
+    AcquireRelease          = 3,
+    SequentiallyConsistent  = 4
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Atomic Intrinsics.
+ *----------------------------------------------------------------
+ * Maps the atomic operations to the compiler intrinsics, based on the operand size.
+ * This is an implementation detail of 'Atomic', and shouldn't be used directly.
+ */
+template<size_t Size>
+struct AtomicIntrinsics;
+
+#if HC_COMPILER_MSVC
+
+// All MSVC interlocked intrinsics are full memory barriers, so the requested memory order
+//   is only relevant for plain loads and stores.
+#define HC_ATOMIC_INTRINSICS_MSVC(SIZE, TYPE, SUFFIX)                                                                                       \
+    template<>                                                                                                                          \
+    struct AtomicIntrinsics<SIZE>                                                                                                       \
+    {                                                                                                                                   \
+        using Type = TYPE;                                                                                                              \
+        ALWAYS_INLINE static Type exchange(volatile Type* address, Type value) { return _InterlockedExchange##SUFFIX(address, value); }  \
+        ALWAYS_INLINE static Type compare_exchange(volatile Type* address, Type exchange, Type comparand)                               \
+        {                                                                                                                               \
+            return _InterlockedCompareExchange##SUFFIX(address, exchange, comparand);                                                   \
+        }                                                                                                                               \
+        ALWAYS_INLINE static Type fetch_add(volatile Type* address, Type value) { return _InterlockedExchangeAdd##SUFFIX(address, value); } \
+        ALWAYS_INLINE static Type fetch_and(volatile Type* address, Type value) { return _InterlockedAnd##SUFFIX(address, value); }     \
+        ALWAYS_INLINE static Type fetch_or(volatile Type* address, Type value) { return _InterlockedOr##SUFFIX(address, value); }       \
+        ALWAYS_INLINE static Type fetch_xor(volatile Type* address, Type value) { return _InterlockedXor##SUFFIX(address, value); }     \
+    };
+
+HC_ATOMIC_INTRINSICS_MSVC(1, char,    8)
+HC_ATOMIC_INTRINSICS_MSVC(2, short,   16)
+HC_ATOMIC_INTRINSICS_MSVC(4, long,      )
+HC_ATOMIC_INTRINSICS_MSVC(8, __int64, 64)
+
+#undef HC_ATOMIC_INTRINSICS_MSVC
+
+#elif HC_COMPILER_GCC_CLANG
+
+template<> struct AtomicIntrinsics<1> { using Type = uint8_t; };
+template<> struct AtomicIntrinsics<2> { using Type = uint16_t; };
+template<> struct AtomicIntrinsics<4> { using Type = uint32_t; };
+template<> struct AtomicIntrinsics<8> { using Type = uint64_t; };
+
+// Converts a memory order to its GCC/Clang built-in equivalent.
+ALWAYS_INLINE constexpr int to_builtin_memory_order(MemoryOrder order)
+{
+    return (order == MemoryOrder::Relaxed)          ? __ATOMIC_RELAXED :
+           (order == MemoryOrder::Acquire)          ? __ATOMIC_ACQUIRE :
+           (order == MemoryOrder::Release)          ? __ATOMIC_RELEASE :
+           (order == MemoryOrder::AcquireRelease)   ? __ATOMIC_ACQ_REL :
+                                                      __ATOMIC_SEQ_CST;
+}
+
+// The memory order of a failed compare-exchange can't contain release semantics.
+ALWAYS_INLINE constexpr int to_builtin_failure_memory_order(MemoryOrder order)
+{
+    return (order == MemoryOrder::Release)          ? __ATOMIC_RELAXED :
+           (order == MemoryOrder::AcquireRelease)   ? __ATOMIC_ACQUIRE :
+                                                      to_builtin_memory_order(order);
+}
+
+#endif // Compiler switch.
+
+/**
+ * Issues a memory fence with the given ordering constraints.
+ *
+ * @param order The ordering constraints of the fence.
+ */
+ALWAYS_INLINE void atomic_fence(MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+{
+#if HC_COMPILER_MSVC
+    if (order == MemoryOrder::SequentiallyConsistent)
+    {
+        __faststorefence();
+    }
+    else
+    {
+        _ReadWriteBarrier();
+    }
+#elif HC_COMPILER_GCC_CLANG
+    __atomic_thread_fence(to_builtin_memory_order(order));
+#endif // Compiler switch.
+}
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Atomic.
+ *----------------------------------------------------------------
+ * Lightweight wrapper around a value that can only be accessed atomically.
+ * The type must be 1, 2, 4 or 8 bytes long and trivially copyable (integers, enums,
+ *   booleans or pointers). The arithmetic and bitwise operations are only meaningful
+ *   for integral types.
+ * Unlike 'std::atomic', the memory order of every operation is always visible at the
+ *   call site, while still defaulting to sequential consistency.
+ */
+template<typename T>
+class Atomic
+{
+public:
+    HC_NON_COPIABLE(Atomic)
+    HC_NON_MOVABLE(Atomic)
+
+    using IntrinsicType = typename AtomicIntrinsics<sizeof(T)>::Type;
+
+    ALWAYS_INLINE constexpr Atomic()
+        : m_value()
+    {}
+
+    ALWAYS_INLINE constexpr Atomic(T value)
+        : m_value(value)
+    {}
+
+public:
+    ALWAYS_INLINE NODISCARD T load(MemoryOrder order = MemoryOrder::SequentiallyConsistent) const
+    {
+#if HC_COMPILER_MSVC
+        // On x64, plain loads already have acquire semantics. Only the compiler must be prevented
+        //   from reordering the surrounding memory accesses.
+        const IntrinsicType value = *(const volatile IntrinsicType*)(&m_value);
+        if (order != MemoryOrder::Relaxed)
+        {
+            _ReadWriteBarrier();
+        }
+        return from_intrinsic(value);
+#elif HC_COMPILER_GCC_CLANG
+        return __atomic_load_n(&m_value, to_builtin_memory_order(order));
+#endif // Compiler switch.
+    }
+
+    ALWAYS_INLINE void store(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+#if HC_COMPILER_MSVC
+        if (order == MemoryOrder::SequentiallyConsistent)
+        {
+            // A sequentially consistent store requires a full barrier, which the interlocked exchange provides.
+            AtomicIntrinsics<sizeof(T)>::exchange(intrinsic_address(), to_intrinsic(value));
+        }
+        else
+        {
+            if (order != MemoryOrder::Relaxed)
+            {
+                _ReadWriteBarrier();
+            }
+            *intrinsic_address() = to_intrinsic(value);
+        }
+#elif HC_COMPILER_GCC_CLANG
+        __atomic_store_n(&m_value, value, to_builtin_memory_order(order));
+#endif // Compiler switch.
+    }
+
+    /** @return The value stored before the operation. */
+    ALWAYS_INLINE T exchange(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+#if HC_COMPILER_MSVC
+        return from_intrinsic(AtomicIntrinsics<sizeof(T)>::exchange(intrinsic_address(), to_intrinsic(value)));
+#elif HC_COMPILER_GCC_CLANG
+        return __atomic_exchange_n(&m_value, value, to_builtin_memory_order(order));
+#endif // Compiler switch.
+    }
+
+    /**
+     * Stores the desired value, only if the currently stored value is equal to the expected one.
+     *
+     * @param expected The value expected to be stored. On failure, it is set to the actual stored value.
+     * @param desired The value to store.
+     * @param order The memory order of the operation, on success.
+     *
+     * @return True if the desired value was stored; False otherwise.
+     */
+    ALWAYS_INLINE bool compare_exchange(T& expected, T desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+#if HC_COMPILER_MSVC
+        const IntrinsicType comparand = to_intrinsic(expected);
+        const IntrinsicType previous = AtomicIntrinsics<sizeof(T)>::compare_exchange(intrinsic_address(), to_intrinsic(desired), comparand);
+        if (previous == comparand)
+        {
+            return true;
+        }
+        expected = from_intrinsic(previous);
+        return false;
+#elif HC_COMPILER_GCC_CLANG
+        return __atomic_compare_exchange_n(&m_value, &expected, desired, false,
+            to_builtin_memory_order(order), to_builtin_failure_memory_order(order));
+#endif // Compiler switch.
+    }
+
+    /** @return The value stored before the operation. */
+    ALWAYS_INLINE T fetch_add(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+#if HC_COMPILER_MSVC
+        return from_intrinsic(AtomicIntrinsics<sizeof(T)>::fetch_add(intrinsic_address(), to_intrinsic(value)));
+#elif HC_COMPILER_GCC_CLANG
+        return __atomic_fetch_add(&m_value, value, to_builtin_memory_order(order));
+#endif // Compiler switch.
+    }
+
+    /** @return The value stored before the operation. */
+    ALWAYS_INLINE T fetch_sub(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+#if HC_COMPILER_MSVC
+        return from_intrinsic(AtomicIntrinsics<sizeof(T)>::fetch_add(intrinsic_address(), (IntrinsicType)(0) - to_intrinsic(value)));
+#elif HC_COMPILER_GCC_CLANG
+        return __atomic_fetch_sub(&m_value, value, to_builtin_memory_order(order));
+#endif // Compiler switch.
+    }
+
+    /** @return The value stored before the operation. */
+    ALWAYS_INLINE T fetch_and(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+#if HC_COMPILER_MSVC
+        return from_intrinsic(AtomicIntrinsics<sizeof(T)>::fetch_and(intrinsic_address(), to_intrinsic(value)));
+#elif HC_COMPILER_GCC_CLANG
+        return __atomic_fetch_and(&m_value, value, to_builtin_memory_order(order));
+#endif // Compiler switch.
+    }
+
+    /** @return The value stored before the operation. */
+    ALWAYS_INLINE T fetch_or(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+#if HC_COMPILER_MSVC
+        return from_intrinsic(AtomicIntrinsics<sizeof(T)>::fetch_or(intrinsic_address(), to_intrinsic(value)));
+#elif HC_COMPILER_GCC_CLANG
+        return __atomic_fetch_or(&m_value, value, to_builtin_memory_order(order));
+#endif // Compiler switch.
+    }
+
+    /** @return The value stored before the operation. */
+    ALWAYS_INLINE T fetch_xor(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+#if HC_COMPILER_MSVC
+        return from_intrinsic(AtomicIntrinsics<sizeof(T)>::fetch_xor(intrinsic_address(), to_intrinsic(value)));
+#elif HC_COMPILER_GCC_CLANG
+        return __atomic_fetch_xor(&m_value, value, to_builtin_memory_order(order));
+#endif // Compiler switch.
+    }
+
+public:
+    // Sequentially consistent shorthands.
+    ALWAYS_INLINE operator T() const { return load(); }
+    ALWAYS_INLINE T operator=(T value) { store(value); return value; }
+
+    ALWAYS_INLINE T operator++() { return fetch_add(1) + 1; }
+    ALWAYS_INLINE T operator--() { return fetch_sub(1) - 1; }
+    ALWAYS_INLINE T operator++(int) { return fetch_add(1); }
+    ALWAYS_INLINE T operator--(int) { return fetch_sub(1); }
+
+    ALWAYS_INLINE T operator+=(T value) { return fetch_add(value) + value; }
+    ALWAYS_INLINE T operator-=(T value) { return fetch_sub(value) - value; }
+
+public:
+    /**
+     * Gets the address of the stored value. Should only be used for passing the value to
+     *   platform wait primitives (such as 'Platform::wait_on_address'), never for non-atomic accesses.
+     */
+    ALWAYS_INLINE volatile T* address() { return &m_value; }
+
+private:
+    ALWAYS_INLINE volatile IntrinsicType* intrinsic_address() { return (volatile IntrinsicType*)(&m_value); }
+
+    ALWAYS_INLINE static IntrinsicType to_intrinsic(T value)
+    {
+        union { T value; IntrinsicType intrinsic; } converter = {};
+        converter.value = value;
+        return converter.intrinsic;
+    }
+
+    ALWAYS_INLINE static T from_intrinsic(IntrinsicType intrinsic)
+    {
+        union { IntrinsicType intrinsic; T value; } converter = {};
+        converter.intrinsic = intrinsic;
+        return converter.value;
+    }
+
+private:
+    alignas(sizeof(T)) T m_value;
+
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "Unsupported atomic type size!");
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Padded Atomic.
+ *----------------------------------------------------------------
+ * An 'Atomic' that occupies a whole cache line. Used for counters that are heavily written
+ *   by different threads, so that they don't falsely share the cache line with other data.
+ */
+template<typename T>
+class alignas(CacheLineSize) PaddedAtomic : public Atomic<T>
+{
+public:
+    HC_NON_COPIABLE(PaddedAtomic)
+    HC_NON_MOVABLE(PaddedAtomic)
+
+    ALWAYS_INLINE constexpr PaddedAtomic()
+        : Atomic<T>()
+    {}
+
+    ALWAYS_INLINE constexpr PaddedAtomic(T value)
+        : Atomic<T>(value)
+    {}
+
+    using Atomic<T>::operator=;
+};
+
+} // namespace HC
@@ -0,0 +1,50 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "ConditionVariable.h"
+
+namespace HC
+{
+
+void ConditionVariable::wait(Mutex& mutex)
+{
+    // The waiters count must be incremented before the sequence is sampled. Together with
+    //   the notifiers incrementing the sequence before reading the waiters count, this
+    //   guarantees that either the notification is observed, or the wake up is issued.
+    m_waiters_count.fetch_add(1);
+    const uint32_t sequence = m_sequence.load();
+
+    mutex.unlock();
+    Platform::wait_on_address(m_sequence.address(), sequence);
+    m_waiters_count.fetch_sub(1, MemoryOrder::Relaxed);
+
+    // Other threads might have been woken up alongside this one (by 'notify_all'), so the mutex
+    //   must be re-acquired as contended. Otherwise, their wake ups could be lost.
+    mutex.lock_contended();
+}
+
+bool ConditionVariable::wait_for(Mutex& mutex, uint32_t timeout_milliseconds)
+{
+    m_waiters_count.fetch_add(1);
+    const uint32_t sequence = m_sequence.load();
+
+    mutex.unlock();
+    const bool was_woken = Platform::wait_on_address(m_sequence.address(), sequence, timeout_milliseconds);
+    m_waiters_count.fetch_sub(1, MemoryOrder::Relaxed);
+
+    mutex.lock_contended();
+    return was_woken;
+}
+
+void ConditionVariable::wake_waiters(size_t count)
+{
+    if (count == 1)
+    {
+        Platform::wake_by_address_single(m_sequence.address());
+    }
+    else
+    {
+        Platform::wake_by_address_all(m_sequence.address());
+    }
+}
+
+} // namespace HC
@@ -0,0 +1,83 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Platform/Platform.h"
+
+#include "Atomic.h"
+#include "Mutex.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Condition Variable.
+ *----------------------------------------------------------------
+ * Futex-based condition variable, used alongside a 'Mutex'.
+ * Waiting threads sleep on a sequence counter that is incremented by every notification.
+ *   Notifying while nobody waits doesn't involve the kernel.
+ * As with any condition variable, spurious wake ups are possible, so the waited
+ *   condition must always be re-checked in a loop.
+ */
+class ConditionVariable
+{
+public:
+    HC_NON_COPIABLE(ConditionVariable)
+    HC_NON_MOVABLE(ConditionVariable)
+
+    ConditionVariable()
+        : m_sequence(0)
+        , m_waiters_count(0)
+    {}
+
+public:
+    /**
+     * Atomically releases the mutex and blocks the calling thread until notified.
+     * The mutex is re-acquired before returning.
+     *
+     * @param mutex The mutex that protects the waited condition. Must be locked by the calling thread.
+     */
+    HC_API void wait(Mutex& mutex);
+
+    /**
+     * Same as 'wait', but gives up after the given timeout expires.
+     *
+     * @return False if the wait timed out; True otherwise.
+     */
+    HC_API bool wait_for(Mutex& mutex, uint32_t timeout_milliseconds);
+
+    /** Wakes up one of the waiting threads. */
+    ALWAYS_INLINE void notify_one()
+    {
+        m_sequence.fetch_add(1);
+        if (m_waiters_count.load() > 0)
+        {
+            wake_waiters(1);
+        }
+    }
+
+    /** Wakes up all the waiting threads. */
+    ALWAYS_INLINE void notify_all()
+    {
+        m_sequence.fetch_add(1);
+        if (m_waiters_count.load() > 0)
+        {
+            wake_waiters(InvalidSize);
+        }
+    }
+
+private:
+    // Wakes up one waiting thread if the count is 1, or all of them otherwise.
+    HC_API void wake_waiters(size_t count);
+
+private:
+    // Incremented by every notification.
+    Atomic<uint32_t> m_sequence;
+
+    // The number of threads currently blocked in 'wait'.
+    Atomic<uint32_t> m_waiters_count;
+};
+
+} // namespace HC
@@ -0,0 +1,337 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "JobSystem.h"
+
+#include "Core/Memory/Memory.h"
+#include "Core/Platform/Platform.h"
+#include "Core/Math/MathUtilities.h"
+
+#include "Thread.h"
+#include "Mutex.h"
+#include "Semaphore.h"
+
+namespace HC
+{
+
+struct QueuedJob
+{
+    PFN_JobFunction function;
+    void* user_data;
+    JobCounter* counter;
+};
+
+// Bounded ring buffer of pending jobs. Protected by the job system's queue mutex.
+struct JobQueue
+{
+    QueuedJob* jobs;
+    uint32_t capacity;
+    uint32_t head;
+    uint32_t count;
+};
+
+struct JobSystemData
+{
+    JobSystemDescription description;
+
+    Mutex queue_mutex;
+    JobQueue queues[(uint8_t)JobPriority::MaxEnumValue];
+
+    // Counts the pending jobs, so idle workers can sleep.
+    Semaphore pending_jobs;
+
+    Thread* workers;
+    Atomic<uint32_t> should_stop;
+};
+static_internal JobSystemData* s_job_system_data = nullptr;
+
+static constexpr uint32_t DefaultQueueCapacity = 4096;
+
+// Waiters sleep for at most this long before checking the queues again. This guarantees progress
+//   when all workers wait on counters whose jobs were scheduled after they went to sleep.
+static constexpr uint32_t WaitPollMilliseconds = 1;
+
+void JobSystem::execute_queued_job(const QueuedJob& job)
+{
+    job.function(job.user_data);
+
+    if (job.counter && job.counter->m_value.fetch_sub(1, MemoryOrder::AcquireRelease) == 1)
+    {
+        Platform::wake_by_address_all(job.counter->m_value.address());
+    }
+}
+
+// Must be called while holding the queue mutex.
+static_internal bool pop_job(QueuedJob* out_job)
+{
+    for (uint8_t priority = 0; priority < (uint8_t)JobPriority::MaxEnumValue; ++priority)
+    {
+        JobQueue& queue = s_job_system_data->queues[priority];
+        if (queue.count > 0)
+        {
+            *out_job = queue.jobs[queue.head];
+            queue.head = (queue.head + 1) & (queue.capacity - 1);
+            --queue.count;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Must be called while holding the queue mutex.
+static_internal bool push_job(const QueuedJob& job, JobPriority priority)
+{
+    JobQueue& queue = s_job_system_data->queues[(uint8_t)priority];
+    if (queue.count == queue.capacity)
+    {
+        return false;
+    }
+
+    queue.jobs[(queue.head + queue.count) & (queue.capacity - 1)] = job;
+    ++queue.count;
+    return true;
+}
+
+static_internal void worker_thread_function(void* user_data)
+{
+    while (true)
+    {
+        s_job_system_data->pending_jobs.acquire();
+        if (s_job_system_data->should_stop.load(MemoryOrder::Acquire))
+        {
+            break;
+        }
+
+        // The job might have been already executed by a waiting thread.
+        JobSystem::try_execute_job();
+    }
+}
+
+bool JobSystem::initialize(const JobSystemDescription& description)
+{
+    s_job_system_data = hc_new JobSystemData();
+    s_job_system_data->description = description;
+
+    if (s_job_system_data->description.workers_count == 0)
+    {
+        const uint32_t processor_count = Platform::get_processor_count();
+        s_job_system_data->description.workers_count = Math::max<uint32_t>(processor_count, 2) - 1;
+    }
+
+    if (s_job_system_data->description.queue_capacity == 0)
+    {
+        s_job_system_data->description.queue_capacity = DefaultQueueCapacity;
+    }
+
+    const uint32_t queue_capacity = s_job_system_data->description.queue_capacity;
+    if ((queue_capacity & (queue_capacity - 1)) != 0)
+    {
+        HC_LOG_ERROR("JobSystem::initialize - The queue capacity must be a power of two!");
+        hc_delete s_job_system_data;
+        s_job_system_data = nullptr;
+        return false;
+    }
+
+    for (JobQueue& queue : s_job_system_data->queues)
+    {
+        queue.jobs = (QueuedJob*)Memory::allocate_tagged_i(queue_capacity * sizeof(QueuedJob));
+        queue.capacity = queue_capacity;
+        queue.head = 0;
+        queue.count = 0;
+    }
+
+    const uint32_t workers_count = s_job_system_data->description.workers_count;
+    s_job_system_data->workers = (Thread*)Memory::allocate_tagged_i(workers_count * sizeof(Thread));
+
+    bool are_buffers_allocated = (s_job_system_data->workers != nullptr);
+    for (const JobQueue& queue : s_job_system_data->queues)
+    {
+        are_buffers_allocated &= (queue.jobs != nullptr);
+    }
+
+    if (!are_buffers_allocated)
+    {
+        HC_LOG_ERROR("JobSystem::initialize - Failed to allocate the job queues or the workers!");
+        for (JobQueue& queue : s_job_system_data->queues)
+        {
+            Memory::free(queue.jobs);
+        }
+        Memory::free(s_job_system_data->workers);
+
+        hc_delete s_job_system_data;
+        s_job_system_data = nullptr;
+        return false;
+    }
+
+    for (uint32_t index = 0; index < workers_count; ++index)
+    {
+        new (s_job_system_data->workers + index) Thread();
+    }
+
+    const uint32_t numa_node_count = s_job_system_data->description.should_pin_workers_to_numa_nodes ? Platform::get_numa_node_count() : 1;
+
+    for (uint32_t index = 0; index < workers_count; ++index)
+    {
+        ThreadDescription thread_desc = {};
+        thread_desc.function = worker_thread_function;
+        thread_desc.name = "Job Worker";
+        if (numa_node_count > 1)
+        {
+            // Evenly splitting the workers between the nodes, in contiguous blocks.
+            thread_desc.numa_node = (uint32_t)(((uint64_t)index * numa_node_count) / workers_count);
+        }
+
+        if (!s_job_system_data->workers[index].start(thread_desc))
+        {
+            HC_LOG_ERROR("JobSystem::initialize - Failed to start the worker threads!");
+            shutdown();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void JobSystem::shutdown()
+{
+    const uint32_t workers_count = s_job_system_data->description.workers_count;
+
+    // Workers finish the job they are currently executing and stop.
+    s_job_system_data->should_stop.store(1, MemoryOrder::Release);
+    s_job_system_data->pending_jobs.release(workers_count);
+
+    // Joining a worker that failed to start does nothing.
+    for (uint32_t index = 0; index < workers_count; ++index)
+    {
+        s_job_system_data->workers[index].join();
+        s_job_system_data->workers[index].~Thread();
+    }
+    Memory::free(s_job_system_data->workers);
+
+    // Pending jobs are executed on the calling thread, so no counter (or completion that is published
+    //   by a job, such as an async IO callback) is left waiting forever.
+    while (try_execute_job());
+
+    for (JobQueue& queue : s_job_system_data->queues)
+    {
+        Memory::free(queue.jobs);
+    }
+
+    hc_delete s_job_system_data;
+    s_job_system_data = nullptr;
+}
+
+void JobSystem::schedule(const Job& job, JobCounter* counter, JobPriority priority)
+{
+    schedule_copies(job, 1, counter, priority);
+}
+
+void JobSystem::schedule(Span<const Job> jobs, JobCounter* counter, JobPriority priority)
+{
+    if (jobs.is_empty())
+    {
+        return;
+    }
+
+    if (counter)
+    {
+        counter->m_value.fetch_add((uint32_t)jobs.count(), MemoryOrder::Relaxed);
+    }
+
+    size_t queued_count = 0;
+    {
+        ScopedLock<Mutex> lock(s_job_system_data->queue_mutex);
+        while (queued_count < jobs.count() && push_job({ jobs.elements()[queued_count].function, jobs.elements()[queued_count].user_data, counter }, priority))
+        {
+            ++queued_count;
+        }
+    }
+    if (queued_count > 0)
+    {
+        s_job_system_data->pending_jobs.release((uint32_t)queued_count);
+    }
+
+    // The queue is full, so the remaining jobs are executed in place.
+    for (size_t index = queued_count; index < jobs.count(); ++index)
+    {
+        execute_queued_job({ jobs.elements()[index].function, jobs.elements()[index].user_data, counter });
+    }
+}
+
+void JobSystem::schedule_copies(const Job& job, uint32_t copies_count, JobCounter* counter, JobPriority priority)
+{
+    if (copies_count == 0)
+    {
+        return;
+    }
+
+    if (counter)
+    {
+        counter->m_value.fetch_add(copies_count, MemoryOrder::Relaxed);
+    }
+
+    const QueuedJob queued_job = { job.function, job.user_data, counter };
+
+    uint32_t queued_count = 0;
+    {
+        ScopedLock<Mutex> lock(s_job_system_data->queue_mutex);
+        while (queued_count < copies_count && push_job(queued_job, priority))
+        {
+            ++queued_count;
+        }
+    }
+    if (queued_count > 0)
+    {
+        s_job_system_data->pending_jobs.release(queued_count);
+    }
+
+    // The queue is full, so the remaining copies are executed in place.
+    for (uint32_t index = queued_count; index < copies_count; ++index)
+    {
+        execute_queued_job(queued_job);
+    }
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    while (true)
+    {
+        const uint32_t value = counter.m_value.load(MemoryOrder::Acquire);
+        if (value == 0)
+        {
+            return;
+        }
+
+        if (!try_execute_job())
+        {
+            Platform::wait_on_address(counter.m_value.address(), value, WaitPollMilliseconds);
+        }
+    }
+}
+
+bool JobSystem::try_execute_job()
+{
+    QueuedJob job;
+    {
+        ScopedLock<Mutex> lock(s_job_system_data->queue_mutex);
+        if (!pop_job(&job))
+        {
+            return false;
+        }
+    }
+
+    execute_queued_job(job);
+    return true;
+}
+
+uint32_t JobSystem::get_workers_count()
+{
+    return s_job_system_data->description.workers_count;
+}
+
+bool JobSystem::is_initialized()
+{
+    return (s_job_system_data != nullptr);
+}
+
+} // namespace HC
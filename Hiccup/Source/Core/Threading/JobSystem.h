@@ -0,0 +1,198 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Containers/Span.h"
+
+#include "Atomic.h"
+
+namespace HC
+{
+
+// The signature of the function that a job executes.
+using PFN_JobFunction = void(*)(void* user_data);
+
+struct Job
+{
+    PFN_JobFunction function;
+    void* user_data;
+};
+
+enum class JobPriority : uint8_t
+{
+    High = 0, Normal = 1, Low = 2,
+
+    MaxEnumValue
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Job Counter.
+ *----------------------------------------------------------------
+ * Counts the jobs that were scheduled with it and are not yet finished.
+ * Waiting on a counter is the only way to synchronize with scheduled jobs.
+ */
+class JobCounter
+{
+public:
+    HC_NON_COPIABLE(JobCounter)
+    HC_NON_MOVABLE(JobCounter)
+
+    JobCounter()
+        : m_value(0)
+    {}
+
+    ~JobCounter()
+    {
+        HC_ASSERT(is_done()); // Destroying a counter that still has unfinished jobs!
+    }
+
+public:
+    ALWAYS_INLINE NODISCARD bool is_done() const { return (m_value.load(MemoryOrder::Acquire) == 0); }
+
+private:
+    Atomic<uint32_t> m_value;
+
+    friend class JobSystem;
+};
+
+struct QueuedJob;
+
+/**
+ *----------------------------------------------------------------
+ * Job System Description.
+ *----------------------------------------------------------------
+ */
+struct JobSystemDescription
+{
+    // The number of worker threads. If 0, one worker is created for each logical processor except one.
+    uint32_t workers_count;
+
+    // The maximum number of pending jobs of each priority. Must be a power of two. If 0, a default value is used.
+    uint32_t queue_capacity;
+
+    // Whether or not to pin the workers to the NUMA nodes (evenly distributed), so the memory they
+    //   allocate from node-local arenas stays local. Ignored on systems with a single node.
+    bool should_pin_workers_to_numa_nodes;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Job System.
+ *----------------------------------------------------------------
+ * A fixed pool of worker threads that execute small, fire-and-forget jobs.
+ * Pending jobs are stored in bounded ring buffers (one for each priority), so scheduling
+ *   never allocates. When a queue is full, the job is executed on the scheduling thread.
+ * Threads waiting on a counter execute pending jobs instead of sleeping, so jobs
+ *   can safely schedule and wait for other jobs.
+ */
+class JobSystem
+{
+public:
+    static bool initialize(const JobSystemDescription& description);
+    static void shutdown();
+
+public:
+    /**
+     * Schedules a job for execution on the worker threads.
+     *
+     * @param job The job to schedule.
+     * @param counter Optional counter, incremented now and decremented when the job finishes.
+     * @param priority Higher priority jobs are always picked up first.
+     */
+    HC_API static void schedule(const Job& job, JobCounter* counter = nullptr, JobPriority priority = JobPriority::Normal);
+
+    /** Same as the single-job version, but takes the queue lock only once. */
+    HC_API static void schedule(Span<const Job> jobs, JobCounter* counter = nullptr, JobPriority priority = JobPriority::Normal);
+
+    /** Schedules the same job multiple times. Useful when the job pulls its work from a shared cursor. */
+    HC_API static void schedule_copies(const Job& job, uint32_t copies_count, JobCounter* counter = nullptr, JobPriority priority = JobPriority::Normal);
+
+    /** Blocks until all jobs scheduled with the counter are finished, executing pending jobs meanwhile. */
+    HC_API static void wait(JobCounter& counter);
+
+    /**
+     * Executes one pending job on the calling thread.
+     *
+     * @return True if a job was executed; False if no jobs are pending.
+     */
+    HC_API static bool try_execute_job();
+
+    HC_API static uint32_t get_workers_count();
+
+    /** @return True if the system is initialized. Systems that optionally use jobs check this before scheduling. */
+    HC_API static bool is_initialized();
+
+public:
+    /**
+     * Invokes 'function(begin_index, end_index)' over the range [0, count), split into batches that
+     *   are distributed across the worker threads and the calling thread. Blocks until all batches finish.
+     * Batches are claimed dynamically, so uneven batch costs are naturally balanced.
+     */
+    template<typename Function>
+    static void parallel_for(size_t count, size_t batch_size, const Function& function, JobPriority priority = JobPriority::Normal)
+    {
+        HC_ASSERT(batch_size > 0);
+
+        if (count <= batch_size || !is_initialized())
+        {
+            if (count > 0)
+            {
+                function((size_t)0, count);
+            }
+            return;
+        }
+
+        ParallelForContext<Function> context(function, count, batch_size);
+
+        const size_t batches_count = (count + batch_size - 1) / batch_size;
+        const size_t helpers_count = (batches_count - 1 < get_workers_count()) ? (batches_count - 1) : get_workers_count();
+
+        JobCounter counter;
+        schedule_copies({ ParallelForContext<Function>::execute, &context }, (uint32_t)helpers_count, &counter, priority);
+
+        // The calling thread processes batches as well, instead of just waiting.
+        ParallelForContext<Function>::execute(&context);
+        wait(counter);
+    }
+
+private:
+    // Executes the job and decrements its counter, waking up the threads that wait on it.
+    static void execute_queued_job(const QueuedJob& job);
+
+private:
+    template<typename Function>
+    struct ParallelForContext
+    {
+        ParallelForContext(const Function& in_function, size_t in_count, size_t in_batch_size)
+            : function(in_function)
+            , count(in_count)
+            , batch_size(in_batch_size)
+            , next_index(0)
+        {}
+
+        static void execute(void* user_data)
+        {
+            ParallelForContext* context = (ParallelForContext*)user_data;
+            while (true)
+            {
+                const size_t begin_index = context->next_index.fetch_add(context->batch_size, MemoryOrder::Relaxed);
+                if (begin_index >= context->count)
+                {
+                    break;
+                }
+
+                const size_t end_index = (context->count - begin_index > context->batch_size) ? (begin_index + context->batch_size) : context->count;
+                context->function(begin_index, end_index);
+            }
+        }
+
+        const Function& function;
+        size_t count;
+        size_t batch_size;
+        Atomic<size_t> next_index;
+    };
+};
+
+} // namespace HC
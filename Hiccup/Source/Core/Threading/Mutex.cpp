@@ -0,0 +1,56 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "Mutex.h"
+
+#include "Core/Math/MathUtilities.h"
+
+namespace HC
+{
+
+void Mutex::lock_contended()
+{
+    // Marking the mutex as having waiters, even though this thread might acquire it immediately,
+    //   is required. Otherwise, threads that are parked at the moment wouldn't be woken up
+    //   by the next unlock.
+    while (m_state.exchange(LockedWithWaiters, MemoryOrder::Acquire) != Unlocked)
+    {
+        Platform::wait_on_address(m_state.address(), LockedWithWaiters);
+    }
+}
+
+void Mutex::wake_waiter()
+{
+    Platform::wake_by_address_single(m_state.address());
+}
+
+void AdaptiveMutex::lock_contended()
+{
+    const uint32_t spin_estimate = m_spin_estimate.load(MemoryOrder::Relaxed);
+    const uint32_t spin_limit = Math::min(MaxSpinCount, spin_estimate * 2 + 16);
+
+    bool was_acquired = false;
+    uint32_t spin_count = 0;
+    for (; spin_count < spin_limit; ++spin_count)
+    {
+        // Only attempt the interlocked operation when the lock looks free, so that the cache
+        //   line is not bounced between the spinning cores.
+        if (m_mutex.m_state.load(MemoryOrder::Relaxed) == Mutex::Unlocked && m_mutex.try_lock())
+        {
+            was_acquired = true;
+            break;
+        }
+
+        Platform::cpu_relax();
+    }
+
+    // Exponential moving average, with a weight of 1/8 for the newest sample.
+    const int32_t spin_delta = ((int32_t)spin_count - (int32_t)spin_estimate) / 8;
+    m_spin_estimate.store((uint32_t)((int32_t)spin_estimate + spin_delta), MemoryOrder::Relaxed);
+
+    if (!was_acquired)
+    {
+        m_mutex.lock_contended();
+    }
+}
+
+} // namespace HC
@@ -0,0 +1,158 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Platform/Platform.h"
+
+#include "Atomic.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Mutex.
+ *----------------------------------------------------------------
+ * Futex-based, non-recursive mutual exclusion lock. It occupies a single 32-bit word
+ *   and never allocates. The uncontended lock/unlock paths are a single interlocked
+ *   operation each, and the kernel is only involved when threads actually have to sleep.
+ * The mutex state is one of the following:
+ *   0 - Unlocked.
+ *   1 - Locked, with no thread waiting for it.
+ *   2 - Locked, with (possibly) some threads waiting for it.
+ */
+class Mutex
+{
+public:
+    HC_NON_COPIABLE(Mutex)
+    HC_NON_MOVABLE(Mutex)
+
+    Mutex()
+        : m_state(Unlocked)
+    {}
+
+    ~Mutex()
+    {
+        HC_ASSERT(m_state.load(MemoryOrder::Relaxed) == Unlocked); // Destroying a locked mutex!
+    }
+
+public:
+    ALWAYS_INLINE void lock()
+    {
+        if (!try_lock())
+        {
+            lock_contended();
+        }
+    }
+
+    /** @return True if the mutex was acquired; False if it is already locked. */
+    ALWAYS_INLINE NODISCARD bool try_lock()
+    {
+        uint32_t expected = Unlocked;
+        return m_state.compare_exchange(expected, Locked, MemoryOrder::Acquire);
+    }
+
+    ALWAYS_INLINE void unlock()
+    {
+        if (m_state.exchange(Unlocked, MemoryOrder::Release) == LockedWithWaiters)
+        {
+            wake_waiter();
+        }
+    }
+
+private:
+    // Parks the calling thread until the mutex is acquired.
+    HC_API void lock_contended();
+
+    // Wakes up one of the threads parked in 'lock_contended'.
+    HC_API void wake_waiter();
+
+private:
+    enum : uint32_t
+    {
+        Unlocked = 0, Locked = 1, LockedWithWaiters = 2
+    };
+
+    Atomic<uint32_t> m_state;
+
+private:
+    friend class AdaptiveMutex;
+    friend class ConditionVariable;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Adaptive Mutex.
+ *----------------------------------------------------------------
+ * A 'Mutex' that spins for a while before parking the calling thread. The spin duration
+ *   adapts to how long the previous acquisitions had to wait, so short critical sections
+ *   are handed over without a trip through the kernel, while long ones don't waste cycles.
+ */
+class AdaptiveMutex
+{
+public:
+    HC_NON_COPIABLE(AdaptiveMutex)
+    HC_NON_MOVABLE(AdaptiveMutex)
+
+    // The maximum number of spin iterations performed before parking the thread.
+    static constexpr uint32_t MaxSpinCount = 1024;
+
+    AdaptiveMutex()
+        : m_spin_estimate(0)
+    {}
+
+public:
+    ALWAYS_INLINE void lock()
+    {
+        if (!m_mutex.try_lock())
+        {
+            lock_contended();
+        }
+    }
+
+    ALWAYS_INLINE NODISCARD bool try_lock() { return m_mutex.try_lock(); }
+
+    ALWAYS_INLINE void unlock() { m_mutex.unlock(); }
+
+private:
+    HC_API void lock_contended();
+
+private:
+    Mutex m_mutex;
+
+    // Moving average of the number of spin iterations required to acquire the lock.
+    // It is updated racily (with relaxed loads and stores), as it is only a heuristic.
+    Atomic<uint32_t> m_spin_estimate;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Scoped Lock.
+ *----------------------------------------------------------------
+ * Locks the given lock for the duration of the scope.
+ * Works with any type that provides 'lock' and 'unlock'.
+ */
+template<typename LockType>
+class ScopedLock
+{
+public:
+    HC_NON_COPIABLE(ScopedLock)
+    HC_NON_MOVABLE(ScopedLock)
+
+    ALWAYS_INLINE ScopedLock(LockType& lock)
+        : m_lock(lock)
+    {
+        m_lock.lock();
+    }
+
+    ALWAYS_INLINE ~ScopedLock()
+    {
+        m_lock.unlock();
+    }
+
+private:
+    LockType& m_lock;
+};
+
+} // namespace HC
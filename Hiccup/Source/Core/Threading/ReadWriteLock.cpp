@@ -0,0 +1,92 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "ReadWriteLock.h"
+
+namespace HC
+{
+
+void ReadWriteLock::lock_shared_contended()
+{
+    uint32_t state = m_state.load(MemoryOrder::Relaxed);
+    while (true)
+    {
+        // Readers are allowed to enter when only the waiters bit is set, as the sleeping threads
+        //   might all be readers. A waiting writer blocks them, so it gets the lock once the current readers leave.
+        if (!(state & (WriterBit | WriterWaitingBit)))
+        {
+            if (m_state.compare_exchange(state, state + 1, MemoryOrder::Acquire))
+            {
+                return;
+            }
+            continue;
+        }
+
+        if (!(state & WaitersBit))
+        {
+            if (!m_state.compare_exchange(state, state | WaitersBit, MemoryOrder::Relaxed))
+            {
+                continue;
+            }
+            state |= WaitersBit;
+        }
+
+        Platform::wait_on_address(m_state.address(), state);
+        state = m_state.load(MemoryOrder::Relaxed);
+    }
+}
+
+void ReadWriteLock::lock_contended()
+{
+    uint32_t state = m_state.load(MemoryOrder::Relaxed);
+    while (true)
+    {
+        // The waiters bit is preserved when acquiring the lock, as other threads might still sleep.
+        // The writer waiting bit is cleared; the other waiting writers set it again when they wake up.
+        if ((state & (ReadersMask | WriterBit)) == 0)
+        {
+            if (m_state.compare_exchange(state, (state | WriterBit) & ~WriterWaitingBit, MemoryOrder::Acquire))
+            {
+                return;
+            }
+            continue;
+        }
+
+        if ((state & (WaitersBit | WriterWaitingBit)) != (WaitersBit | WriterWaitingBit))
+        {
+            if (!m_state.compare_exchange(state, state | WaitersBit | WriterWaitingBit, MemoryOrder::Relaxed))
+            {
+                continue;
+            }
+            state |= WaitersBit | WriterWaitingBit;
+        }
+
+        Platform::wait_on_address(m_state.address(), state);
+        state = m_state.load(MemoryOrder::Relaxed);
+    }
+}
+
+void ReadWriteLock::wake_waiters()
+{
+    uint32_t state = m_state.load(MemoryOrder::Relaxed);
+    while (true)
+    {
+        // Somebody else acquired the lock in the meantime. They will issue the wake up when they release it.
+        if ((state & (ReadersMask | WriterBit)) != 0 || !(state & WaitersBit))
+        {
+            return;
+        }
+
+        if (m_state.compare_exchange(state, state & ~WaitersBit, MemoryOrder::Relaxed))
+        {
+            wake_all();
+            return;
+        }
+    }
+}
+
+void ReadWriteLock::wake_all()
+{
+    Platform::wake_by_address_all(m_state.address());
+}
+
+} // namespace HC
@@ -0,0 +1,121 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Platform/Platform.h"
+
+#include "Atomic.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Read-Write Lock.
+ *----------------------------------------------------------------
+ * Futex-based shared/exclusive lock, stored in a single 32-bit word:
+ *   bits [0, 28] - The number of readers that hold the lock.
+ *   bit  29      - Set while a writer waits for the lock.
+ *   bit  30      - Set while a writer holds the lock.
+ *   bit  31      - Set while (possibly) some threads sleep waiting for the lock.
+ * New readers don't enter while a writer waits, so writers can't be starved by a
+ *   continuous stream of readers.
+ */
+class ReadWriteLock
+{
+public:
+    HC_NON_COPIABLE(ReadWriteLock)
+    HC_NON_MOVABLE(ReadWriteLock)
+
+    ReadWriteLock()
+        : m_state(0)
+    {}
+
+    ~ReadWriteLock()
+    {
+        HC_ASSERT((m_state.load(MemoryOrder::Relaxed) & (ReadersMask | WriterBit)) == 0); // Destroying a locked read-write lock!
+    }
+
+public:
+    ALWAYS_INLINE void lock_shared()
+    {
+        uint32_t state = m_state.load(MemoryOrder::Relaxed);
+        if ((state & (WriterBit | WriterWaitingBit | WaitersBit)) != 0 || !m_state.compare_exchange(state, state + 1, MemoryOrder::Acquire))
+        {
+            lock_shared_contended();
+        }
+    }
+
+    ALWAYS_INLINE void unlock_shared()
+    {
+        const uint32_t previous_state = m_state.fetch_sub(1, MemoryOrder::Release);
+        if ((previous_state & WaitersBit) && (previous_state & ReadersMask) == 1)
+        {
+            wake_waiters();
+        }
+    }
+
+    ALWAYS_INLINE void lock()
+    {
+        uint32_t expected = 0;
+        if (!m_state.compare_exchange(expected, WriterBit, MemoryOrder::Acquire))
+        {
+            lock_contended();
+        }
+    }
+
+    ALWAYS_INLINE void unlock()
+    {
+        if (m_state.exchange(0, MemoryOrder::Release) & WaitersBit)
+        {
+            wake_all();
+        }
+    }
+
+private:
+    HC_API void lock_shared_contended();
+    HC_API void lock_contended();
+
+    // Invoked by the last reader that leaves while threads are waiting.
+    HC_API void wake_waiters();
+
+    HC_API void wake_all();
+
+private:
+    static constexpr uint32_t ReadersMask       = 0x1FFFFFFF;
+    static constexpr uint32_t WriterWaitingBit  = 0x20000000;
+    static constexpr uint32_t WriterBit         = 0x40000000;
+    static constexpr uint32_t WaitersBit        = 0x80000000;
+
+    Atomic<uint32_t> m_state;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Scoped Shared Lock.
+ *----------------------------------------------------------------
+ * Locks the given read-write lock in shared mode for the duration of the scope.
+ */
+class ScopedSharedLock
+{
+public:
+    HC_NON_COPIABLE(ScopedSharedLock)
+    HC_NON_MOVABLE(ScopedSharedLock)
+
+    ALWAYS_INLINE ScopedSharedLock(ReadWriteLock& lock)
+        : m_lock(lock)
+    {
+        m_lock.lock_shared();
+    }
+
+    ALWAYS_INLINE ~ScopedSharedLock()
+    {
+        m_lock.unlock_shared();
+    }
+
+private:
+    ReadWriteLock& m_lock;
+};
+
+} // namespace HC
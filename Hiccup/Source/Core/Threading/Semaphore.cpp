@@ -0,0 +1,48 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "Semaphore.h"
+
+namespace HC
+{
+
+bool Semaphore::acquire_contended(uint32_t timeout_milliseconds)
+{
+    const uint64_t deadline = (timeout_milliseconds != Platform::InfiniteTimeout) ?
+        Platform::get_nanoseconds() + (uint64_t)timeout_milliseconds * 1000000 : 0;
+
+    m_waiters_count.fetch_add(1);
+
+    bool was_acquired = false;
+    while (!(was_acquired = try_acquire()))
+    {
+        uint32_t remaining_milliseconds = Platform::InfiniteTimeout;
+        if (deadline != 0)
+        {
+            const uint64_t now = Platform::get_nanoseconds();
+            if (now >= deadline)
+            {
+                break;
+            }
+            remaining_milliseconds = (uint32_t)((deadline - now + 999999) / 1000000);
+        }
+
+        Platform::wait_on_address(m_count.address(), 0, remaining_milliseconds);
+    }
+
+    m_waiters_count.fetch_sub(1, MemoryOrder::Relaxed);
+    return was_acquired;
+}
+
+void Semaphore::wake_waiters(uint32_t count)
+{
+    if (count == 1)
+    {
+        Platform::wake_by_address_single(m_count.address());
+    }
+    else
+    {
+        Platform::wake_by_address_all(m_count.address());
+    }
+}
+
+} // namespace HC
@@ -0,0 +1,88 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Platform/Platform.h"
+
+#include "Atomic.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Semaphore.
+ *----------------------------------------------------------------
+ * Futex-based counting semaphore. Acquiring while the count is positive and releasing
+ *   while nobody waits never involve the kernel.
+ */
+class Semaphore
+{
+public:
+    HC_NON_COPIABLE(Semaphore)
+    HC_NON_MOVABLE(Semaphore)
+
+    Semaphore(uint32_t initial_count = 0)
+        : m_count(initial_count)
+        , m_waiters_count(0)
+    {}
+
+public:
+    /** @return True if the count was decremented; False if it is 0. */
+    ALWAYS_INLINE NODISCARD bool try_acquire()
+    {
+        uint32_t count = m_count.load(MemoryOrder::Relaxed);
+        while (count > 0)
+        {
+            // On failure, the count is updated to the currently stored value.
+            if (m_count.compare_exchange(count, count - 1, MemoryOrder::Acquire))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /** Decrements the count, blocking the calling thread while it is 0. */
+    ALWAYS_INLINE void acquire()
+    {
+        if (!try_acquire())
+        {
+            acquire_contended(Platform::InfiniteTimeout);
+        }
+    }
+
+    /**
+     * Same as 'acquire', but gives up after the given timeout expires.
+     *
+     * @return True if the count was decremented; False if the wait timed out.
+     */
+    ALWAYS_INLINE NODISCARD bool acquire_for(uint32_t timeout_milliseconds)
+    {
+        return try_acquire() || acquire_contended(timeout_milliseconds);
+    }
+
+    /** Increments the count, waking up at most as many waiting threads. */
+    ALWAYS_INLINE void release(uint32_t count = 1)
+    {
+        m_count.fetch_add(count);
+        if (m_waiters_count.load() > 0)
+        {
+            wake_waiters(count);
+        }
+    }
+
+private:
+    HC_API bool acquire_contended(uint32_t timeout_milliseconds);
+    HC_API void wake_waiters(uint32_t count);
+
+private:
+    Atomic<uint32_t> m_count;
+
+    // The number of threads currently blocked in 'acquire_contended'.
+    Atomic<uint32_t> m_waiters_count;
+};
+
+} // namespace HC
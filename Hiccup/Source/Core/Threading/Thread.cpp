@@ -0,0 +1,124 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "Thread.h"
+
+#include "Core/Memory/Memory.h"
+#include "Core/Containers/String.h"
+
+namespace HC
+{
+
+bool Thread::start(const ThreadDescription& description)
+{
+    HC_ASSERT(m_handle == nullptr); // The thread is already running!
+    HC_ASSERT(description.function != nullptr);
+
+    m_function = description.function;
+    m_user_data = description.user_data;
+
+    // Truncate the name, if it doesn't fit in the inline buffer. The cut is moved back to the start of
+    //   the code point it lands in, so that no partial UTF-8 sequence is kept.
+    size_t name_bytes_count = utf8_string_bytes_count(description.name);
+    if (name_bytes_count > MaxNameBytesCount - 1)
+    {
+        name_bytes_count = MaxNameBytesCount - 1;
+        while (name_bytes_count > 0 && (description.name[name_bytes_count] & 0xC0) == 0x80)
+        {
+            --name_bytes_count;
+        }
+    }
+    Memory::copy(m_name, description.name, name_bytes_count);
+    m_name[name_bytes_count] = 0;
+
+    m_handle = Platform::create_thread(Thread::entry_point, this, description.stack_size);
+    if (!m_handle)
+    {
+        HC_LOG_ERROR("Thread::start - Failed to create the thread '%s'!", m_name);
+        return false;
+    }
+
+    // The thread is created suspended, so it runs on the requested processors from its first instruction.
+    Platform::set_thread_name(m_handle, m_name);
+
+    if (description.affinity_mask != 0)
+    {
+        set_affinity(description.affinity_mask);
+    }
+    else if (description.numa_node != Platform::AnyNumaNode)
+    {
+        set_numa_node(description.numa_node);
+    }
+
+    if (description.priority != Platform::ThreadPriority::Normal)
+    {
+        set_priority(description.priority);
+    }
+
+    if (!Platform::resume_thread(m_handle))
+    {
+        HC_LOG_ERROR("Thread::start - Failed to resume the thread '%s'!", m_name);
+        Platform::cancel_thread(m_handle);
+        m_handle = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void Thread::join()
+{
+    if (!m_handle)
+    {
+        return;
+    }
+
+    Platform::join_thread(m_handle);
+    m_handle = nullptr;
+}
+
+bool Thread::set_affinity(uint64_t affinity_mask)
+{
+    HC_ASSERT(m_handle != nullptr); // The thread is not running!
+    return Platform::set_thread_affinity(m_handle, affinity_mask);
+}
+
+bool Thread::set_numa_node(uint32_t numa_node)
+{
+    HC_ASSERT(m_handle != nullptr); // The thread is not running!
+    return Platform::set_thread_numa_node(m_handle, numa_node);
+}
+
+bool Thread::set_priority(Platform::ThreadPriority priority)
+{
+    HC_ASSERT(m_handle != nullptr); // The thread is not running!
+    return Platform::set_thread_priority(m_handle, priority);
+}
+
+uint32_t Thread::current_id()
+{
+    return Platform::get_current_thread_id();
+}
+
+uint32_t Thread::processor_count()
+{
+    return Platform::get_processor_count();
+}
+
+void Thread::yield()
+{
+    Platform::yield_thread();
+}
+
+void Thread::sleep(uint32_t milliseconds)
+{
+    Platform::sleep_milliseconds(milliseconds);
+}
+
+uint32_t Thread::entry_point(void* thread_instance)
+{
+    Thread* thread = (Thread*)thread_instance;
+    thread->m_function(thread->m_user_data);
+    return 0;
+}
+
+} // namespace HC
@@ -0,0 +1,124 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Platform/Platform.h"
+
+namespace HC
+{
+
+// The signature of the function that a 'Thread' executes.
+using PFN_ThreadFunction = void(*)(void* user_data);
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Thread Description.
+ *----------------------------------------------------------------
+ */
+struct ThreadDescription
+{
+    // The function that the thread executes.
+    PFN_ThreadFunction function = nullptr;
+
+    // Opaque pointer passed to the thread function.
+    void* user_data = nullptr;
+
+    // The name of the thread, as visible in debuggers and profilers.
+    const char* name = "Unnamed Thread";
+
+    // The processors that the thread is allowed to run on. If 0, the thread can run on any processor.
+    uint64_t affinity_mask = 0;
+
+    // The NUMA node that the thread is pinned to. Ignored if an affinity mask is specified.
+    uint32_t numa_node = Platform::AnyNumaNode;
+
+    Platform::ThreadPriority priority = Platform::ThreadPriority::Normal;
+
+    // The size (in bytes) of the thread's stack. If 0, the platform default is used.
+    size_t stack_size = 0;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Thread.
+ *----------------------------------------------------------------
+ * Owning wrapper around a native thread. Starting a thread doesn't perform any heap
+ *   allocation, as the thread function and its user data are stored inline.
+ * A started thread must be joined before the object is destroyed.
+ */
+class Thread
+{
+public:
+    HC_NON_COPIABLE(Thread)
+    HC_NON_MOVABLE(Thread)
+
+    // The maximum number of bytes (including the null-termination byte) stored for the thread name.
+    static constexpr size_t MaxNameBytesCount = 32;
+
+public:
+    Thread()
+        : m_handle(nullptr)
+        , m_function(nullptr)
+        , m_user_data(nullptr)
+        , m_name{}
+    {}
+
+    ~Thread()
+    {
+        HC_ASSERT(m_handle == nullptr); // The thread was not joined!
+    }
+
+public:
+    /**
+     * Creates the native thread and starts executing the thread function.
+     *
+     * @param description The thread description.
+     *
+     * @return True if the thread was successfully started; False otherwise.
+     */
+    HC_API bool start(const ThreadDescription& description);
+
+    /**
+     * Blocks until the thread function returns. Calling this on a thread that is
+     *   not running does nothing.
+     */
+    HC_API void join();
+
+    HC_API bool set_affinity(uint64_t affinity_mask);
+
+    /** Restricts the thread to the processors of the given NUMA node, so its memory accesses stay local. */
+    HC_API bool set_numa_node(uint32_t numa_node);
+    HC_API bool set_priority(Platform::ThreadPriority priority);
+
+public:
+    ALWAYS_INLINE NODISCARD bool is_running() const { return (m_handle != nullptr); }
+
+    ALWAYS_INLINE NODISCARD const char* get_name() const { return m_name; }
+
+public:
+    /** @return The identifier of the calling thread. */
+    HC_API static uint32_t current_id();
+
+    /** @return The number of logical processors available to the process. */
+    HC_API static uint32_t processor_count();
+
+    HC_API static void yield();
+
+    HC_API static void sleep(uint32_t milliseconds);
+
+private:
+    static uint32_t entry_point(void* thread_instance);
+
+private:
+    // The native thread handle. Valid only while the thread is running (or not yet joined).
+    Platform::ThreadHandle m_handle;
+
+    // The function that the thread executes, alongside its user data.
+    PFN_ThreadFunction m_function;
+    void* m_user_data;
+
+    char m_name[MaxNameBytesCount];
+};
+
+} // namespace HC
@@ -0,0 +1,48 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "ThreadEvent.h"
+
+namespace HC
+{
+
+bool ThreadEvent::wait_contended(uint32_t timeout_milliseconds)
+{
+    const uint64_t deadline = (timeout_milliseconds != Platform::InfiniteTimeout) ?
+        Platform::get_nanoseconds() + (uint64_t)timeout_milliseconds * 1000000 : 0;
+
+    m_waiters_count.fetch_add(1);
+
+    bool was_signaled = false;
+    while (!(was_signaled = try_consume()))
+    {
+        uint32_t remaining_milliseconds = Platform::InfiniteTimeout;
+        if (deadline != 0)
+        {
+            const uint64_t now = Platform::get_nanoseconds();
+            if (now >= deadline)
+            {
+                break;
+            }
+            remaining_milliseconds = (uint32_t)((deadline - now + 999999) / 1000000);
+        }
+
+        Platform::wait_on_address(m_state.address(), NotSignaled, remaining_milliseconds);
+    }
+
+    m_waiters_count.fetch_sub(1, MemoryOrder::Relaxed);
+    return was_signaled;
+}
+
+void ThreadEvent::wake_waiters()
+{
+    if (m_reset_mode == EventResetMode::Automatic)
+    {
+        Platform::wake_by_address_single(m_state.address());
+    }
+    else
+    {
+        Platform::wake_by_address_all(m_state.address());
+    }
+}
+
+} // namespace HC
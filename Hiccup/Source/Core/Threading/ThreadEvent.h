@@ -0,0 +1,107 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+#include "Core/Platform/Platform.h"
+
+#include "Atomic.h"
+
+namespace HC
+{
+
+// The ways an event can be reset after being signaled.
+enum class EventResetMode : uint8_t
+{
+    // The event is reset automatically when a single waiting thread is released.
+    Automatic = 0,
+
+    // The event stays signaled, releasing all waiting threads, until 'reset' is called.
+    Manual = 1
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Thread Event.
+ *----------------------------------------------------------------
+ * Futex-based, one-shot or broadcast signaling primitive.
+ */
+class ThreadEvent
+{
+public:
+    HC_NON_COPIABLE(ThreadEvent)
+    HC_NON_MOVABLE(ThreadEvent)
+
+    ThreadEvent(EventResetMode reset_mode = EventResetMode::Automatic, bool is_initially_signaled = false)
+        : m_state(is_initially_signaled ? Signaled : NotSignaled)
+        , m_waiters_count(0)
+        , m_reset_mode(reset_mode)
+    {}
+
+public:
+    ALWAYS_INLINE void signal()
+    {
+        m_state.exchange(Signaled, MemoryOrder::Release);
+        if (m_waiters_count.load() > 0)
+        {
+            wake_waiters();
+        }
+    }
+
+    ALWAYS_INLINE void reset()
+    {
+        m_state.store(NotSignaled, MemoryOrder::Relaxed);
+    }
+
+    ALWAYS_INLINE NODISCARD bool is_signaled() const { return (m_state.load(MemoryOrder::Acquire) == Signaled); }
+
+    /** Blocks the calling thread until the event is signaled. */
+    ALWAYS_INLINE void wait()
+    {
+        if (!try_consume())
+        {
+            wait_contended(Platform::InfiniteTimeout);
+        }
+    }
+
+    /**
+     * Same as 'wait', but gives up after the given timeout expires.
+     *
+     * @return True if the event was signaled; False if the wait timed out.
+     */
+    ALWAYS_INLINE NODISCARD bool wait_for(uint32_t timeout_milliseconds)
+    {
+        return try_consume() || wait_contended(timeout_milliseconds);
+    }
+
+private:
+    // Checks whether the event is signaled, resetting it if it is an automatic event.
+    ALWAYS_INLINE bool try_consume()
+    {
+        if (m_reset_mode == EventResetMode::Manual)
+        {
+            return (m_state.load(MemoryOrder::Acquire) == Signaled);
+        }
+
+        uint32_t expected = Signaled;
+        return m_state.compare_exchange(expected, NotSignaled, MemoryOrder::Acquire);
+    }
+
+    HC_API bool wait_contended(uint32_t timeout_milliseconds);
+    HC_API void wake_waiters();
+
+private:
+    enum : uint32_t
+    {
+        NotSignaled = 0, Signaled = 1
+    };
+
+    Atomic<uint32_t> m_state;
+
+    // The number of threads currently blocked in 'wait_contended'.
+    Atomic<uint32_t> m_waiters_count;
+
+    EventResetMode m_reset_mode;
+};
+
+} // namespace HC
@@ -0,0 +1,197 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/Core.h"
+
+namespace HC
+{
+
+using AssetTypeID = uint32_t;
+
+enum class AssetState : uint8_t
+{
+    // Waiting in the load queue.
+    Queued = 0,
+
+    // Being read, decompressed or processed on a worker thread.
+    Loading = 1,
+
+    Loaded = 2,
+    Failed = 3,
+};
+
+enum class AssetPriority : uint8_t
+{
+    High = 0, Normal = 1, Low = 2,
+
+    MaxEnumValue
+};
+
+/**
+ * Converts the file contents into the runtime object of an asset. Invoked on a worker thread.
+ *
+ * @param data The file contents, already decompressed. Only valid during the call.
+ * @param out_object The runtime object, destroyed later by the loader's 'destroy' function.
+ * @param out_memory_size The number of bytes the runtime object occupies. Counted against the asset memory budget.
+ */
+using PFN_AssetProcess = ErrorCode(*)(StringView path, Span<const uint8_t> data, void** out_object, size_t* out_memory_size);
+
+using PFN_AssetDestroy = void(*)(void* object);
+
+struct AssetLoader
+{
+    PFN_AssetProcess process;
+    PFN_AssetDestroy destroy;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Asset.
+ *----------------------------------------------------------------
+ * Owned by the asset manager. Never accessed directly - only through 'AssetHandle'.
+ */
+class Asset
+{
+public:
+    HC_NON_COPIABLE(Asset)
+    HC_NON_MOVABLE(Asset)
+
+private:
+    Asset() = default;
+
+private:
+    // The number of handles that reference the asset. When it reaches zero, the asset
+    //   becomes a candidate for eviction, but it stays cached until the memory budget requires it.
+    Atomic<uint32_t> m_reference_count;
+
+    Atomic<AssetState> m_state;
+
+    uint64_t m_path_hash;
+    String m_path;
+
+    AssetTypeID m_type;
+    AssetPriority m_priority;
+
+    // Written by the loading job, before publishing the 'Loaded' state.
+    void* m_object;
+    size_t m_memory_size;
+
+    // Links in the table of alive assets, keyed by the path hash.
+    IntrusiveHashNode m_table_node;
+
+    // Links in the load queue of the asset priority. Only queued assets are linked.
+    IntrusiveListNode m_queue_node;
+
+    // Links in the eviction list. Only unreferenced, loaded assets are linked.
+    IntrusiveListNode m_lru_node;
+
+    friend class AssetHandle;
+    friend class AssetManager;
+    friend struct AssetManagerData;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Asset Handle.
+ *----------------------------------------------------------------
+ * A reference-counted handle to an asset, with the same semantics as 'RefPtr'.
+ * The reference count is atomic, so handles can be copied and released on any thread.
+ * Loading is asynchronous: the handle is returned immediately, and the runtime object is
+ *   available once 'is_loaded' returns true.
+ */
+class AssetHandle
+{
+public:
+    AssetHandle()
+        : m_asset(nullptr)
+    {}
+
+    AssetHandle(const AssetHandle& other)
+        : m_asset(other.m_asset)
+    {
+        if (m_asset)
+        {
+            m_asset->m_reference_count.fetch_add(1, MemoryOrder::Relaxed);
+        }
+    }
+
+    AssetHandle(AssetHandle&& other) noexcept
+        : m_asset(other.m_asset)
+    {
+        other.m_asset = nullptr;
+    }
+
+    ~AssetHandle()
+    {
+        release();
+    }
+
+    AssetHandle& operator=(const AssetHandle& other)
+    {
+        if (other.m_asset)
+        {
+            other.m_asset->m_reference_count.fetch_add(1, MemoryOrder::Relaxed);
+        }
+
+        release();
+        m_asset = other.m_asset;
+        return *this;
+    }
+
+    AssetHandle& operator=(AssetHandle&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            m_asset = other.m_asset;
+            other.m_asset = nullptr;
+        }
+        return *this;
+    }
+
+public:
+    ALWAYS_INLINE bool is_valid() const { return (m_asset != nullptr); }
+    ALWAYS_INLINE operator bool() const { return is_valid(); }
+
+    ALWAYS_INLINE AssetState get_state() const
+    {
+        HC_DASSERT(m_asset); // Invalid asset handle!
+        return m_asset->m_state.load(MemoryOrder::Acquire);
+    }
+
+    ALWAYS_INLINE bool is_loaded() const { return get_state() == AssetState::Loaded; }
+    ALWAYS_INLINE bool has_failed() const { return get_state() == AssetState::Failed; }
+
+    /** @return The runtime object of the asset, or nullptr if it isn't loaded yet. */
+    template<typename T>
+    ALWAYS_INLINE T* get() const
+    {
+        return is_loaded() ? (T*)m_asset->m_object : nullptr;
+    }
+
+    ALWAYS_INLINE StringView get_path() const
+    {
+        HC_DASSERT(m_asset); // Invalid asset handle!
+        return StringView(m_asset->m_path.c_str(), m_asset->m_path.bytes_count() - 1);
+    }
+
+    HC_API void release();
+
+public:
+    ALWAYS_INLINE bool operator==(const AssetHandle& other) const { return (m_asset == other.m_asset); }
+    ALWAYS_INLINE bool operator!=(const AssetHandle& other) const { return (m_asset != other.m_asset); }
+
+private:
+    // Adopts a reference that was already added by the asset manager.
+    explicit AssetHandle(Asset* asset)
+        : m_asset(asset)
+    {}
+
+private:
+    Asset* m_asset;
+
+    friend class AssetManager;
+};
+
+} // namespace HC
@@ -0,0 +1,427 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "AssetManager.h"
+
+namespace HC
+{
+
+struct AssetManagerData
+{
+    AssetManagerDescription description;
+
+    // Guards all the data below, and the non-atomic fields of all assets.
+    Mutex lock;
+
+    AssetLoader loaders[AssetManager::MaxAssetTypesCount];
+
+    // Maps the normalized path hashes to the assets. Contains every asset that is alive.
+    IntrusiveHashTable<Asset, uint64_t, &Asset::m_path_hash, &Asset::m_table_node> assets;
+
+    // One FIFO queue for each priority.
+    IntrusiveList<Asset, &Asset::m_queue_node> queues[(uint8_t)AssetPriority::MaxEnumValue];
+    uint32_t queued_count;
+
+    uint32_t in_flight_count;
+    JobCounter in_flight_counter;
+
+    // The eviction list, from the least to the most recently used.
+    IntrusiveList<Asset, &Asset::m_lru_node> lru;
+
+    // The memory occupied by all loaded assets.
+    size_t resident_memory;
+};
+static_internal AssetManagerData* s_asset_manager_data = nullptr;
+
+static_internal JobPriority get_job_priority(AssetPriority priority)
+{
+    switch (priority)
+    {
+        case AssetPriority::High:   return JobPriority::High;
+        case AssetPriority::Normal: return JobPriority::Normal;
+        case AssetPriority::Low:    return JobPriority::Low;
+        default:                    return JobPriority::Normal;
+    }
+}
+
+void AssetHandle::release()
+{
+    if (!m_asset)
+    {
+        return;
+    }
+
+    // Only the last reference is released under the manager lock. Otherwise, the asset could be
+    //   resurrected and evicted by other threads before 'on_asset_unreferenced' acquires the lock.
+    uint32_t reference_count = m_asset->m_reference_count.load(MemoryOrder::Relaxed);
+    while (reference_count > 1)
+    {
+        if (m_asset->m_reference_count.compare_exchange(reference_count, reference_count - 1, MemoryOrder::AcquireRelease))
+        {
+            m_asset = nullptr;
+            return;
+        }
+    }
+
+    AssetManager::on_asset_unreferenced(m_asset);
+    m_asset = nullptr;
+}
+
+bool AssetManager::initialize(const AssetManagerDescription& description)
+{
+    HC_MEMORY_TAG_SCOPE(Assets);
+    s_asset_manager_data = hc_new AssetManagerData();
+    s_asset_manager_data->description = description;
+
+    Memory::zero(s_asset_manager_data->loaders, sizeof(s_asset_manager_data->loaders));
+    s_asset_manager_data->queued_count = 0;
+    s_asset_manager_data->in_flight_count = 0;
+    s_asset_manager_data->resident_memory = 0;
+
+    return true;
+}
+
+void AssetManager::shutdown()
+{
+    JobSystem::wait(s_asset_manager_data->in_flight_counter);
+
+    // Destroying the cached assets might release the last handles to other assets, which then
+    //   become cached as well. Repeated until nothing new is released.
+    while (true)
+    {
+        AssetList unlinked_assets;
+        {
+            ScopedLock<Mutex> lock(s_asset_manager_data->lock);
+            while (!s_asset_manager_data->lru.is_empty())
+            {
+                unlink_asset(s_asset_manager_data->lru.front(), unlinked_assets);
+            }
+        }
+
+        if (unlinked_assets.is_empty())
+        {
+            break;
+        }
+        destroy_assets(unlinked_assets);
+    }
+
+    // The remaining assets are either queued or still referenced. An extra reference is taken for each of them,
+    //   so releasing their handles while the objects are destroyed never re-enters the manager.
+    uint32_t leaked_count = 0;
+    AssetList unlinked_assets;
+    {
+        ScopedLock<Mutex> lock(s_asset_manager_data->lock);
+        s_asset_manager_data->assets.for_each([&leaked_count, &unlinked_assets](Asset* asset) -> bool
+        {
+            if (asset->m_reference_count.fetch_add(1, MemoryOrder::Relaxed) > 0)
+            {
+                ++leaked_count;
+            }
+            unlink_asset(asset, unlinked_assets);
+            return true;
+        });
+    }
+    destroy_assets(unlinked_assets);
+
+    if (leaked_count > 0)
+    {
+        HC_LOG_WARN("AssetManager::shutdown - %u asset(s) are still referenced! Their handles are now dangling.", leaked_count);
+    }
+
+    hc_delete s_asset_manager_data;
+    s_asset_manager_data = nullptr;
+}
+
+void AssetManager::register_loader(AssetTypeID type, const AssetLoader& loader)
+{
+    HC_ASSERT(type < MaxAssetTypesCount); // Invalid asset type!
+    HC_ASSERT(loader.process && loader.destroy); // Invalid asset loader!
+
+    ScopedLock<Mutex> lock(s_asset_manager_data->lock);
+    s_asset_manager_data->loaders[type] = loader;
+}
+
+AssetHandle AssetManager::load(StringView path, AssetTypeID type, AssetPriority priority)
+{
+    HC_MEMORY_TAG_SCOPE(Assets);
+    HC_ASSERT(type < MaxAssetTypesCount); // Invalid asset type!
+
+    // Paths are normalized the same way as by the virtual file system, so different
+    //   spellings of the same path are deduplicated.
+    const uint64_t path_hash = PackFile::compute_path_hash(path);
+
+    ScopedLock<Mutex> lock(s_asset_manager_data->lock);
+
+    Asset* cached_asset = s_asset_manager_data->assets.find(path_hash);
+    if (cached_asset)
+    {
+        HC_ASSERT(cached_asset->m_type == type); // The asset was already requested with a different type!
+
+        if (cached_asset->m_lru_node.is_linked())
+        {
+            s_asset_manager_data->lru.remove(cached_asset);
+        }
+
+        cached_asset->m_reference_count.fetch_add(1, MemoryOrder::Relaxed);
+        return AssetHandle(cached_asset);
+    }
+
+    Asset* asset = hc_new Asset();
+    asset->m_reference_count.store(1, MemoryOrder::Relaxed);
+    asset->m_state.store(AssetState::Queued, MemoryOrder::Relaxed);
+    asset->m_path_hash = path_hash;
+    asset->m_path = String(path);
+    asset->m_type = type;
+    asset->m_priority = priority;
+    asset->m_object = nullptr;
+    asset->m_memory_size = 0;
+
+    s_asset_manager_data->assets.insert(asset);
+    s_asset_manager_data->queues[(uint8_t)priority].push_back(asset);
+    ++s_asset_manager_data->queued_count;
+
+    return AssetHandle(asset);
+}
+
+void AssetManager::update()
+{
+    HC_PROFILE_FUNCTION();
+
+    Asset* assets_to_dispatch[32];
+    uint32_t dispatch_count = 0;
+    AssetList unlinked_assets;
+
+    {
+        ScopedLock<Mutex> lock(s_asset_manager_data->lock);
+
+        uint8_t queue_index = 0;
+        while (s_asset_manager_data->queued_count > 0 && dispatch_count < array_count(assets_to_dispatch) &&
+            s_asset_manager_data->in_flight_count < s_asset_manager_data->description.max_in_flight_loads)
+        {
+            // Finding the highest priority queue that isn't empty.
+            while (s_asset_manager_data->queues[queue_index].is_empty())
+            {
+                ++queue_index;
+            }
+
+            Asset* asset = s_asset_manager_data->queues[queue_index].pop_front();
+            --s_asset_manager_data->queued_count;
+
+            // Nobody wants the asset anymore, so it isn't worth loading.
+            if (asset->m_reference_count.load(MemoryOrder::Relaxed) == 0)
+            {
+                unlink_asset(asset, unlinked_assets);
+                continue;
+            }
+
+            asset->m_state.store(AssetState::Loading, MemoryOrder::Relaxed);
+            ++s_asset_manager_data->in_flight_count;
+            assets_to_dispatch[dispatch_count++] = asset;
+        }
+    }
+
+    destroy_assets(unlinked_assets);
+
+    for (uint32_t index = 0; index < dispatch_count; ++index)
+    {
+        Asset* asset = assets_to_dispatch[index];
+        JobSystem::schedule({ load_asset_job, asset }, &s_asset_manager_data->in_flight_counter, get_job_priority(asset->m_priority));
+    }
+}
+
+void AssetManager::wait_for_all_loads()
+{
+    while (true)
+    {
+        update();
+        JobSystem::wait(s_asset_manager_data->in_flight_counter);
+
+        ScopedLock<Mutex> lock(s_asset_manager_data->lock);
+        if (s_asset_manager_data->queued_count == 0 && s_asset_manager_data->in_flight_count == 0)
+        {
+            break;
+        }
+    }
+}
+
+size_t AssetManager::get_resident_memory()
+{
+    ScopedLock<Mutex> lock(s_asset_manager_data->lock);
+    return s_asset_manager_data->resident_memory;
+}
+
+uint32_t AssetManager::get_queued_loads_count()
+{
+    ScopedLock<Mutex> lock(s_asset_manager_data->lock);
+    return s_asset_manager_data->queued_count;
+}
+
+uint32_t AssetManager::get_in_flight_loads_count()
+{
+    ScopedLock<Mutex> lock(s_asset_manager_data->lock);
+    return s_asset_manager_data->in_flight_count;
+}
+
+void AssetManager::on_asset_unreferenced(Asset* asset)
+{
+    AssetList unlinked_assets;
+
+    {
+        ScopedLock<Mutex> lock(s_asset_manager_data->lock);
+
+        if (asset->m_reference_count.fetch_sub(1, MemoryOrder::AcquireRelease) != 1)
+        {
+            // Another handle was created meanwhile.
+            return;
+        }
+
+        // Queued and loading assets are handled when they are dispatched or finished.
+        switch (asset->m_state.load(MemoryOrder::Relaxed))
+        {
+            case AssetState::Loaded:
+            {
+                s_asset_manager_data->lru.push_back(asset);
+                evict_over_budget(unlinked_assets);
+                break;
+            }
+
+            case AssetState::Failed:
+            {
+                unlink_asset(asset, unlinked_assets);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    destroy_assets(unlinked_assets);
+}
+
+void AssetManager::load_asset_job(void* user_data)
+{
+    HC_PROFILE_FUNCTION();
+    HC_MEMORY_TAG_SCOPE(Assets);
+
+    Asset* asset = (Asset*)user_data;
+    const StringView path = StringView(asset->m_path.c_str(), asset->m_path.bytes_count() - 1);
+
+    // The loaders are registered before any load is requested, so they can be read without the lock.
+    const AssetLoader& loader = s_asset_manager_data->loaders[asset->m_type];
+
+    void* object = nullptr;
+    size_t memory_size = 0;
+    ErrorCode error = ErrorCode::Success;
+
+    if (!loader.process)
+    {
+        HC_LOG_ERROR("AssetManager - No loader is registered for the asset type %u!", asset->m_type);
+        error = ErrorCode::InvalidParameter;
+    }
+
+    // Stage 1: I/O. Files from packs are views into the mapped pack, so nothing is copied.
+    VirtualFile file;
+    if (error == ErrorCode::Success)
+    {
+        error = VirtualFileSystem::open_file(path, file);
+    }
+
+    // Stage 2: Decompression. Compressed frames are detected by their magic number.
+    Buffer decompressed_buffer;
+    Span<const uint8_t> data = file.data();
+    if (error == ErrorCode::Success && data.count() >= sizeof(uint32_t) && *(const uint32_t*)data.elements() == Compression::FrameMagic)
+    {
+        error = Compression::decompress(data, decompressed_buffer);
+        data = Span<const uint8_t>(decompressed_buffer.data, decompressed_buffer.size);
+    }
+
+    // Stage 3: Processing.
+    if (error == ErrorCode::Success)
+    {
+        error = loader.process(path, data, &object, &memory_size);
+    }
+
+    if (decompressed_buffer.data)
+    {
+        decompressed_buffer.release();
+    }
+    file.close();
+
+    if (error != ErrorCode::Success)
+    {
+        HC_LOG_ERROR("AssetManager - Failed to load the asset '%.*s'!", (int)path.bytes_count(), path.c_str());
+    }
+
+    AssetList unlinked_assets;
+
+    {
+        ScopedLock<Mutex> lock(s_asset_manager_data->lock);
+
+        asset->m_object = object;
+        asset->m_memory_size = memory_size;
+        asset->m_state.store((error == ErrorCode::Success) ? AssetState::Loaded : AssetState::Failed, MemoryOrder::Release);
+
+        s_asset_manager_data->resident_memory += memory_size;
+        --s_asset_manager_data->in_flight_count;
+
+        // All handles were released while the asset was loading.
+        if (asset->m_reference_count.load(MemoryOrder::Relaxed) == 0)
+        {
+            if (error == ErrorCode::Success)
+            {
+                s_asset_manager_data->lru.push_back(asset);
+            }
+            else
+            {
+                unlink_asset(asset, unlinked_assets);
+            }
+        }
+
+        evict_over_budget(unlinked_assets);
+    }
+
+    destroy_assets(unlinked_assets);
+}
+
+void AssetManager::unlink_asset(Asset* asset, AssetList& unlinked_assets)
+{
+    if (asset->m_queue_node.is_linked())
+    {
+        s_asset_manager_data->queues[(uint8_t)asset->m_priority].remove(asset);
+        --s_asset_manager_data->queued_count;
+    }
+
+    if (asset->m_lru_node.is_linked())
+    {
+        s_asset_manager_data->lru.remove(asset);
+    }
+
+    // The memory is accounted as released right away, so the eviction loop doesn't evict more than needed.
+    s_asset_manager_data->resident_memory -= asset->m_memory_size;
+
+    s_asset_manager_data->assets.remove(asset);
+    unlinked_assets.push_back(asset);
+}
+
+void AssetManager::destroy_assets(AssetList& unlinked_assets)
+{
+    // The loaders are registered before any load is requested, so they can be read without the lock.
+    while (Asset* asset = unlinked_assets.pop_front())
+    {
+        if (asset->m_object)
+        {
+            s_asset_manager_data->loaders[asset->m_type].destroy(asset->m_object);
+        }
+        hc_delete asset;
+    }
+}
+
+void AssetManager::evict_over_budget(AssetList& unlinked_assets)
+{
+    while (s_asset_manager_data->resident_memory > s_asset_manager_data->description.memory_budget && !s_asset_manager_data->lru.is_empty())
+    {
+        unlink_asset(s_asset_manager_data->lru.front(), unlinked_assets);
+    }
+}
+
+} // namespace HC
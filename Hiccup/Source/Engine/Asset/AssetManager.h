@@ -0,0 +1,91 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/Core.h"
+#include "Asset.h"
+
+namespace HC
+{
+
+struct AssetManagerDescription
+{
+    // The number of bytes the loaded assets are allowed to occupy. When exceeded, unreferenced assets are
+    //   evicted, least recently used first. Referenced assets are never evicted, so the budget is a soft limit.
+    size_t memory_budget = 256 * 1024 * 1024;
+
+    // The maximum number of assets that are loaded at the same time. Bounding it prevents
+    //   the load jobs from occupying all workers, as they mostly wait for I/O.
+    uint32_t max_in_flight_loads = 8;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Asset Manager.
+ *----------------------------------------------------------------
+ * Loads assets in the background, through a pipeline executed on the job system workers:
+ *   read (through the virtual file system) -> decompress (if the file is a compressed frame) -> process (by the asset loader).
+ * Each path is loaded only once: requesting an asset that is already loaded (or loading) returns
+ *   a handle to the same asset.
+ * Unreferenced assets are kept in a least-recently-used cache, and evicted only when the
+ *   memory budget is exceeded.
+ */
+class AssetManager
+{
+public:
+    static constexpr uint32_t MaxAssetTypesCount = 64;
+
+public:
+    static bool initialize(const AssetManagerDescription& description);
+    static void shutdown();
+
+public:
+    HC_API static void register_loader(AssetTypeID type, const AssetLoader& loader);
+
+    /**
+     * Requests an asset. Never blocks - the load is queued and dispatched by 'update'.
+     *
+     * @param path The virtual path of the asset file.
+     * @param type The type of the asset. A loader must be registered for it.
+     * @param priority Queued requests are dispatched in priority order.
+     */
+    HC_API static AssetHandle load(StringView path, AssetTypeID type, AssetPriority priority = AssetPriority::Normal);
+
+    /**
+     * Dispatches the queued loads to the job system, highest priority first.
+     * Called once per frame, by the application. It never waits for a load to finish.
+     */
+    HC_API static void update();
+
+    /** Blocks until all queued and in-flight loads are finished. Intended for tools and loading screens. */
+    HC_API static void wait_for_all_loads();
+
+public:
+    HC_API static size_t get_resident_memory();
+    HC_API static uint32_t get_queued_loads_count();
+    HC_API static uint32_t get_in_flight_loads_count();
+
+private:
+    // Invoked when the last handle to the asset is released.
+    HC_API static void on_asset_unreferenced(Asset* asset);
+
+    static void load_asset_job(void* user_data);
+
+    // Assets that are unlinked from the manager but not yet destroyed. Linked through the eviction
+    //   list node, as unlinked assets are never in the eviction list.
+    using AssetList = IntrusiveList<Asset, &Asset::m_lru_node>;
+
+    // Unlinks the asset from all the manager structures. Must be called with the manager lock held.
+    static void unlink_asset(Asset* asset, AssetList& unlinked_assets);
+
+    // Destroys the unlinked assets. Must be called without the manager lock, because destroying an
+    //   asset object might release the handles it holds, which re-enters the manager.
+    static void destroy_assets(AssetList& unlinked_assets);
+
+    // Unlinks unreferenced assets until the memory budget is respected. Must be called with the manager lock held.
+    static void evict_over_budget(AssetList& unlinked_assets);
+
+    friend class AssetHandle;
+};
+
+} // namespace HC
@@ -0,0 +1,148 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "FrustumCulling.h"
+
+#if HC_SIMD_SSE
+    #include <immintrin.h>
+#endif // HC_SIMD_SSE
+
+namespace HC
+{
+
+uint32_t FrustumCulling::cull_boxes(const Frustum& frustum, Span<const AABB3> boxes, Array<uint32_t>& out_visible_indices)
+{
+    HC_PROFILE_FUNCTION();
+
+    out_visible_indices.set_size_uninitialized(boxes.count());
+    const uint32_t visible_count = cull_range(frustum, boxes.elements(), 0, (uint32_t)boxes.count(), out_visible_indices.data());
+    out_visible_indices.set_size_uninitialized(visible_count);
+
+    return visible_count;
+}
+
+uint32_t FrustumCulling::parallel_cull_boxes(const Frustum& frustum, Span<const AABB3> boxes, Array<uint32_t>& out_visible_indices)
+{
+    HC_PROFILE_FUNCTION();
+
+    if (boxes.count() < ParallelThreshold || !JobSystem::is_initialized())
+    {
+        return cull_boxes(frustum, boxes, out_visible_indices);
+    }
+
+    // Each job culls a fixed range into its own section of the output, which are compacted afterwards.
+    const uint32_t boxes_count = (uint32_t)boxes.count();
+    const uint32_t range_size = ParallelThreshold / 4;
+    const uint32_t ranges_count = (boxes_count + range_size - 1) / range_size;
+
+    Array<uint32_t> range_visible_counts;
+    range_visible_counts.set_size_zeroed(ranges_count);
+    out_visible_indices.set_size_uninitialized(boxes_count);
+
+    uint32_t* out_indices = out_visible_indices.data();
+    uint32_t* visible_counts = range_visible_counts.data();
+    const AABB3* boxes_data = boxes.elements();
+
+    JobSystem::parallel_for(ranges_count, 1, [&](size_t begin_range, size_t end_range)
+    {
+        for (size_t range = begin_range; range < end_range; ++range)
+        {
+            const uint32_t begin_index = (uint32_t)range * range_size;
+            const uint32_t end_index = Math::min<uint32_t>(begin_index + range_size, boxes_count);
+            visible_counts[range] = cull_range(frustum, boxes_data, begin_index, end_index, out_indices + begin_index);
+        }
+    });
+
+    // The sections are compacted in place. The destination never passes the source, but they can overlap.
+    uint32_t visible_count = 0;
+    for (uint32_t range = 0; range < ranges_count; ++range)
+    {
+        const uint32_t* section = out_indices + range * range_size;
+        for (uint32_t index = 0; index < visible_counts[range]; ++index)
+        {
+            out_indices[visible_count + index] = section[index];
+        }
+        visible_count += visible_counts[range];
+    }
+
+    out_visible_indices.set_size_uninitialized(visible_count);
+    return visible_count;
+}
+
+uint32_t FrustumCulling::cull_range(const Frustum& frustum, const AABB3* boxes, uint32_t begin_index, uint32_t end_index, uint32_t* out_indices)
+{
+    uint32_t visible_count = 0;
+    uint32_t index = begin_index;
+
+#if HC_SIMD_SSE
+    constexpr uint8_t planes_count = (uint8_t)FrustumPlane::MaxEnumValue;
+    const __m128 sign_mask = _mm_set1_ps(-0.0F);
+
+    __m128 plane_x[planes_count];
+    __m128 plane_y[planes_count];
+    __m128 plane_z[planes_count];
+    __m128 plane_w[planes_count];
+    for (uint8_t plane = 0; plane < planes_count; ++plane)
+    {
+        plane_x[plane] = _mm_set1_ps(frustum.planes[plane].x);
+        plane_y[plane] = _mm_set1_ps(frustum.planes[plane].y);
+        plane_z[plane] = _mm_set1_ps(frustum.planes[plane].z);
+        plane_w[plane] = _mm_set1_ps(frustum.planes[plane].w);
+    }
+
+    for (; index + BatchSize <= end_index; index += BatchSize)
+    {
+        for (uint32_t group = 0; group < BatchSize; group += 4)
+        {
+            const AABB3* box = boxes + index + group;
+
+            const __m128 min_x = _mm_setr_ps(box[0].min_bound.x, box[1].min_bound.x, box[2].min_bound.x, box[3].min_bound.x);
+            const __m128 min_y = _mm_setr_ps(box[0].min_bound.y, box[1].min_bound.y, box[2].min_bound.y, box[3].min_bound.y);
+            const __m128 min_z = _mm_setr_ps(box[0].min_bound.z, box[1].min_bound.z, box[2].min_bound.z, box[3].min_bound.z);
+            const __m128 max_x = _mm_setr_ps(box[0].max_bound.x, box[1].max_bound.x, box[2].max_bound.x, box[3].max_bound.x);
+            const __m128 max_y = _mm_setr_ps(box[0].max_bound.y, box[1].max_bound.y, box[2].max_bound.y, box[3].max_bound.y);
+            const __m128 max_z = _mm_setr_ps(box[0].max_bound.z, box[1].max_bound.z, box[2].max_bound.z, box[3].max_bound.z);
+
+            const __m128 half = _mm_set1_ps(0.5F);
+            const __m128 center_x = _mm_mul_ps(_mm_add_ps(min_x, max_x), half);
+            const __m128 center_y = _mm_mul_ps(_mm_add_ps(min_y, max_y), half);
+            const __m128 center_z = _mm_mul_ps(_mm_add_ps(min_z, max_z), half);
+            const __m128 extent_x = _mm_mul_ps(_mm_sub_ps(max_x, min_x), half);
+            const __m128 extent_y = _mm_mul_ps(_mm_sub_ps(max_y, min_y), half);
+            const __m128 extent_z = _mm_mul_ps(_mm_sub_ps(max_z, min_z), half);
+
+            // A box is outside if it is completely behind any plane: 'distance + radius < 0'.
+            __m128 outside = _mm_setzero_ps();
+            for (uint8_t plane = 0; plane < planes_count; ++plane)
+            {
+                __m128 distance = _mm_add_ps(_mm_mul_ps(plane_x[plane], center_x), plane_w[plane]);
+                distance = _mm_add_ps(distance, _mm_mul_ps(plane_y[plane], center_y));
+                distance = _mm_add_ps(distance, _mm_mul_ps(plane_z[plane], center_z));
+
+                __m128 radius = _mm_mul_ps(_mm_andnot_ps(sign_mask, plane_x[plane]), extent_x);
+                radius = _mm_add_ps(radius, _mm_mul_ps(_mm_andnot_ps(sign_mask, plane_y[plane]), extent_y));
+                radius = _mm_add_ps(radius, _mm_mul_ps(_mm_andnot_ps(sign_mask, plane_z[plane]), extent_z));
+
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+            }
+
+            const uint32_t visible_mask = ~(uint32_t)_mm_movemask_ps(outside) & 0xF;
+            for (uint32_t lane = 0; lane < 4; ++lane)
+            {
+                out_indices[visible_count] = index + group + lane;
+                visible_count += (visible_mask >> lane) & 1;
+            }
+        }
+    }
+#endif // HC_SIMD_SSE
+
+    // The remaining boxes, or all of them when SIMD isn't available.
+    for (; index < end_index; ++index)
+    {
+        out_indices[visible_count] = index;
+        visible_count += frustum.intersects_aabb(boxes[index]) ? 1 : 0;
+    }
+
+    return visible_count;
+}
+
+} // namespace HC
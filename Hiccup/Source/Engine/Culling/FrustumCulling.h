@@ -0,0 +1,48 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/Core.h"
+#include "Core/Math/Frustum.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Frustum Culling.
+ *----------------------------------------------------------------
+ * Tests bounding boxes against a frustum, producing the compact list of the visible indices,
+ *   so the render submission only iterates what is actually visible.
+ * The boxes are processed in batches of 8, as two groups of 4 SSE lanes. Each lane tests one
+ *   box against all the planes, and the results are written into the output list without branches.
+ */
+class FrustumCulling
+{
+public:
+    static constexpr uint32_t BatchSize = 8;
+
+    // The minimum number of boxes that makes splitting the work across the job system worth it.
+    static constexpr uint32_t ParallelThreshold = 16 * 1024;
+
+public:
+    /**
+     * Culls the boxes against the frustum.
+     *
+     * @param frustum The frustum to test against.
+     * @param boxes The bounding boxes, in the same space as the frustum.
+     * @param out_visible_indices Overwritten with the indices of the visible boxes, in increasing order.
+     *
+     * @return The number of visible boxes.
+     */
+    HC_API static uint32_t cull_boxes(const Frustum& frustum, Span<const AABB3> boxes, Array<uint32_t>& out_visible_indices);
+
+    /** Same as 'cull_boxes', but large inputs are split across the job system workers. */
+    HC_API static uint32_t parallel_cull_boxes(const Frustum& frustum, Span<const AABB3> boxes, Array<uint32_t>& out_visible_indices);
+
+private:
+    // Culls the boxes in the given range, writing the visible indices starting at 'out_indices'.
+    static uint32_t cull_range(const Frustum& frustum, const AABB3* boxes, uint32_t begin_index, uint32_t end_index, uint32_t* out_indices);
+};
+
+} // namespace HC
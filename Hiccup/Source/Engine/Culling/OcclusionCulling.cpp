@@ -0,0 +1,300 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "OcclusionCulling.h"
+
+#if HC_SIMD_SSE
+    #include <immintrin.h>
+#endif // HC_SIMD_SSE
+
+namespace HC
+{
+
+static_internal Vector4 transform_to_clip_space(const Matrix4& matrix, const Vector3& point)
+{
+    const auto& m = matrix.m;
+    return Vector4
+    (
+        point.x * m[0][0] + point.y * m[1][0] + point.z * m[2][0] + m[3][0],
+        point.x * m[0][1] + point.y * m[1][1] + point.z * m[2][1] + m[3][1],
+        point.x * m[0][2] + point.y * m[1][2] + point.z * m[2][2] + m[3][2],
+        point.x * m[0][3] + point.y * m[1][3] + point.z * m[2][3] + m[3][3]
+    );
+}
+
+OcclusionCuller::OcclusionCuller(const OcclusionCullerDescription& description)
+    : m_width(((description.width + TileSize - 1) / TileSize) * TileSize)
+    , m_height(((description.height + TileSize - 1) / TileSize) * TileSize)
+{
+    HC_ASSERT(m_width > 0 && m_height > 0); // Invalid depth buffer resolution!
+
+    m_tiles_x = m_width / TileSize;
+    m_tiles_y = m_height / TileSize;
+
+    m_depth_buffer = (float32_t*)Memory::allocate_tagged_i(m_width * m_height * sizeof(float32_t));
+    m_tile_depths = (float32_t*)Memory::allocate_tagged_i(m_tiles_x * m_tiles_y * sizeof(float32_t));
+
+    // Until the first frame, nothing is occluded.
+    for (uint32_t index = 0; index < m_tiles_x * m_tiles_y; ++index)
+    {
+        m_tile_depths[index] = 1.0F;
+    }
+
+    m_view_projection = Matrix4::identity();
+}
+
+OcclusionCuller::~OcclusionCuller()
+{
+    Memory::free(m_depth_buffer);
+    Memory::free(m_tile_depths);
+}
+
+void OcclusionCuller::begin_frame(const Matrix4& view_projection)
+{
+    HC_PROFILE_FUNCTION();
+
+    m_view_projection = view_projection;
+
+    for (uint32_t index = 0; index < m_width * m_height; ++index)
+    {
+        m_depth_buffer[index] = 1.0F;
+    }
+}
+
+void OcclusionCuller::render_occluder(Span<const Vector3> vertices, Span<const uint32_t> indices, const Matrix4& world)
+{
+    HC_PROFILE_FUNCTION();
+    HC_ASSERT(indices.count() % 3 == 0); // The indices must form a triangle list!
+
+    const Matrix4 world_view_projection = world * m_view_projection;
+
+    for (size_t index = 0; index + 2 < indices.count(); index += 3)
+    {
+        Vector3 screen_vertices[3];
+        bool is_behind_camera = false;
+
+        for (uint8_t corner = 0; corner < 3; ++corner)
+        {
+            HC_DASSERT(indices.elements()[index + corner] < vertices.count());
+            const Vector4 clip = transform_to_clip_space(world_view_projection, vertices.elements()[indices.elements()[index + corner]]);
+            if (clip.w < MinClipW)
+            {
+                is_behind_camera = true;
+                break;
+            }
+
+            const float32_t inverse_w = 1.0F / clip.w;
+            screen_vertices[corner].x = (clip.x * inverse_w * 0.5F + 0.5F) * (float32_t)m_width;
+            screen_vertices[corner].y = (0.5F - clip.y * inverse_w * 0.5F) * (float32_t)m_height;
+            screen_vertices[corner].z = clip.z * inverse_w;
+        }
+
+        if (!is_behind_camera)
+        {
+            rasterize_triangle(screen_vertices[0], screen_vertices[1], screen_vertices[2]);
+        }
+    }
+}
+
+void OcclusionCuller::end_occluders()
+{
+    HC_PROFILE_FUNCTION();
+
+    for (uint32_t tile_y = 0; tile_y < m_tiles_y; ++tile_y)
+    {
+        for (uint32_t tile_x = 0; tile_x < m_tiles_x; ++tile_x)
+        {
+            float32_t farthest_depth = 0.0F;
+            for (uint32_t y = tile_y * TileSize; y < (tile_y + 1) * TileSize; ++y)
+            {
+                const float32_t* row = m_depth_buffer + y * m_width + tile_x * TileSize;
+                for (uint32_t x = 0; x < TileSize; ++x)
+                {
+                    farthest_depth = Math::max(farthest_depth, row[x]);
+                }
+            }
+            m_tile_depths[tile_y * m_tiles_x + tile_x] = farthest_depth;
+        }
+    }
+}
+
+bool OcclusionCuller::is_visible(const AABB3& aabb) const
+{
+    float32_t min_x = (float32_t)m_width;
+    float32_t min_y = (float32_t)m_height;
+    float32_t max_x = 0.0F;
+    float32_t max_y = 0.0F;
+    float32_t nearest_depth = 1.0F;
+
+    for (uint8_t corner = 0; corner < 8; ++corner)
+    {
+        const Vector3 point = Vector3
+        (
+            (corner & 1) ? aabb.max_bound.x : aabb.min_bound.x,
+            (corner & 2) ? aabb.max_bound.y : aabb.min_bound.y,
+            (corner & 4) ? aabb.max_bound.z : aabb.min_bound.z
+        );
+
+        const Vector4 clip = transform_to_clip_space(m_view_projection, point);
+        if (clip.w < MinClipW)
+        {
+            // The box crosses the camera plane.
+            return true;
+        }
+
+        const float32_t inverse_w = 1.0F / clip.w;
+        const float32_t x = (clip.x * inverse_w * 0.5F + 0.5F) * (float32_t)m_width;
+        const float32_t y = (0.5F - clip.y * inverse_w * 0.5F) * (float32_t)m_height;
+
+        min_x = Math::min(min_x, x);
+        min_y = Math::min(min_y, y);
+        max_x = Math::max(max_x, x);
+        max_y = Math::max(max_y, y);
+        nearest_depth = Math::min(nearest_depth, clip.z * inverse_w);
+    }
+
+    if (nearest_depth <= 0.0F)
+    {
+        return true;
+    }
+
+    if (max_x < 0.0F || max_y < 0.0F || min_x >= (float32_t)m_width || min_y >= (float32_t)m_height)
+    {
+        // Outside of the viewport.
+        return false;
+    }
+
+    const uint32_t tile_x_begin = (uint32_t)Math::max(min_x, 0.0F) / TileSize;
+    const uint32_t tile_y_begin = (uint32_t)Math::max(min_y, 0.0F) / TileSize;
+    const uint32_t tile_x_end = Math::min((uint32_t)max_x / TileSize, m_tiles_x - 1);
+    const uint32_t tile_y_end = Math::min((uint32_t)max_y / TileSize, m_tiles_y - 1);
+
+    for (uint32_t tile_y = tile_y_begin; tile_y <= tile_y_end; ++tile_y)
+    {
+        for (uint32_t tile_x = tile_x_begin; tile_x <= tile_x_end; ++tile_x)
+        {
+            if (nearest_depth <= m_tile_depths[tile_y * m_tiles_x + tile_x])
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+uint32_t OcclusionCuller::cull_boxes(Span<const AABB3> boxes, Span<const uint32_t> indices, Array<uint32_t>& out_visible_indices) const
+{
+    HC_PROFILE_FUNCTION();
+
+    out_visible_indices.set_size_uninitialized(indices.count());
+
+    uint32_t visible_count = 0;
+    for (size_t index = 0; index < indices.count(); ++index)
+    {
+        HC_DASSERT(indices.elements()[index] < boxes.count());
+        out_visible_indices[visible_count] = indices.elements()[index];
+        visible_count += is_visible(boxes.elements()[indices.elements()[index]]) ? 1 : 0;
+    }
+
+    out_visible_indices.set_size_uninitialized(visible_count);
+    return visible_count;
+}
+
+void OcclusionCuller::rasterize_triangle(const Vector3& a, const Vector3& b, const Vector3& c)
+{
+    // Twice the signed area. Both faces are rasterized, so the winding is normalized.
+    float32_t area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (area == 0.0F)
+    {
+        return;
+    }
+
+    const Vector3& v0 = a;
+    const Vector3& v1 = (area > 0.0F) ? b : c;
+    const Vector3& v2 = (area > 0.0F) ? c : b;
+    area = Math::abs(area);
+
+    const float32_t min_x = Math::max(Math::min(v0.x, Math::min(v1.x, v2.x)), 0.0F);
+    const float32_t min_y = Math::max(Math::min(v0.y, Math::min(v1.y, v2.y)), 0.0F);
+    const float32_t max_x = Math::min(Math::max(v0.x, Math::max(v1.x, v2.x)), (float32_t)m_width - 1.0F);
+    const float32_t max_y = Math::min(Math::max(v0.y, Math::max(v1.y, v2.y)), (float32_t)m_height - 1.0F);
+    if (min_x > max_x || min_y > max_y)
+    {
+        return;
+    }
+
+    // Edge functions, in the form 'e(x, y) = edge_a * x + edge_b * y + edge_c'. Inside the triangle, all are non-negative.
+    const float32_t edge_a[3] = { v0.y - v1.y, v1.y - v2.y, v2.y - v0.y };
+    const float32_t edge_b[3] = { v1.x - v0.x, v2.x - v1.x, v0.x - v2.x };
+    const float32_t edge_c[3] =
+    {
+        -edge_a[0] * v0.x - edge_b[0] * v0.y,
+        -edge_a[1] * v1.x - edge_b[1] * v1.y,
+        -edge_a[2] * v2.x - edge_b[2] * v2.y,
+    };
+
+    // The depth is linear in screen space.
+    const float32_t depth_dx = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+    const float32_t depth_dy = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) / area;
+    const float32_t depth_c = v0.z - depth_dx * v0.x - depth_dy * v0.y;
+
+    // The rows are processed in groups of 4 pixels, starting at a multiple of 4. The width is a multiple of 4.
+    const uint32_t begin_x = (uint32_t)min_x & ~3U;
+    const uint32_t end_x = (uint32_t)max_x;
+    const uint32_t begin_y = (uint32_t)min_y;
+    const uint32_t end_y = (uint32_t)max_y;
+
+    for (uint32_t y = begin_y; y <= end_y; ++y)
+    {
+        const float32_t pixel_y = (float32_t)y + 0.5F;
+        float32_t* row = m_depth_buffer + y * m_width;
+
+#if HC_SIMD_SSE
+        const __m128 lane_offsets = _mm_setr_ps(0.5F, 1.5F, 2.5F, 3.5F);
+        const __m128 zero = _mm_setzero_ps();
+
+        const __m128 row_edge_0 = _mm_set1_ps(edge_b[0] * pixel_y + edge_c[0]);
+        const __m128 row_edge_1 = _mm_set1_ps(edge_b[1] * pixel_y + edge_c[1]);
+        const __m128 row_edge_2 = _mm_set1_ps(edge_b[2] * pixel_y + edge_c[2]);
+        const __m128 row_depth = _mm_set1_ps(depth_dy * pixel_y + depth_c);
+
+        for (uint32_t x = begin_x; x <= end_x; x += 4)
+        {
+            const __m128 pixel_x = _mm_add_ps(_mm_set1_ps((float32_t)x), lane_offsets);
+
+            const __m128 edge_0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge_a[0]), pixel_x), row_edge_0);
+            const __m128 edge_1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge_a[1]), pixel_x), row_edge_1);
+            const __m128 edge_2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge_a[2]), pixel_x), row_edge_2);
+
+            const __m128 inside = _mm_and_ps(_mm_cmpge_ps(edge_0, zero), _mm_and_ps(_mm_cmpge_ps(edge_1, zero), _mm_cmpge_ps(edge_2, zero)));
+            if (_mm_movemask_ps(inside) == 0)
+            {
+                continue;
+            }
+
+            const __m128 depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depth_dx), pixel_x), row_depth);
+            const __m128 old_depth = _mm_loadu_ps(row + x);
+            const __m128 new_depth = _mm_min_ps(old_depth, depth);
+
+            // Selecting the new depth only for the covered pixels.
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, new_depth), _mm_andnot_ps(inside, old_depth)));
+        }
+#else
+        for (uint32_t x = begin_x; x <= end_x; ++x)
+        {
+            const float32_t pixel_x = (float32_t)x + 0.5F;
+            if (edge_a[0] * pixel_x + edge_b[0] * pixel_y + edge_c[0] < 0.0F ||
+                edge_a[1] * pixel_x + edge_b[1] * pixel_y + edge_c[1] < 0.0F ||
+                edge_a[2] * pixel_x + edge_b[2] * pixel_y + edge_c[2] < 0.0F)
+            {
+                continue;
+            }
+
+            const float32_t depth = depth_dx * pixel_x + depth_dy * pixel_y + depth_c;
+            row[x] = Math::min(row[x], depth);
+        }
+#endif // HC_SIMD_SSE
+    }
+}
+
+} // namespace HC
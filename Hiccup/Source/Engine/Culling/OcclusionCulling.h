@@ -0,0 +1,105 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/Core.h"
+
+namespace HC
+{
+
+struct OcclusionCullerDescription
+{
+    // The resolution of the software depth buffer. Rounded up to a multiple of the tile size.
+    uint32_t width = 320;
+    uint32_t height = 192;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Occlusion Culler.
+ *----------------------------------------------------------------
+ * A software occlusion culler, that runs entirely on the CPU.
+ * A few large occluders are rasterized into a low resolution depth buffer, which is then reduced
+ *   to the farthest depth of each tile. A box is occluded if its nearest depth is behind the
+ *   farthest depth of every tile it covers.
+ *
+ * Usage, each frame:
+ *   culler.begin_frame(view_projection);
+ *   culler.render_occluder(...);   (for each occluder)
+ *   culler.end_occluders();
+ *   culler.cull_boxes(...);        (typically on the output of the frustum culling)
+ *
+ * The depth convention is the one of the projection matrix: [0, 1], with 0 being the near plane.
+ */
+class OcclusionCuller
+{
+public:
+    HC_NON_COPIABLE(OcclusionCuller)
+    HC_NON_MOVABLE(OcclusionCuller)
+
+    static constexpr uint32_t TileSize = 8;
+
+    // Vertices with a clip-space W smaller than this are considered behind the camera.
+    static constexpr float32_t MinClipW = 0.0001F;
+
+public:
+    HC_API OcclusionCuller(const OcclusionCullerDescription& description = {});
+    HC_API ~OcclusionCuller();
+
+public:
+    /** Clears the depth buffer. */
+    HC_API void begin_frame(const Matrix4& view_projection);
+
+    /**
+     * Rasterizes an indexed triangle mesh into the depth buffer. Both faces of the triangles are rasterized.
+     * Triangles that cross the near plane are skipped, which is conservative.
+     *
+     * @param vertices The vertex positions, in object space.
+     * @param indices The triangle list indices.
+     * @param world The object to world matrix.
+     */
+    HC_API void render_occluder(Span<const Vector3> vertices, Span<const uint32_t> indices, const Matrix4& world);
+
+    /** Builds the tile depths. Must be called after the last occluder, before testing. */
+    HC_API void end_occluders();
+
+    /** @return True if the box might be visible. */
+    HC_API bool is_visible(const AABB3& aabb) const;
+
+    /**
+     * Filters a list of box indices, keeping only the ones that might be visible.
+     *
+     * @param boxes The bounding boxes, in world space.
+     * @param indices The indices of the boxes to test. Usually the output of the frustum culling.
+     * @param out_visible_indices Overwritten with the indices that passed the test.
+     *
+     * @return The number of visible boxes.
+     */
+    HC_API uint32_t cull_boxes(Span<const AABB3> boxes, Span<const uint32_t> indices, Array<uint32_t>& out_visible_indices) const;
+
+public:
+    ALWAYS_INLINE uint32_t get_width() const { return m_width; }
+    ALWAYS_INLINE uint32_t get_height() const { return m_height; }
+
+    /** Useful for debug visualization. */
+    ALWAYS_INLINE const float32_t* get_depth_buffer() const { return m_depth_buffer; }
+
+private:
+    // The vertices are in screen space: X and Y are pixel coordinates, Z is the depth.
+    void rasterize_triangle(const Vector3& a, const Vector3& b, const Vector3& c);
+
+private:
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_tiles_x;
+    uint32_t m_tiles_y;
+
+    float32_t* m_depth_buffer;
+
+    // The farthest depth of each tile.
+    float32_t* m_tile_depths;
+
+    Matrix4 m_view_projection;
+};
+
+} // namespace HC
@@ -0,0 +1,125 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/Core.h"
+#include "Entity.h"
+
+namespace HC
+{
+
+class Archetype;
+
+/**
+ * The header of a chunk, stored at the beginning of its memory block.
+ * After the header, the chunk stores the entities array, followed by one array for each
+ *   component type of the archetype (structure of arrays).
+ */
+struct Chunk
+{
+    Archetype* archetype;
+    uint32_t count;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Chunk Pool.
+ *----------------------------------------------------------------
+ * Allocates fixed-size chunks from large slabs, and recycles them through a free list.
+ */
+class ChunkPool
+{
+public:
+    HC_NON_COPIABLE(ChunkPool)
+    HC_NON_MOVABLE(ChunkPool)
+
+    static constexpr size_t ChunkSize = 16 * 1024;
+    static constexpr size_t ChunksPerSlab = 16;
+
+public:
+    ChunkPool()
+        : m_free_list(nullptr)
+    {}
+
+    HC_API ~ChunkPool();
+
+public:
+    HC_API Chunk* allocate();
+    HC_API void release(Chunk* chunk);
+
+private:
+    Array<void*> m_slabs;
+
+    // Each free chunk stores the pointer to the next free chunk in its first bytes.
+    void* m_free_list;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Archetype.
+ *----------------------------------------------------------------
+ * Stores all entities that have exactly the same set of components.
+ * The chunks are always densely packed - only the last chunk can be partially filled.
+ */
+class Archetype
+{
+public:
+    HC_NON_COPIABLE(Archetype)
+    HC_NON_MOVABLE(Archetype)
+
+    static constexpr uint8_t InvalidColumn = 0xFF;
+
+public:
+    HC_API Archetype(const ComponentMask& mask);
+
+public:
+    ALWAYS_INLINE const ComponentMask& get_mask() const { return m_mask; }
+
+    ALWAYS_INLINE uint32_t get_chunk_capacity() const { return m_chunk_capacity; }
+    ALWAYS_INLINE uint32_t get_entities_count() const { return m_entities_count; }
+
+    ALWAYS_INLINE const Array<Chunk*>& get_chunks() const { return m_chunks; }
+
+    ALWAYS_INLINE Entity* get_entities(Chunk* chunk) const
+    {
+        return (Entity*)((uint8_t*)chunk + m_entities_offset);
+    }
+
+    /** @return The component array of the chunk, or nullptr if the archetype doesn't have the component. */
+    ALWAYS_INLINE void* get_components(Chunk* chunk, ComponentTypeID id) const
+    {
+        const uint8_t column = m_columns[id];
+        return (column != InvalidColumn) ? (uint8_t*)chunk + m_component_offsets[column] : nullptr;
+    }
+
+    ALWAYS_INLINE void* get_component(Chunk* chunk, uint32_t row, ComponentTypeID id) const
+    {
+        const uint8_t column = m_columns[id];
+        return (column != InvalidColumn) ? (uint8_t*)chunk + m_component_offsets[column] + row * m_component_sizes[column] : nullptr;
+    }
+
+private:
+    ComponentMask m_mask;
+
+    // The components of the archetype, sorted by id. Indexed by column.
+    Array<ComponentTypeID> m_component_ids;
+    Array<uint32_t> m_component_offsets;
+    Array<uint32_t> m_component_sizes;
+
+    // Maps the component ids to the column of the component, or 'InvalidColumn'.
+    uint8_t m_columns[MaxComponentTypesCount];
+
+    uint32_t m_entities_offset;
+    uint32_t m_chunk_capacity;
+
+    Array<Chunk*> m_chunks;
+    uint32_t m_entities_count;
+
+    // Cached archetype graph edges: the archetype reached by adding/removing a component.
+    Archetype* m_add_edges[MaxComponentTypesCount];
+    Archetype* m_remove_edges[MaxComponentTypesCount];
+
+    friend class World;
+};
+
+} // namespace HC
@@ -0,0 +1,94 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/Core.h"
+#include "Entity.h"
+
+namespace HC
+{
+
+// Entities created through a command buffer have this generation until the buffer is applied.
+static constexpr uint32_t PendingEntityGeneration = 0xFFFFFFFF;
+
+enum class EntityCommandType : uint8_t
+{
+    CreateEntity = 0,
+    DestroyEntity = 1,
+    AddComponent = 2,
+    RemoveComponent = 3,
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Command Buffer.
+ *----------------------------------------------------------------
+ * Records structural changes (creating/destroying entities, adding/removing components),
+ *   so they can be applied later, at a sync point, by 'World::apply'.
+ * Structural changes invalidate the chunks being iterated, so systems must record them
+ *   instead of applying them directly. Recording is thread-safe, so a single buffer can be
+ *   shared by all the jobs of a parallel system.
+ */
+class CommandBuffer
+{
+public:
+    HC_NON_COPIABLE(CommandBuffer)
+    HC_NON_MOVABLE(CommandBuffer)
+
+    CommandBuffer()
+        : m_pending_entities_count(0)
+    {}
+
+public:
+    /**
+     * Records the creation of an entity.
+     *
+     * @return A pending entity, that can only be used with this command buffer until it is applied.
+     */
+    HC_API Entity create_entity();
+
+    HC_API void destroy_entity(Entity entity);
+
+    template<typename T>
+    ALWAYS_INLINE void add_component(Entity entity, const T& component)
+    {
+        add_component_raw(entity, get_component_type_id<T>(), &component, sizeof(T));
+    }
+
+    template<typename T>
+    ALWAYS_INLINE void remove_component(Entity entity)
+    {
+        remove_component_raw(entity, get_component_type_id<T>());
+    }
+
+    HC_API void add_component_raw(Entity entity, ComponentTypeID id, const void* component, size_t component_size);
+    HC_API void remove_component_raw(Entity entity, ComponentTypeID id);
+
+public:
+    ALWAYS_INLINE bool is_empty() const { return m_commands.is_empty(); }
+
+    HC_API void clear();
+
+private:
+    struct CommandHeader
+    {
+        EntityCommandType type;
+        ComponentTypeID component;
+        Entity entity;
+        uint32_t payload_size;
+    };
+
+    void record(const CommandHeader& header, const void* payload);
+
+private:
+    Mutex m_lock;
+
+    // The commands, stored back to back. Each command is a header, followed by its payload.
+    Array<uint8_t> m_commands;
+
+    uint32_t m_pending_entities_count;
+
+    friend class World;
+};
+
+} // namespace HC
@@ -0,0 +1,107 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/Core.h"
+
+namespace HC
+{
+
+/**
+ * A handle to an entity. The generation is incremented each time the index is reused,
+ *   so handles to destroyed entities can be detected.
+ */
+struct Entity
+{
+    uint32_t index;
+    uint32_t generation;
+
+    ALWAYS_INLINE bool operator==(const Entity& other) const { return (index == other.index) && (generation == other.generation); }
+    ALWAYS_INLINE bool operator!=(const Entity& other) const { return !(*this == other); }
+};
+
+static constexpr Entity InvalidEntity = { 0xFFFFFFFF, 0 };
+
+using ComponentTypeID = uint32_t;
+
+static constexpr uint32_t MaxComponentTypesCount = 128;
+
+/**
+ * A set of component types. Each archetype is identified by the mask of its components.
+ */
+struct ComponentMask : public FixedBitArray<MaxComponentTypesCount>
+{
+    ALWAYS_INLINE uint64_t compute_hash() const
+    {
+        uint64_t hash = 0;
+        for (size_t index = 0; index < WordsCount; ++index)
+        {
+            hash = (hash ^ words()[index]) * 0x9E3779B97F4A7C15;
+        }
+        return hash;
+    }
+};
+
+struct ComponentInfo
+{
+    TypeID type_id;
+    size_t size;
+    size_t alignment;
+
+    // Only available if the component type is reflected. Null otherwise.
+    const char* name;
+    PFN_GetFields get_fields;
+
+    template<typename T>
+    static ComponentInfo of()
+    {
+        // Bound to a constexpr variable, so the type name is never hashed at runtime (not even in debug builds).
+        constexpr TypeID type_id = Reflection::get_type_id<T>();
+
+        ComponentInfo info = {};
+        info.type_id = type_id;
+        info.size = sizeof(T);
+        info.alignment = alignof(T);
+        if constexpr (Reflection::is_reflected<T>())
+        {
+            info.name = Reflection::get_type_name<T>();
+            info.get_fields = &Reflection::get_fields<T>;
+        }
+        return info;
+    }
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Component Registry.
+ *----------------------------------------------------------------
+ * Assigns an id to each component type. Components are plain data: they are moved
+ *   between chunks with 'Memory::copy', and their constructors/destructors are never called.
+ * Types are identified by their compile-time 'TypeID', so the ids match across module boundaries.
+ * Reflected component types also expose their name and fields, for serialization and inspection.
+ */
+class ComponentRegistry
+{
+public:
+    // The maximum alignment a component can require. Chunks are allocated with this alignment.
+    static constexpr size_t MaxComponentAlignment = 16;
+
+public:
+    HC_API static ComponentTypeID register_component(const ComponentInfo& info);
+
+    HC_API static const ComponentInfo& get_info(ComponentTypeID id);
+
+    /** Finds the id of an already registered component type. @return False if the type isn't registered. */
+    HC_API static bool find_component(TypeID type_id, ComponentTypeID& out_id);
+
+    HC_API static uint32_t get_components_count();
+};
+
+template<typename T>
+ALWAYS_INLINE ComponentTypeID get_component_type_id()
+{
+    static const ComponentTypeID id = ComponentRegistry::register_component(ComponentInfo::of<T>());
+    return id;
+}
+
+} // namespace HC
@@ -0,0 +1,192 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/Core.h"
+#include "World.h"
+
+namespace HC
+{
+
+/**
+ * A chunk matched by a query. Provides direct access to the component arrays.
+ */
+class ChunkView
+{
+public:
+    ChunkView()
+        : m_archetype(nullptr)
+        , m_chunk(nullptr)
+    {}
+
+    ChunkView(Archetype* archetype, Chunk* chunk)
+        : m_archetype(archetype)
+        , m_chunk(chunk)
+    {}
+
+public:
+    ALWAYS_INLINE uint32_t get_count() const { return m_chunk->count; }
+
+    ALWAYS_INLINE const Entity* get_entities() const { return m_archetype->get_entities(m_chunk); }
+
+    /** @return The component array, or nullptr if the chunk doesn't store the component. */
+    template<typename T>
+    ALWAYS_INLINE T* get_components() const
+    {
+        return (T*)m_archetype->get_components(m_chunk, get_component_type_id<T>());
+    }
+
+private:
+    Archetype* m_archetype;
+    Chunk* m_chunk;
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Query.
+ *----------------------------------------------------------------
+ * Matches the archetypes that have all the required components, and none of the excluded ones.
+ * The matching archetypes are cached: each iteration only checks the archetypes that were
+ *   created since the previous one. Iterating walks the matching chunks linearly.
+ * Usage:
+ *   Query query = Query(world).with<Position, Velocity>();
+ *   query.for_each<Position, Velocity>([](Entity entity, Position& position, Velocity& velocity) { ... });
+ */
+class Query
+{
+public:
+    explicit Query(World& world)
+        : m_world(&world)
+        , m_checked_archetypes_count(0)
+    {}
+
+public:
+    template<typename... Components>
+    ALWAYS_INLINE Query& with()
+    {
+        (m_required.set(get_component_type_id<Components>()), ...);
+        invalidate_cache();
+        return *this;
+    }
+
+    template<typename... Components>
+    ALWAYS_INLINE Query& without()
+    {
+        (m_excluded.set(get_component_type_id<Components>()), ...);
+        invalidate_cache();
+        return *this;
+    }
+
+    /** Checks the archetypes created since the last update. Called automatically before each iteration. */
+    HC_API void update_cache();
+
+    HC_API uint32_t count_entities();
+
+public:
+    /** Invokes the function for each matching chunk, with a 'ChunkView'. */
+    template<typename Function>
+    void for_each_chunk(const Function& function)
+    {
+        update_cache();
+
+        m_world->begin_iteration();
+        for (size_t archetype_index = 0; archetype_index < m_matching_archetypes.size(); ++archetype_index)
+        {
+            Archetype* archetype = m_matching_archetypes[archetype_index];
+            const Array<Chunk*>& chunks = archetype->get_chunks();
+            for (size_t chunk_index = 0; chunk_index < chunks.size(); ++chunk_index)
+            {
+                function(ChunkView(archetype, chunks[chunk_index]));
+            }
+        }
+        m_world->end_iteration();
+    }
+
+    /**
+     * Invokes the function for each matching entity, with references to the requested components.
+     * All requested components must be required by the query.
+     */
+    template<typename... Components, typename Function>
+    void for_each(const Function& function)
+    {
+        HC_DASSERT((m_required.test(get_component_type_id<Components>()) && ...)); // A requested component is not required by the query!
+
+        for_each_chunk([&function](const ChunkView& view)
+        {
+            iterate_rows(view, function, view.get_components<Components>()...);
+        });
+    }
+
+    /**
+     * Same as 'for_each_chunk', but the chunks are distributed across the job system workers.
+     * The function must only touch the chunk it receives, and record structural changes in a command buffer.
+     */
+    template<typename Function>
+    void parallel_for_each_chunk(const Function& function, JobPriority priority = JobPriority::Normal)
+    {
+        update_cache();
+
+        m_chunk_views.clear();
+        for (size_t archetype_index = 0; archetype_index < m_matching_archetypes.size(); ++archetype_index)
+        {
+            Archetype* archetype = m_matching_archetypes[archetype_index];
+            const Array<Chunk*>& chunks = archetype->get_chunks();
+            for (size_t chunk_index = 0; chunk_index < chunks.size(); ++chunk_index)
+            {
+                m_chunk_views.add(ChunkView(archetype, chunks[chunk_index]));
+            }
+        }
+
+        m_world->begin_iteration();
+        JobSystem::parallel_for(m_chunk_views.size(), 1, [this, &function](size_t begin_index, size_t end_index)
+        {
+            for (size_t index = begin_index; index < end_index; ++index)
+            {
+                function(m_chunk_views[index]);
+            }
+        }, priority);
+        m_world->end_iteration();
+    }
+
+    /** Same as 'for_each', but the chunks are distributed across the job system workers. */
+    template<typename... Components, typename Function>
+    void parallel_for_each(const Function& function, JobPriority priority = JobPriority::Normal)
+    {
+        parallel_for_each_chunk([&function](const ChunkView& view)
+        {
+            iterate_rows(view, function, view.get_components<Components>()...);
+        }, priority);
+    }
+
+private:
+    template<typename Function, typename... ComponentPointers>
+    ALWAYS_INLINE static void iterate_rows(const ChunkView& view, const Function& function, ComponentPointers... components)
+    {
+        const Entity* entities = view.get_entities();
+        const uint32_t count = view.get_count();
+        for (uint32_t row = 0; row < count; ++row)
+        {
+            function(entities[row], components[row]...);
+        }
+    }
+
+    ALWAYS_INLINE void invalidate_cache()
+    {
+        m_matching_archetypes.clear();
+        m_checked_archetypes_count = 0;
+    }
+
+private:
+    World* m_world;
+
+    ComponentMask m_required;
+    ComponentMask m_excluded;
+
+    Array<Archetype*> m_matching_archetypes;
+    size_t m_checked_archetypes_count;
+
+    // Scratch storage for the parallel iteration.
+    Array<ChunkView> m_chunk_views;
+};
+
+} // namespace HC
@@ -0,0 +1,618 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "World.h"
+#include "Query.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Component Registry.
+ *----------------------------------------------------------------
+ */
+
+struct ComponentRegistryData
+{
+    Mutex lock;
+
+    ComponentInfo infos[MaxComponentTypesCount];
+    uint32_t components_count = 0;
+
+    // Maps the type ids to the component ids. The registry lives until the static destruction, after the memory
+    //   system is shut down, so its table must not be tracked (or it would be reported as a leak).
+    HashTable<TypeID, ComponentTypeID, UntrackedAllocator> ids;
+};
+
+static_internal ComponentRegistryData& get_component_registry_data()
+{
+    // Constructed on first use, as components can be registered during static initialization.
+    static ComponentRegistryData s_data;
+    return s_data;
+}
+
+ComponentTypeID ComponentRegistry::register_component(const ComponentInfo& info)
+{
+    HC_ASSERT(info.alignment <= MaxComponentAlignment); // The component alignment is too big!
+
+    ComponentRegistryData& data = get_component_registry_data();
+    ScopedLock<Mutex> lock(data.lock);
+
+    const size_t index = data.ids.find(info.type_id);
+    if (index != data.ids.EndOfTable)
+    {
+        return data.ids.at_index(index);
+    }
+
+    HC_ASSERT(data.components_count < MaxComponentTypesCount); // Too many component types!
+
+    const ComponentTypeID id = data.components_count++;
+    data.infos[id] = info;
+    data.ids.insert(info.type_id, id);
+    return id;
+}
+
+const ComponentInfo& ComponentRegistry::get_info(ComponentTypeID id)
+{
+    ComponentRegistryData& data = get_component_registry_data();
+    HC_ASSERT(id < data.components_count); // Invalid component id!
+    return data.infos[id];
+}
+
+bool ComponentRegistry::find_component(TypeID type_id, ComponentTypeID& out_id)
+{
+    ComponentRegistryData& data = get_component_registry_data();
+    ScopedLock<Mutex> lock(data.lock);
+
+    const size_t index = data.ids.find(type_id);
+    if (index == data.ids.EndOfTable)
+    {
+        return false;
+    }
+
+    out_id = data.ids.at_index(index);
+    return true;
+}
+
+uint32_t ComponentRegistry::get_components_count()
+{
+    ComponentRegistryData& data = get_component_registry_data();
+    ScopedLock<Mutex> lock(data.lock);
+    return data.components_count;
+}
+
+/**
+ *----------------------------------------------------------------
+ * Chunk Pool.
+ *----------------------------------------------------------------
+ */
+
+ChunkPool::~ChunkPool()
+{
+    for (size_t index = 0; index < m_slabs.size(); ++index)
+    {
+        Memory::free(m_slabs[index]);
+    }
+}
+
+Chunk* ChunkPool::allocate()
+{
+    if (!m_free_list)
+    {
+        HC_MEMORY_TAG_SCOPE(ECS);
+        uint8_t* slab = (uint8_t*)Memory::allocate_tagged_i(ChunkSize * ChunksPerSlab);
+        m_slabs.add(slab);
+
+        for (size_t index = ChunksPerSlab; index > 0; --index)
+        {
+            void* chunk = slab + (index - 1) * ChunkSize;
+            *(void**)chunk = m_free_list;
+            m_free_list = chunk;
+        }
+    }
+
+    void* chunk = m_free_list;
+    m_free_list = *(void**)chunk;
+    return (Chunk*)chunk;
+}
+
+void ChunkPool::release(Chunk* chunk)
+{
+    *(void**)chunk = m_free_list;
+    m_free_list = chunk;
+}
+
+/**
+ *----------------------------------------------------------------
+ * Archetype.
+ *----------------------------------------------------------------
+ */
+
+static_internal uint32_t align_chunk_offset(uint32_t offset, size_t alignment)
+{
+    return (uint32_t)((offset + alignment - 1) & ~(alignment - 1));
+}
+
+Archetype::Archetype(const ComponentMask& mask)
+    : m_mask(mask)
+    , m_entities_count(0)
+{
+    Memory::set(m_columns, InvalidColumn, sizeof(m_columns));
+    Memory::zero(m_add_edges, sizeof(m_add_edges));
+    Memory::zero(m_remove_edges, sizeof(m_remove_edges));
+
+    size_t row_size = sizeof(Entity);
+    mask.for_each_set([&](size_t index)
+        {
+            const ComponentTypeID id = (ComponentTypeID)index;
+            m_columns[id] = (uint8_t)m_component_ids.size();
+            m_component_ids.add(id);
+            m_component_sizes.add((uint32_t)ComponentRegistry::get_info(id).size);
+            row_size += ComponentRegistry::get_info(id).size;
+        });
+    m_component_offsets.set_size_zeroed(m_component_ids.size());
+
+    // Starting from the capacity that ignores the alignment padding, and decreasing it until the layout fits.
+    uint32_t capacity = (uint32_t)((ChunkPool::ChunkSize - sizeof(Chunk)) / row_size);
+    while (capacity > 0)
+    {
+        uint32_t offset = align_chunk_offset(sizeof(Chunk), alignof(Entity));
+        m_entities_offset = offset;
+        offset += capacity * sizeof(Entity);
+
+        for (size_t column = 0; column < m_component_ids.size(); ++column)
+        {
+            offset = align_chunk_offset(offset, ComponentRegistry::get_info(m_component_ids[column]).alignment);
+            m_component_offsets[column] = offset;
+            offset += capacity * m_component_sizes[column];
+        }
+
+        if (offset <= ChunkPool::ChunkSize)
+        {
+            break;
+        }
+        --capacity;
+    }
+
+    HC_ASSERT(capacity > 0); // The components of the archetype don't fit in a chunk!
+    m_chunk_capacity = capacity;
+}
+
+/**
+ *----------------------------------------------------------------
+ * World.
+ *----------------------------------------------------------------
+ */
+
+World::World()
+    : m_entities_count(0)
+    , m_empty_archetype(nullptr)
+    , m_iterations_count(0)
+{
+    m_empty_archetype = get_or_create_archetype(ComponentMask());
+}
+
+World::~World()
+{
+    for (size_t archetype_index = 0; archetype_index < m_archetypes.size(); ++archetype_index)
+    {
+        Archetype* archetype = m_archetypes[archetype_index];
+        for (size_t chunk_index = 0; chunk_index < archetype->m_chunks.size(); ++chunk_index)
+        {
+            m_chunk_pool.release(archetype->m_chunks[chunk_index]);
+        }
+        hc_delete archetype;
+    }
+}
+
+Entity World::create_entity()
+{
+    HC_ASSERT(m_iterations_count == 0); // Structural changes are not allowed while iterating! Use a command buffer.
+
+    Entity entity;
+    if (!m_free_indices.is_empty())
+    {
+        entity.index = m_free_indices.back();
+        m_free_indices.pop();
+    }
+    else
+    {
+        entity.index = (uint32_t)m_records.add_zeroed();
+    }
+
+    EntityRecord& record = m_records[entity.index];
+    entity.generation = record.generation;
+
+    allocate_row(m_empty_archetype, entity, record);
+    ++m_entities_count;
+    return entity;
+}
+
+void World::destroy_entity(Entity entity)
+{
+    HC_ASSERT(m_iterations_count == 0); // Structural changes are not allowed while iterating! Use a command buffer.
+
+    if (!is_alive(entity))
+    {
+        return;
+    }
+
+    EntityRecord& record = m_records[entity.index];
+    remove_row(record.archetype, record.chunk, record.row);
+
+    record.archetype = nullptr;
+    record.chunk = nullptr;
+
+    // Skipping the generation reserved for the entities created by command buffers.
+    ++record.generation;
+    if (record.generation == PendingEntityGeneration)
+    {
+        record.generation = 0;
+    }
+
+    m_free_indices.add(entity.index);
+    --m_entities_count;
+}
+
+bool World::is_alive(Entity entity) const
+{
+    return entity.index < m_records.size() && m_records[entity.index].generation == entity.generation && m_records[entity.index].archetype != nullptr;
+}
+
+void* World::add_component_raw(Entity entity, ComponentTypeID id, const void* component)
+{
+    HC_ASSERT(m_iterations_count == 0); // Structural changes are not allowed while iterating! Use a command buffer.
+    HC_ASSERT(is_alive(entity)); // Invalid entity!
+
+    EntityRecord& record = m_records[entity.index];
+    Archetype* source = record.archetype;
+
+    if (!source->m_mask.test(id))
+    {
+        Archetype* destination = source->m_add_edges[id];
+        if (!destination)
+        {
+            ComponentMask mask = source->m_mask;
+            mask.set(id);
+            destination = get_or_create_archetype(mask);
+            source->m_add_edges[id] = destination;
+            destination->m_remove_edges[id] = source;
+        }
+
+        move_entity(entity, destination);
+    }
+
+    void* component_memory = record.archetype->get_component(record.chunk, record.row, id);
+    if (component)
+    {
+        Memory::copy(component_memory, component, ComponentRegistry::get_info(id).size);
+    }
+    else
+    {
+        Memory::zero(component_memory, ComponentRegistry::get_info(id).size);
+    }
+
+    return component_memory;
+}
+
+void World::remove_component_raw(Entity entity, ComponentTypeID id)
+{
+    HC_ASSERT(m_iterations_count == 0); // Structural changes are not allowed while iterating! Use a command buffer.
+    HC_ASSERT(is_alive(entity)); // Invalid entity!
+
+    Archetype* source = m_records[entity.index].archetype;
+    if (!source->m_mask.test(id))
+    {
+        return;
+    }
+
+    Archetype* destination = source->m_remove_edges[id];
+    if (!destination)
+    {
+        ComponentMask mask = source->m_mask;
+        mask.clear(id);
+        destination = get_or_create_archetype(mask);
+        source->m_remove_edges[id] = destination;
+        destination->m_add_edges[id] = source;
+    }
+
+    move_entity(entity, destination);
+}
+
+void* World::get_component_raw(Entity entity, ComponentTypeID id)
+{
+    if (!is_alive(entity))
+    {
+        return nullptr;
+    }
+
+    const EntityRecord& record = m_records[entity.index];
+    return record.archetype->get_component(record.chunk, record.row, id);
+}
+
+void World::apply(CommandBuffer& command_buffer)
+{
+    HC_PROFILE_FUNCTION();
+    HC_ASSERT(m_iterations_count == 0); // Command buffers can only be applied at sync points!
+
+    ScopedLock<Mutex> lock(command_buffer.m_lock);
+
+    // Maps the pending entities of the buffer to the entities that were actually created.
+    Array<Entity> created_entities;
+    created_entities.set_size_uninitialized(command_buffer.m_pending_entities_count);
+
+    const uint8_t* cursor = command_buffer.m_commands.data();
+    const uint8_t* end = cursor + command_buffer.m_commands.size();
+
+    while (cursor < end)
+    {
+        CommandBuffer::CommandHeader header;
+        Memory::copy(&header, cursor, sizeof(CommandBuffer::CommandHeader));
+        const uint8_t* payload = cursor + sizeof(CommandBuffer::CommandHeader);
+        cursor = payload + header.payload_size;
+
+        Entity entity = header.entity;
+        if (entity.generation == PendingEntityGeneration && header.type != EntityCommandType::CreateEntity)
+        {
+            entity = created_entities[entity.index];
+        }
+
+        switch (header.type)
+        {
+            case EntityCommandType::CreateEntity:
+            {
+                created_entities[header.entity.index] = create_entity();
+                break;
+            }
+
+            case EntityCommandType::DestroyEntity:
+            {
+                destroy_entity(entity);
+                break;
+            }
+
+            case EntityCommandType::AddComponent:
+            {
+                // The entity might have been destroyed by a previous command.
+                if (is_alive(entity))
+                {
+                    HC_ASSERT(header.payload_size == ComponentRegistry::get_info(header.component).size);
+                    add_component_raw(entity, header.component, payload);
+                }
+                break;
+            }
+
+            case EntityCommandType::RemoveComponent:
+            {
+                if (is_alive(entity))
+                {
+                    remove_component_raw(entity, header.component);
+                }
+                break;
+            }
+        }
+    }
+
+    command_buffer.m_commands.clear();
+    command_buffer.m_pending_entities_count = 0;
+}
+
+Archetype* World::get_or_create_archetype(const ComponentMask& mask)
+{
+    HC_MEMORY_TAG_SCOPE(ECS);
+    const uint64_t hash = mask.compute_hash();
+
+    const size_t index = m_archetype_lookup.find(hash);
+    if (index != m_archetype_lookup.EndOfTable)
+    {
+        Archetype* archetype = m_archetypes[m_archetype_lookup.at_index(index)];
+        if (archetype->m_mask == mask)
+        {
+            return archetype;
+        }
+
+        // Hash collision. Extremely rare, so a linear search is good enough.
+        for (size_t archetype_index = 0; archetype_index < m_archetypes.size(); ++archetype_index)
+        {
+            if (m_archetypes[archetype_index]->m_mask == mask)
+            {
+                return m_archetypes[archetype_index];
+            }
+        }
+    }
+
+    Archetype* archetype = hc_new Archetype(mask);
+    if (index == m_archetype_lookup.EndOfTable)
+    {
+        m_archetype_lookup.insert(hash, (uint32_t)m_archetypes.size());
+    }
+    m_archetypes.add(archetype);
+    return archetype;
+}
+
+void World::allocate_row(Archetype* archetype, Entity entity, EntityRecord& record)
+{
+    if (archetype->m_chunks.is_empty() || archetype->m_chunks.back()->count == archetype->m_chunk_capacity)
+    {
+        Chunk* chunk = m_chunk_pool.allocate();
+        chunk->archetype = archetype;
+        chunk->count = 0;
+        archetype->m_chunks.add(chunk);
+    }
+
+    Chunk* chunk = archetype->m_chunks.back();
+    const uint32_t row = chunk->count++;
+    archetype->get_entities(chunk)[row] = entity;
+    ++archetype->m_entities_count;
+
+    record.archetype = archetype;
+    record.chunk = chunk;
+    record.row = row;
+}
+
+void World::remove_row(Archetype* archetype, Chunk* chunk, uint32_t row)
+{
+    Chunk* last_chunk = archetype->m_chunks.back();
+    const uint32_t last_row = last_chunk->count - 1;
+
+    if (chunk != last_chunk || row != last_row)
+    {
+        // Moving the last entity of the archetype into the hole, so the chunks stay densely packed.
+        const Entity moved_entity = archetype->get_entities(last_chunk)[last_row];
+        archetype->get_entities(chunk)[row] = moved_entity;
+
+        for (size_t column = 0; column < archetype->m_component_ids.size(); ++column)
+        {
+            const uint32_t size = archetype->m_component_sizes[column];
+            const uint32_t offset = archetype->m_component_offsets[column];
+            Memory::copy((uint8_t*)chunk + offset + row * size, (uint8_t*)last_chunk + offset + last_row * size, size);
+        }
+
+        EntityRecord& moved_record = m_records[moved_entity.index];
+        moved_record.chunk = chunk;
+        moved_record.row = row;
+    }
+
+    --last_chunk->count;
+    --archetype->m_entities_count;
+
+    if (last_chunk->count == 0)
+    {
+        archetype->m_chunks.pop();
+        m_chunk_pool.release(last_chunk);
+    }
+}
+
+void World::move_entity(Entity entity, Archetype* destination)
+{
+    EntityRecord& record = m_records[entity.index];
+    Archetype* source = record.archetype;
+    Chunk* source_chunk = record.chunk;
+    const uint32_t source_row = record.row;
+
+    EntityRecord destination_record;
+    allocate_row(destination, entity, destination_record);
+
+    for (size_t column = 0; column < destination->m_component_ids.size(); ++column)
+    {
+        const ComponentTypeID id = destination->m_component_ids[column];
+        const uint32_t size = destination->m_component_sizes[column];
+        uint8_t* destination_component = (uint8_t*)destination_record.chunk + destination->m_component_offsets[column] + destination_record.row * size;
+
+        const void* source_component = source->get_component(source_chunk, source_row, id);
+        if (source_component)
+        {
+            Memory::copy(destination_component, source_component, size);
+        }
+        else
+        {
+            Memory::zero(destination_component, size);
+        }
+    }
+
+    remove_row(source, source_chunk, source_row);
+
+    record.archetype = destination_record.archetype;
+    record.chunk = destination_record.chunk;
+    record.row = destination_record.row;
+}
+
+/**
+ *----------------------------------------------------------------
+ * Command Buffer.
+ *----------------------------------------------------------------
+ */
+
+Entity CommandBuffer::create_entity()
+{
+    ScopedLock<Mutex> lock(m_lock);
+
+    const Entity entity = { m_pending_entities_count++, PendingEntityGeneration };
+
+    CommandHeader header = {};
+    header.type = EntityCommandType::CreateEntity;
+    header.entity = entity;
+
+    const size_t offset = m_commands.add_uninitialized(sizeof(CommandHeader));
+    Memory::copy(m_commands.data() + offset, &header, sizeof(CommandHeader));
+    return entity;
+}
+
+void CommandBuffer::destroy_entity(Entity entity)
+{
+    CommandHeader header = {};
+    header.type = EntityCommandType::DestroyEntity;
+    header.entity = entity;
+    record(header, nullptr);
+}
+
+void CommandBuffer::add_component_raw(Entity entity, ComponentTypeID id, const void* component, size_t component_size)
+{
+    CommandHeader header = {};
+    header.type = EntityCommandType::AddComponent;
+    header.component = id;
+    header.entity = entity;
+    header.payload_size = (uint32_t)component_size;
+    record(header, component);
+}
+
+void CommandBuffer::remove_component_raw(Entity entity, ComponentTypeID id)
+{
+    CommandHeader header = {};
+    header.type = EntityCommandType::RemoveComponent;
+    header.component = id;
+    header.entity = entity;
+    record(header, nullptr);
+}
+
+void CommandBuffer::clear()
+{
+    ScopedLock<Mutex> lock(m_lock);
+    m_commands.clear();
+    m_pending_entities_count = 0;
+}
+
+void CommandBuffer::record(const CommandHeader& header, const void* payload)
+{
+    ScopedLock<Mutex> lock(m_lock);
+
+    const size_t offset = m_commands.add_uninitialized(sizeof(CommandHeader) + header.payload_size);
+    Memory::copy(m_commands.data() + offset, &header, sizeof(CommandHeader));
+    if (header.payload_size > 0)
+    {
+        Memory::copy(m_commands.data() + offset + sizeof(CommandHeader), payload, header.payload_size);
+    }
+}
+
+/**
+ *----------------------------------------------------------------
+ * Query.
+ *----------------------------------------------------------------
+ */
+
+void Query::update_cache()
+{
+    const Array<Archetype*>& archetypes = m_world->get_archetypes();
+    for (; m_checked_archetypes_count < archetypes.size(); ++m_checked_archetypes_count)
+    {
+        Archetype* archetype = archetypes[m_checked_archetypes_count];
+        if (archetype->get_mask().contains_all(m_required) && !archetype->get_mask().contains_any(m_excluded))
+        {
+            m_matching_archetypes.add(archetype);
+        }
+    }
+}
+
+uint32_t Query::count_entities()
+{
+    update_cache();
+
+    uint32_t count = 0;
+    for (size_t index = 0; index < m_matching_archetypes.size(); ++index)
+    {
+        count += m_matching_archetypes[index]->get_entities_count();
+    }
+    return count;
+}
+
+} // namespace HC
@@ -0,0 +1,122 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/Core.h"
+#include "Entity.h"
+#include "Archetype.h"
+#include "CommandBuffer.h"
+
+namespace HC
+{
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup World.
+ *----------------------------------------------------------------
+ * Stores entities and their components, grouped by archetype.
+ * Structural changes move the entity to another archetype, so they must not happen while
+ *   the world is being iterated - record them in a 'CommandBuffer' instead.
+ */
+class World
+{
+public:
+    HC_NON_COPIABLE(World)
+    HC_NON_MOVABLE(World)
+
+public:
+    HC_API World();
+    HC_API ~World();
+
+public:
+    HC_API Entity create_entity();
+    HC_API void destroy_entity(Entity entity);
+
+    HC_API bool is_alive(Entity entity) const;
+
+    ALWAYS_INLINE uint32_t get_entities_count() const { return m_entities_count; }
+
+public:
+    /** Adds the component to the entity, or overwrites it if the entity already has it. */
+    template<typename T>
+    ALWAYS_INLINE T& add_component(Entity entity, const T& component = {})
+    {
+        return *(T*)add_component_raw(entity, get_component_type_id<T>(), &component);
+    }
+
+    template<typename T>
+    ALWAYS_INLINE void remove_component(Entity entity)
+    {
+        remove_component_raw(entity, get_component_type_id<T>());
+    }
+
+    /** @return The component of the entity, or nullptr if the entity doesn't have it. */
+    template<typename T>
+    ALWAYS_INLINE T* get_component(Entity entity)
+    {
+        return (T*)get_component_raw(entity, get_component_type_id<T>());
+    }
+
+    template<typename T>
+    ALWAYS_INLINE bool has_component(Entity entity)
+    {
+        return get_component_raw(entity, get_component_type_id<T>()) != nullptr;
+    }
+
+    /**
+     * @param component The initial value of the component. If nullptr, the component is zero-initialized.
+     *
+     * @return The component memory. Invalidated by the next structural change.
+     */
+    HC_API void* add_component_raw(Entity entity, ComponentTypeID id, const void* component);
+    HC_API void remove_component_raw(Entity entity, ComponentTypeID id);
+    HC_API void* get_component_raw(Entity entity, ComponentTypeID id);
+
+public:
+    /** Applies the recorded structural changes, and clears the command buffer. This is a sync point. */
+    HC_API void apply(CommandBuffer& command_buffer);
+
+    ALWAYS_INLINE const Array<Archetype*>& get_archetypes() const { return m_archetypes; }
+
+    /** Iterations are tracked, so structural changes made while iterating can be detected. */
+    ALWAYS_INLINE void begin_iteration() { ++m_iterations_count; }
+    ALWAYS_INLINE void end_iteration() { --m_iterations_count; }
+
+private:
+    struct EntityRecord
+    {
+        Archetype* archetype;
+        Chunk* chunk;
+        uint32_t row;
+        uint32_t generation;
+    };
+
+    Archetype* get_or_create_archetype(const ComponentMask& mask);
+
+    // Appends a row to the archetype, for the given entity.
+    void allocate_row(Archetype* archetype, Entity entity, EntityRecord& record);
+
+    // Removes a row, filling the hole with the last entity of the archetype.
+    void remove_row(Archetype* archetype, Chunk* chunk, uint32_t row);
+
+    // Moves the entity to another archetype, copying the components both archetypes have.
+    void move_entity(Entity entity, Archetype* destination);
+
+private:
+    Array<EntityRecord> m_records;
+    Array<uint32_t> m_free_indices;
+    uint32_t m_entities_count;
+
+    Array<Archetype*> m_archetypes;
+
+    // Maps the archetype mask hashes to indices into the archetypes array.
+    HashTable<uint64_t, uint32_t> m_archetype_lookup;
+
+    Archetype* m_empty_archetype;
+
+    ChunkPool m_chunk_pool;
+
+    uint32_t m_iterations_count;
+};
+
+} // namespace HC
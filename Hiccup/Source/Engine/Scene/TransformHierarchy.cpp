@@ -0,0 +1,326 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "TransformHierarchy.h"
+
+namespace HC
+{
+
+TransformHierarchy::TransformHierarchy()
+    : m_is_layout_dirty(false)
+    , m_has_dirty_nodes(false)
+{}
+
+TransformHierarchy::~TransformHierarchy()
+{}
+
+TransformID TransformHierarchy::create_node(TransformID parent, const LocalTransform& local_transform)
+{
+    HC_ASSERT(parent == InvalidTransform || is_valid(parent)); // Invalid parent node!
+
+    TransformID node;
+    if (!m_free_ids.is_empty())
+    {
+        node = m_free_ids.back();
+        m_free_ids.pop();
+    }
+    else
+    {
+        node = (TransformID)m_nodes.add_uninitialized();
+    }
+
+    NodeLinks& links = m_nodes[node];
+    links.parent = InvalidTransform;
+    links.first_child = InvalidTransform;
+    links.next_sibling = InvalidTransform;
+    links.previous_sibling = InvalidTransform;
+    links.dense_index = (uint32_t)m_dense_ids.size();
+
+    // New nodes are appended, so the layout must be rebuilt before the next update.
+    m_dense_ids.add(node);
+    m_dense_parents.add(InvalidTransform);
+    m_local_transforms.add(local_transform);
+    m_world_matrices.add(Matrix4::identity());
+    m_dirty_flags.add(1);
+
+    link_to_parent(node, parent);
+
+    m_is_layout_dirty = true;
+    m_has_dirty_nodes = true;
+    return node;
+}
+
+void TransformHierarchy::destroy_node(TransformID node)
+{
+    HC_ASSERT(is_valid(node)); // Invalid node!
+
+    while (m_nodes[node].first_child != InvalidTransform)
+    {
+        destroy_node(m_nodes[node].first_child);
+    }
+
+    unlink_from_parent(node);
+
+    // Swap-removing the node from the dense arrays. The order is restored by the layout rebuild.
+    const uint32_t dense_index = m_nodes[node].dense_index;
+    const uint32_t last_index = (uint32_t)m_dense_ids.size() - 1;
+    if (dense_index != last_index)
+    {
+        const TransformID moved_node = m_dense_ids[last_index];
+        m_dense_ids[dense_index] = moved_node;
+        m_dense_parents[dense_index] = m_dense_parents[last_index];
+        m_local_transforms[dense_index] = m_local_transforms[last_index];
+        m_world_matrices[dense_index] = m_world_matrices[last_index];
+        m_dirty_flags[dense_index] = m_dirty_flags[last_index];
+        m_nodes[moved_node].dense_index = dense_index;
+    }
+
+    m_dense_ids.pop();
+    m_dense_parents.pop();
+    m_local_transforms.pop();
+    m_world_matrices.pop();
+    m_dirty_flags.pop();
+
+    m_nodes[node].dense_index = InvalidTransform;
+    m_free_ids.add(node);
+
+    m_is_layout_dirty = true;
+}
+
+void TransformHierarchy::set_parent(TransformID node, TransformID parent)
+{
+    HC_ASSERT(is_valid(node)); // Invalid node!
+    HC_ASSERT(parent == InvalidTransform || is_valid(parent)); // Invalid parent node!
+
+    if (m_nodes[node].parent == parent)
+    {
+        return;
+    }
+
+#if HC_ENABLE_ASSERTS
+    for (TransformID ancestor = parent; ancestor != InvalidTransform; ancestor = m_nodes[ancestor].parent)
+    {
+        HC_ASSERT(ancestor != node); // A node can't be parented to one of its descendants!
+    }
+#endif // HC_ENABLE_ASSERTS
+
+    unlink_from_parent(node);
+    link_to_parent(node, parent);
+
+    mark_dirty(node);
+    m_is_layout_dirty = true;
+}
+
+bool TransformHierarchy::is_valid(TransformID node) const
+{
+    return node < m_nodes.size() && m_nodes[node].dense_index != InvalidTransform;
+}
+
+void TransformHierarchy::set_local_transform(TransformID node, const LocalTransform& local_transform)
+{
+    HC_DASSERT(is_valid(node));
+    m_local_transforms[m_nodes[node].dense_index] = local_transform;
+    mark_dirty(node);
+}
+
+void TransformHierarchy::set_local_translation(TransformID node, const Vector3& translation)
+{
+    HC_DASSERT(is_valid(node));
+    m_local_transforms[m_nodes[node].dense_index].translation = translation;
+    mark_dirty(node);
+}
+
+void TransformHierarchy::set_local_rotation(TransformID node, const Vector3& rotation)
+{
+    HC_DASSERT(is_valid(node));
+    m_local_transforms[m_nodes[node].dense_index].rotation = rotation;
+    mark_dirty(node);
+}
+
+void TransformHierarchy::set_local_scale(TransformID node, const Vector3& scale)
+{
+    HC_DASSERT(is_valid(node));
+    m_local_transforms[m_nodes[node].dense_index].scale = scale;
+    mark_dirty(node);
+}
+
+void TransformHierarchy::update()
+{
+    HC_PROFILE_FUNCTION();
+
+    if (m_is_layout_dirty)
+    {
+        rebuild_layout();
+    }
+
+    if (!m_has_dirty_nodes)
+    {
+        return;
+    }
+
+    // The levels are processed in order, as each level reads the world matrices of the previous one.
+    for (size_t level = 0; level + 1 < m_level_offsets.size(); ++level)
+    {
+        const uint32_t begin_index = m_level_offsets[level];
+        const uint32_t end_index = m_level_offsets[level + 1];
+
+        if (end_index - begin_index >= ParallelUpdateThreshold)
+        {
+            JobSystem::parallel_for(end_index - begin_index, UpdateBatchSize, [this, begin_index](size_t begin, size_t end)
+            {
+                update_range(begin_index + (uint32_t)begin, begin_index + (uint32_t)end);
+            });
+        }
+        else
+        {
+            update_range(begin_index, end_index);
+        }
+    }
+
+    Memory::zero(m_dirty_flags.data(), m_dirty_flags.size());
+    m_has_dirty_nodes = false;
+}
+
+void TransformHierarchy::link_to_parent(TransformID node, TransformID parent)
+{
+    NodeLinks& links = m_nodes[node];
+    links.parent = parent;
+    links.previous_sibling = InvalidTransform;
+    links.next_sibling = InvalidTransform;
+
+    if (parent != InvalidTransform)
+    {
+        NodeLinks& parent_links = m_nodes[parent];
+        links.next_sibling = parent_links.first_child;
+        if (parent_links.first_child != InvalidTransform)
+        {
+            m_nodes[parent_links.first_child].previous_sibling = node;
+        }
+        parent_links.first_child = node;
+    }
+}
+
+void TransformHierarchy::unlink_from_parent(TransformID node)
+{
+    NodeLinks& links = m_nodes[node];
+
+    if (links.previous_sibling != InvalidTransform)
+    {
+        m_nodes[links.previous_sibling].next_sibling = links.next_sibling;
+    }
+    else if (links.parent != InvalidTransform)
+    {
+        m_nodes[links.parent].first_child = links.next_sibling;
+    }
+
+    if (links.next_sibling != InvalidTransform)
+    {
+        m_nodes[links.next_sibling].previous_sibling = links.previous_sibling;
+    }
+
+    links.parent = InvalidTransform;
+    links.previous_sibling = InvalidTransform;
+    links.next_sibling = InvalidTransform;
+}
+
+void TransformHierarchy::mark_dirty(TransformID node)
+{
+    m_dirty_flags[m_nodes[node].dense_index] = 1;
+    m_has_dirty_nodes = true;
+}
+
+void TransformHierarchy::rebuild_layout()
+{
+    HC_PROFILE_FUNCTION();
+
+    const size_t nodes_count = m_dense_ids.size();
+
+    // Breadth-first traversal, starting from the roots. Produces the nodes sorted by depth.
+    Array<TransformID> sorted_ids;
+    sorted_ids.set_capacity(nodes_count);
+    for (size_t index = 0; index < nodes_count; ++index)
+    {
+        if (m_nodes[m_dense_ids[index]].parent == InvalidTransform)
+        {
+            sorted_ids.add(m_dense_ids[index]);
+        }
+    }
+
+    m_level_offsets.clear();
+    size_t level_begin = 0;
+    while (level_begin < sorted_ids.size())
+    {
+        const size_t level_end = sorted_ids.size();
+        m_level_offsets.add((uint32_t)level_begin);
+
+        for (size_t index = level_begin; index < level_end; ++index)
+        {
+            const TransformID node = sorted_ids[index];
+            for (TransformID child = m_nodes[node].first_child; child != InvalidTransform; child = m_nodes[child].next_sibling)
+            {
+                sorted_ids.add(child);
+            }
+        }
+
+        level_begin = level_end;
+    }
+    m_level_offsets.add((uint32_t)sorted_ids.size());
+
+    HC_ASSERT(sorted_ids.size() == nodes_count); // The hierarchy is corrupted!
+
+    // Permuting the dense arrays in the sorted order.
+    Array<uint32_t> sorted_parents;
+    Array<LocalTransform> sorted_local_transforms;
+    Array<Matrix4> sorted_world_matrices;
+    Array<uint8_t> sorted_dirty_flags;
+    sorted_parents.set_size_uninitialized(nodes_count);
+    sorted_local_transforms.set_size_uninitialized(nodes_count);
+    sorted_world_matrices.set_size_uninitialized(nodes_count);
+    sorted_dirty_flags.set_size_uninitialized(nodes_count);
+
+    for (size_t index = 0; index < nodes_count; ++index)
+    {
+        NodeLinks& links = m_nodes[sorted_ids[index]];
+        const uint32_t old_index = links.dense_index;
+
+        // The parents precede their children, so their dense index is already updated.
+        sorted_parents[index] = (links.parent != InvalidTransform) ? m_nodes[links.parent].dense_index : InvalidTransform;
+        sorted_local_transforms[index] = m_local_transforms[old_index];
+        sorted_world_matrices[index] = m_world_matrices[old_index];
+        sorted_dirty_flags[index] = m_dirty_flags[old_index];
+
+        links.dense_index = (uint32_t)index;
+    }
+
+    m_dense_ids = Types::move(sorted_ids);
+    m_dense_parents = Types::move(sorted_parents);
+    m_local_transforms = Types::move(sorted_local_transforms);
+    m_world_matrices = Types::move(sorted_world_matrices);
+    m_dirty_flags = Types::move(sorted_dirty_flags);
+
+    m_is_layout_dirty = false;
+}
+
+void TransformHierarchy::update_range(uint32_t begin_index, uint32_t end_index)
+{
+    for (uint32_t index = begin_index; index < end_index; ++index)
+    {
+        const uint32_t parent = m_dense_parents[index];
+
+        // A node whose parent changed this frame must be recomputed as well.
+        if (parent != InvalidTransform && m_dirty_flags[parent])
+        {
+            m_dirty_flags[index] = 1;
+        }
+
+        if (!m_dirty_flags[index])
+        {
+            continue;
+        }
+
+        const LocalTransform& local = m_local_transforms[index];
+        const Matrix4 local_matrix = Matrix4::transform(local.translation, local.rotation, local.scale);
+        m_world_matrices[index] = (parent != InvalidTransform) ? local_matrix * m_world_matrices[parent] : local_matrix;
+    }
+}
+
+} // namespace HC
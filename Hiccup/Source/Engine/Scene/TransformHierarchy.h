@@ -0,0 +1,155 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/Core.h"
+
+namespace HC
+{
+
+using TransformID = uint32_t;
+
+static constexpr TransformID InvalidTransform = 0xFFFFFFFF;
+
+/**
+ * The local transform of a node, relative to its parent.
+ */
+struct LocalTransform
+{
+    Vector3 translation = Vector3(0.0F);
+
+    // Euler angles, in radians.
+    Vector3 rotation = Vector3(0.0F);
+
+    Vector3 scale = Vector3(1.0F);
+};
+
+/**
+ *----------------------------------------------------------------
+ * Hiccup Transform Hierarchy.
+ *----------------------------------------------------------------
+ * A scene graph of transforms, that computes the world matrices of its nodes.
+ *
+ * The nodes are identified by stable ids, but the per-frame data is stored in flat arrays,
+ *   sorted by depth (breadth-first), so a parent is always updated before its children.
+ *   Propagating the transforms is a linear walk over these arrays, without pointer chasing.
+ * Only the dirty nodes (and their descendants) recompute their world matrices. The nodes of
+ *   the same depth level are independent, so each level is updated in parallel.
+ *
+ * Structural changes (creating, destroying and re-parenting nodes) are cheap, but they
+ *   invalidate the sorted layout, which is rebuilt by the next 'update'.
+ * The hierarchy is not thread-safe. Only 'update' uses the job system internally.
+ */
+class TransformHierarchy
+{
+public:
+    HC_NON_COPIABLE(TransformHierarchy)
+    HC_NON_MOVABLE(TransformHierarchy)
+
+    // The minimum number of nodes a depth level must have in order to be updated in parallel.
+    static constexpr uint32_t ParallelUpdateThreshold = 4096;
+
+    // The number of nodes a job updates.
+    static constexpr uint32_t UpdateBatchSize = 1024;
+
+public:
+    HC_API TransformHierarchy();
+    HC_API ~TransformHierarchy();
+
+public:
+    /**
+     * Creates a node.
+     *
+     * @param parent The parent of the node, or 'InvalidTransform' for a root node.
+     * @param local_transform The transform of the node, relative to its parent.
+     *
+     * @return The id of the new node.
+     */
+    HC_API TransformID create_node(TransformID parent = InvalidTransform, const LocalTransform& local_transform = {});
+
+    /** Destroys the node and all its descendants. */
+    HC_API void destroy_node(TransformID node);
+
+    /**
+     * Changes the parent of a node. The local transform is kept, so the world transform changes.
+     *
+     * @param node The node to re-parent.
+     * @param parent The new parent, or 'InvalidTransform' to make the node a root.
+     */
+    HC_API void set_parent(TransformID node, TransformID parent);
+
+    HC_API bool is_valid(TransformID node) const;
+
+    ALWAYS_INLINE TransformID get_parent(TransformID node) const { return m_nodes[node].parent; }
+
+    ALWAYS_INLINE uint32_t get_nodes_count() const { return (uint32_t)m_dense_ids.size(); }
+
+public:
+    ALWAYS_INLINE const LocalTransform& get_local_transform(TransformID node) const
+    {
+        return m_local_transforms[m_nodes[node].dense_index];
+    }
+
+    /** Marks the node as dirty. The world matrices are recomputed by the next 'update'. */
+    HC_API void set_local_transform(TransformID node, const LocalTransform& local_transform);
+
+    HC_API void set_local_translation(TransformID node, const Vector3& translation);
+    HC_API void set_local_rotation(TransformID node, const Vector3& rotation);
+    HC_API void set_local_scale(TransformID node, const Vector3& scale);
+
+    /** @return The world matrix of the node, as computed by the last 'update'. */
+    ALWAYS_INLINE const Matrix4& get_world_matrix(TransformID node) const
+    {
+        return m_world_matrices[m_nodes[node].dense_index];
+    }
+
+public:
+    /** Rebuilds the layout if needed, and recomputes the world matrices of the dirty subtrees. */
+    HC_API void update();
+
+private:
+    struct NodeLinks
+    {
+        TransformID parent;
+        TransformID first_child;
+        TransformID next_sibling;
+        TransformID previous_sibling;
+
+        // The index of the node in the dense arrays, or 'InvalidTransform' if the node slot is free.
+        uint32_t dense_index;
+    };
+
+    void link_to_parent(TransformID node, TransformID parent);
+    void unlink_from_parent(TransformID node);
+
+    void mark_dirty(TransformID node);
+
+    // Sorts the dense arrays by depth, and computes the depth levels.
+    void rebuild_layout();
+
+    // Recomputes the world matrices of the dirty nodes in the given dense range, of a single depth level.
+    void update_range(uint32_t begin_index, uint32_t end_index);
+
+private:
+    // The hierarchy links, indexed by node id. Only accessed by the structural changes.
+    Array<NodeLinks> m_nodes;
+    Array<TransformID> m_free_ids;
+
+    // The dense arrays, indexed by the dense index. Sorted by depth after 'rebuild_layout'.
+    Array<TransformID> m_dense_ids;
+    Array<uint32_t> m_dense_parents;
+    Array<LocalTransform> m_local_transforms;
+    Array<Matrix4> m_world_matrices;
+
+    // Set for the nodes whose world matrix must be recomputed. Also set during the update for
+    //   the nodes whose world matrix changed, so their children recompute theirs as well.
+    Array<uint8_t> m_dirty_flags;
+
+    // The dense index where each depth level begins. The last element is the nodes count.
+    Array<uint32_t> m_level_offsets;
+
+    bool m_is_layout_dirty;
+    bool m_has_dirty_nodes;
+};
+
+} // namespace HC
@@ -77,4 +77,16 @@ project "Hiccup-Editor"
             "HC_CONFIGURATION_SHIPPING=1"
         }
 
+    filter "configurations:Checked"
+        optimize "Speed"
+        symbols "On"
+
+        kind "WindowedApp"
+
+        defines
+        {
+            "HC_CONFIGURATION_SHIPPING=1",
+            "HC_CONFIGURATION_CHECKED=1"
+        }
+
     filter ""
\ No newline at end of file
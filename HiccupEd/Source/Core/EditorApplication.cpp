@@ -3,11 +3,20 @@
 #include "Core/Core.h"
 #include "Core/Entry.h"
 
+#include "EditorCook.h"
+
 namespace HC
 {
 
 bool create_application_desc(ApplicationDescription* out_application_desc)
 {
+    // The editor runs as a headless tool when a command is given on the command line.
+    if (CommandLine::has_option("cook"sv))
+    {
+        out_application_desc->run_command = cook_content;
+        return true;
+    }
+
     out_application_desc->window_description.width = 1280;
     out_application_desc->window_description.height = 720;
     out_application_desc->window_description.position_x = 300;
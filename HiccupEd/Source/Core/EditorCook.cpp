@@ -0,0 +1,55 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#include "EditorCook.h"
+
+#include "Core/Core.h"
+
+namespace HC
+{
+
+int32_t cook_content()
+{
+    StringView content_directory;
+    if (!CommandLine::get_option("cook"sv, content_directory))
+    {
+        HC_LOG_ERROR("Cook - No content directory specified! Usage: -cook=<content directory> [-output=<pack filepath>] [-alignment=<bytes>]");
+        return EXIT_FAILURE;
+    }
+
+    // The pack file that is written when no output is specified.
+    StringView pack_filepath = "Content.pack"sv;
+    CommandLine::get_option("output"sv, pack_filepath);
+
+    uint32_t alignment = PackFile::DefaultAlignment;
+    StringView alignment_option;
+    if (CommandLine::get_option("alignment"sv, alignment_option))
+    {
+        const ConfigBinding binding = ConfigBinding::bind("Cook", "alignment", &alignment);
+        if (!Config::apply_value(binding, alignment_option) || alignment == 0 || (alignment & (alignment - 1)) != 0)
+        {
+            HC_LOG_ERROR("Cook - The alignment must be a power of two!");
+            return EXIT_FAILURE;
+        }
+    }
+
+    PackBuilder builder(alignment);
+
+    ErrorCode error = builder.add_directory(content_directory, StringView());
+    if (error != ErrorCode::Success)
+    {
+        HC_LOG_ERROR("Cook - Failed to collect the content files!");
+        return EXIT_FAILURE;
+    }
+
+    error = builder.build(pack_filepath);
+    if (error != ErrorCode::Success)
+    {
+        HC_LOG_ERROR("Cook - Failed to write the pack file!");
+        return EXIT_FAILURE;
+    }
+
+    HC_LOG_INFO("Cook - Packed %u files into '%.*s'.", (uint32_t)builder.get_entries_count(), (int)pack_filepath.bytes_count(), pack_filepath.c_str());
+    return EXIT_SUCCESS;
+}
+
+} // namespace HC
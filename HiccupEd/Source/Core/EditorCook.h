@@ -0,0 +1,19 @@
+// Copyright (c) 2022-2023 Avram Traian. All rights reserved.
+
+#pragma once
+
+#include "Core/CoreMinimal.h"
+
+namespace HC
+{
+
+/**
+ * Packs the content of a directory into a pack file, readable by 'PackFile'.
+ * Invoked instead of the editor when the command line contains '-cook':
+ *   Hiccup-Editor -cook=<content directory> [-output=<pack filepath>] [-alignment=<bytes>]
+ *
+ * @return The process exit code.
+ */
+int32_t cook_content();
+
+} // namespace HC
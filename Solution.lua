@@ -3,7 +3,7 @@
 workspace "Hiccup"
     configurations
     {
-        "Debug", "Release", "Shipping"
+        "Debug", "Release", "Shipping", "Checked"
     }
 
     platforms